@@ -25,19 +25,34 @@ if not exist "%PIO_EXE%" (
 
 pushd "%PROJECT_DIR%" >nul
 
-echo [1/2] Building firmware.bin (env: %ENV_NAME%)...
+echo [1/3] Building firmware.bin (env: %ENV_NAME%)...
 call "%PIO_EXE%" run -e "%ENV_NAME%"
 if errorlevel 1 goto :fail
 
-echo [2/2] Building littlefs.bin (env: %ENV_NAME%)...
+echo [2/3] Building littlefs.bin (env: %ENV_NAME%)...
 call "%PIO_EXE%" run -e "%ENV_NAME%" -t buildfs
 if errorlevel 1 goto :fail
 
 set "OUT_DIR=.pio\build\%ENV_NAME%"
+
+rem The device inflates .gz uploads on the fly, so uploading these cuts the transfer size.
+echo [3/3] Compressing OTA images (gzip)...
+powershell -NoProfile -ExecutionPolicy Bypass -Command ^
+  "$ErrorActionPreference = 'Stop';" ^
+  "foreach ($name in 'firmware.bin', 'littlefs.bin') {" ^
+  "  $src = Join-Path '%OUT_DIR%' $name; $dst = $src + '.gz';" ^
+  "  $in = [IO.File]::OpenRead($src); $out = [IO.File]::Create($dst);" ^
+  "  $gz = New-Object IO.Compression.GZipStream($out, [IO.Compression.CompressionLevel]::Optimal);" ^
+  "  $in.CopyTo($gz); $gz.Dispose(); $out.Dispose(); $in.Dispose();" ^
+  "  $a = (Get-Item $src).Length; $b = (Get-Item $dst).Length;" ^
+  "  '{0,-13} {1,8:N0} KB -> {2,8:N0} KB  (transfer -{3:N0}%%)' -f $name, ($a / 1KB), ($b / 1KB), (100 - 100 * $b / $a)" ^
+  "}"
+if errorlevel 1 goto :fail
+
 echo.
 echo Build complete.
-echo firmware : "%CD%\%OUT_DIR%\firmware.bin"
-echo littlefs : "%CD%\%OUT_DIR%\littlefs.bin"
+echo firmware : "%CD%\%OUT_DIR%\firmware.bin"  (gzip: firmware.bin.gz)
+echo littlefs : "%CD%\%OUT_DIR%\littlefs.bin"  (gzip: littlefs.bin.gz)
 popd >nul
 exit /b 0
 
@@ -36,6 +36,7 @@ window.onload = async () => {
     }
     renderUI();
     initLogWS();
+    openStateWS();
     renderFirmwareProgress(0);
     refreshFirmwareInfo();
 };
@@ -47,10 +48,14 @@ function initLogWS() {
     const logContainer = document.getElementById("logContainer");
 
     ws.onmessage = (event) => {
-        const line = document.createElement("div");
-        line.className = "log-line";
-        line.innerText = `[${new Date().toLocaleTimeString()}] ${event.data}`;
-        logContainer.appendChild(line);
+        // 장치는 여러 줄을 '\n'으로 묶어 한 메시지로 보낸다
+        const stamp = new Date().toLocaleTimeString();
+        for (const text of String(event.data).split("\n")) {
+            const line = document.createElement("div");
+            line.className = "log-line";
+            line.innerText = `[${stamp}] ${text}`;
+            logContainer.appendChild(line);
+        }
         logContainer.scrollTop = logContainer.scrollHeight;
 
         while (logContainer.childNodes.length > 100) {
@@ -63,6 +68,211 @@ function initLogWS() {
     };
 }
 
+// /ws/frames 바이너리 프레임 (FrameStream.h 참고)
+const FRAME_KEY = 1;
+const FRAME_DELTA = 2;
+const PREVIEW_INNER_LEDS = 16;
+let previewWs = null;
+let previewPixels = [];
+let previewSeg = [0xFF, 0xFF, 0xFF];
+
+function togglePreview() {
+    const btn = document.getElementById("previewBtn");
+    const canvas = document.getElementById("previewCanvas");
+    if (previewWs) {
+        previewWs.onclose = null;
+        previewWs.close();
+        previewWs = null;
+        btn.innerText = "시작";
+        canvas.style.display = "none";
+        return;
+    }
+    btn.innerText = "중지";
+    canvas.style.display = "block";
+    openPreviewWS();
+}
+
+function openPreviewWS() {
+    const protocol = window.location.protocol === "https:" ? "wss:" : "ws:";
+    previewWs = new WebSocket(`${protocol}//${window.location.host}/ws/frames`);
+    previewWs.binaryType = "arraybuffer";
+    previewWs.onmessage = (event) => {
+        if (!(event.data instanceof ArrayBuffer)) return;
+        applyPreviewFrame(new Uint8Array(event.data));
+        drawPreview();
+    };
+    previewWs.onclose = () => {
+        setTimeout(() => {
+            if (previewWs) openPreviewWS();
+        }, 2000);
+    };
+}
+
+function applyPreviewFrame(buf) {
+    if (buf.length < 7) return;
+    const type = buf[0];
+    const count = buf[2];
+    previewSeg = [buf[4], buf[5], buf[6]];
+    if (previewPixels.length !== count) previewPixels = new Array(count).fill(0);
+
+    if (type === FRAME_KEY) {
+        for (let i = 0; i < count && 7 + i * 3 + 2 < buf.length; i++) {
+            const o = 7 + i * 3;
+            previewPixels[i] = (buf[o] << 16) | (buf[o + 1] << 8) | buf[o + 2];
+        }
+    } else if (type === FRAME_DELTA && buf.length >= 8) {
+        const changed = buf[7];
+        for (let n = 0; n < changed; n++) {
+            const o = 8 + n * 4;
+            if (o + 3 >= buf.length) break;
+            const idx = buf[o];
+            if (idx < count) previewPixels[idx] = (buf[o + 1] << 16) | (buf[o + 2] << 8) | buf[o + 3];
+        }
+    }
+}
+
+function drawPreview() {
+    const canvas = document.getElementById("previewCanvas");
+    const ctx = canvas.getContext("2d");
+    const cx = canvas.width / 2;
+    const cy = canvas.height / 2;
+    ctx.clearRect(0, 0, canvas.width, canvas.height);
+
+    const inner = Math.min(PREVIEW_INNER_LEDS, previewPixels.length);
+    drawPreviewRing(ctx, cx, cy, 60, previewPixels.slice(0, inner));
+    drawPreviewRing(ctx, cx, cy, 100, previewPixels.slice(inner));
+    drawPreviewSegments(ctx, cx - 33, cy - 14, previewSeg);
+}
+
+function drawPreviewRing(ctx, cx, cy, radius, pixels) {
+    pixels.forEach((c, i) => {
+        const angle = (i / pixels.length) * Math.PI * 2 - Math.PI / 2;
+        ctx.beginPath();
+        ctx.arc(cx + Math.cos(angle) * radius, cy + Math.sin(angle) * radius, 6, 0, Math.PI * 2);
+        ctx.fillStyle = c ? intToHex(c) : "#222";
+        ctx.fill();
+    });
+}
+
+// 공통 애노드: 비트가 0이면 점등. bit0=a ... bit6=g, bit7=dp
+function drawPreviewSegments(ctx, x, y, seg) {
+    const bars = [
+        [2, 0, 14, 3], [16, 2, 3, 12], [16, 16, 3, 12], [2, 28, 14, 3],
+        [-1, 16, 3, 12], [-1, 2, 3, 12], [2, 14, 14, 3]
+    ];
+    seg.forEach((bits, d) => {
+        const ox = x + d * 24;
+        bars.forEach(([bx, by, bw, bh], s) => {
+            ctx.fillStyle = (bits & (1 << s)) ? "#2a0000" : "#ff3030";
+            ctx.fillRect(ox + bx, y + by, bw, bh);
+        });
+        ctx.fillStyle = (bits & 0x80) ? "#2a0000" : "#ff3030";
+        ctx.fillRect(ox + 20, y + 28, 3, 3);
+    });
+}
+
+// /ws/ctrl 원격 제어 (RemoteControl.h 참고)
+let ctrlWs = null;
+let ctrlNextId = 1;
+const ctrlPending = new Map();
+
+function openCtrlWS() {
+    const protocol = window.location.protocol === "https:" ? "wss:" : "ws:";
+    ctrlWs = new WebSocket(`${protocol}//${window.location.host}/ws/ctrl`);
+    ctrlWs.onmessage = (event) => {
+        let ack = {};
+        try {
+            ack = JSON.parse(event.data);
+        } catch (e) {
+            return;
+        }
+        const sentAt = ctrlPending.get(ack.id);
+        ctrlPending.delete(ack.id);
+        if (sentAt === undefined) return;
+        const rtt = performance.now() - sentAt;
+        const deviceMs = toInt(ack.us, 0) / 1000;
+        document.getElementById("ctrlLatency").innerText =
+            ack.ok ? `${rtt.toFixed(1)}ms (장치 ${deviceMs.toFixed(1)}ms)` : `실패: ${ack.reason || "error"}`;
+        if (ack.ok && ack.state && Number.isFinite(ack.state.preset)) {
+            config.curIdx = Math.max(0, Math.min(ack.state.preset, config.presets.length - 1));
+        }
+    };
+    ctrlWs.onclose = () => {
+        ctrlWs = null;
+        ctrlPending.clear();
+    };
+}
+
+function sendRemote(command) {
+    if (!ctrlWs) openCtrlWS();
+    const id = ctrlNextId++;
+    const msg = JSON.stringify({ id, t: Math.round(performance.now()), ...command });
+    const send = () => {
+        ctrlPending.set(id, performance.now());
+        ctrlWs.send(msg);
+    };
+    if (ctrlWs.readyState === WebSocket.OPEN) send();
+    else ctrlWs.addEventListener("open", send, { once: true });
+}
+
+// /ws/state 런타임 상태 (StateStream.h 참고): snap 한 번 뒤 delta만 온다
+const POMO_STATE_NAMES = ["집중", "휴식 대기", "휴식", "집중 대기"];
+let liveState = null;
+let liveStateAt = 0;
+let liveStateTimer = null;
+
+function openStateWS() {
+    const protocol = window.location.protocol === "https:" ? "wss:" : "ws:";
+    const ws = new WebSocket(`${protocol}//${window.location.host}/ws/state`);
+    ws.onmessage = (event) => {
+        let msg = {};
+        try {
+            msg = JSON.parse(event.data);
+        } catch (e) {
+            return;
+        }
+        if (msg.t === "snap") liveState = msg;
+        else if (msg.t === "delta" && liveState) Object.assign(liveState, msg);
+        else return;
+        liveStateAt = performance.now();
+
+        // 버튼으로 바뀐 프리셋을 편집기에도 반영 (저장 시 되돌리지 않게)
+        if (Number.isFinite(msg.preset) && msg.preset !== config.curIdx && msg.preset < config.presets.length) {
+            config.curIdx = msg.preset;
+            renderUI();
+        }
+        renderLiveState();
+    };
+    ws.onclose = () => {
+        liveState = null;
+        setTimeout(openStateWS, 2000);
+    };
+    if (!liveStateTimer) liveStateTimer = setInterval(renderLiveState, 500);
+}
+
+function formatElapsed(part) {
+    if (!part) return "-";
+    // 흐르는 시간은 장치가 매번 보내지 않으므로 마지막 값에서 외삽
+    const ms = toInt(part.elapsedMs, 0) + (part.running ? performance.now() - liveStateAt : 0);
+    const total = Math.floor(ms / 1000);
+    return `${Math.floor(total / 60)}:${String(total % 60).padStart(2, "0")}${part.running ? "" : " (정지)"}`;
+}
+
+function renderLiveState() {
+    const el = document.getElementById("liveState");
+    if (!el || !liveState) return;
+    const s = liveState;
+    const parts = [`프리셋 ${toInt(s.preset, 0) + 1}/${toInt(s.presets, 0)}`];
+    if (s.mode === MODES.COUNTER) parts.push(`카운터 ${s.counter}`);
+    if (s.mode === MODES.TIMER) parts.push(`타이머 ${formatElapsed(s.timer)}`);
+    if (s.mode === MODES.POMODORO) {
+        const name = POMO_STATE_NAMES[toInt(s.pomo && s.pomo.state, 0)] || "-";
+        parts.push(`뽀모도로 ${name} ${formatElapsed(s.pomo)}`);
+    }
+    parts.push(`밝기 ${s.brightness}${s.night ? " (야간)" : ""}`);
+    el.innerText = parts.join(" · ");
+}
+
 function clearLog() {
     document.getElementById("logContainer").innerHTML = "";
 }
@@ -111,66 +321,168 @@ async function refreshFirmwareInfo() {
         const busy = !!data.uploadInProgress ? "busy" : "idle";
         const fsSupport = data.fsUploadSupported === false ? "fs ota off" : "fs ota on";
         const version = data.version ? `, ver ${data.version}` : "";
-        infoEl.innerText = `${model} rev${rev}, free ${freeKb}KB, ${busy}, ${fsSupport}${version}`;
+        const ota = data.ota && data.ota.active
+            ? `, ota ${Math.round(toInt(data.ota.next, 0) / 1024)}/${Math.round(toInt(data.ota.size, 0) / 1024)}KB ${formatOtaRate(data.ota)}`
+            : "";
+        infoEl.innerText = `${model} rev${rev}, free ${freeKb}KB, ${busy}, ${fsSupport}${version}${ota}`;
     } catch (e) {
         infoEl.innerText = "Device info unavailable";
     }
 }
 
+// .bin 또는 gzip 압축된 .bin.gz (장치에서 스트리밍으로 풀어 씀)
 function isBinFile(file) {
-    return !!file && /\.bin$/i.test(file.name || "");
+    return !!file && /\.(bin|gz)$/i.test(file.name || "");
 }
 
-function uploadOtaPart(endpoint, fieldName, file, progressStart, progressEnd) {
-    return new Promise((resolve, reject) => {
-        const formData = new FormData();
-        formData.append(fieldName, file, file.name);
+// 청크 OTA용 CRC32 (장치의 esp_rom_crc32_le(0, ...)와 같은 값)
+const CRC32_TABLE = (() => {
+    const table = new Uint32Array(256);
+    for (let i = 0; i < 256; i++) {
+        let c = i;
+        for (let k = 0; k < 8; k++) c = (c & 1) ? (0xEDB88320 ^ (c >>> 1)) : (c >>> 1);
+        table[i] = c >>> 0;
+    }
+    return table;
+})();
 
-        const xhr = new XMLHttpRequest();
-        xhr.open("POST", endpoint, true);
+function crc32(bytes) {
+    let crc = 0xFFFFFFFF;
+    for (let i = 0; i < bytes.length; i++) crc = CRC32_TABLE[(crc ^ bytes[i]) & 0xFF] ^ (crc >>> 8);
+    return (crc ^ 0xFFFFFFFF) >>> 0;
+}
 
-        xhr.upload.onprogress = (event) => {
-            if (!event.lengthComputable) return;
-            const ratio = event.total > 0 ? (event.loaded / event.total) : 0;
-            const percent = progressStart + ((progressEnd - progressStart) * ratio);
-            renderFirmwareProgress(percent);
-        };
+const SHA256_K = new Uint32Array([
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+]);
+
+// http://tape.local 은 secure context가 아니라 crypto.subtle을 못 쓰므로 직접 계산한다.
+function sha256Hex(bytes) {
+    const bitLen = bytes.length * 8;
+    const padded = new Uint8Array(((bytes.length + 9 + 63) >> 6) << 6);
+    padded.set(bytes);
+    padded[bytes.length] = 0x80;
+    const view = new DataView(padded.buffer);
+    view.setUint32(padded.length - 8, Math.floor(bitLen / 0x100000000));
+    view.setUint32(padded.length - 4, bitLen >>> 0);
+
+    const h = new Uint32Array([0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19]);
+    const w = new Uint32Array(64);
+    const rotr = (x, n) => (x >>> n) | (x << (32 - n));
+    for (let off = 0; off < padded.length; off += 64) {
+        for (let i = 0; i < 16; i++) w[i] = view.getUint32(off + i * 4);
+        for (let i = 16; i < 64; i++) {
+            const s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >>> 3);
+            const s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >>> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        let [a, b, c, d, e, f, g, hh] = h;
+        for (let i = 0; i < 64; i++) {
+            const t1 = hh + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + SHA256_K[i] + w[i];
+            const t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            hh = g; g = f; f = e; e = (d + t1) >>> 0;
+            d = c; c = b; b = a; a = (t1 + t2) >>> 0;
+        }
+        h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
+    }
+    return Array.from(h, (x) => x.toString(16).padStart(8, "0")).join("");
+}
 
-        xhr.onload = () => {
-            let body = {};
-            try {
-                body = JSON.parse(xhr.responseText || "{}");
-            } catch (e) {
-                body = {};
-            }
+const OTA_MAX_RETRIES = 20;
 
-            if (xhr.status >= 200 && xhr.status < 300 && body.status === "ok") {
-                resolve(body);
-                return;
-            }
+function sleep(ms) {
+    return new Promise((resolve) => setTimeout(resolve, ms));
+}
 
-            const err = new Error(body.reason || `http_${xhr.status}`);
-            err.reason = body.reason || `http_${xhr.status}`;
-            err.detail = body.detail || "";
-            reject(err);
-        };
+async function postOta(url, body) {
+    const res = await fetch(url, { method: "POST", body });
+    let data = {};
+    try {
+        data = await res.json();
+    } catch (e) {
+        data = {};
+    }
+    return { ok: res.ok, status: res.status, data };
+}
 
-        xhr.onerror = () => {
-            const err = new Error("network_error");
-            err.reason = "network_error";
-            err.detail = "connection lost during upload";
-            reject(err);
-        };
+function otaError(reason, detail) {
+    const err = new Error(reason);
+    err.reason = reason;
+    err.detail = detail || "";
+    return err;
+}
 
-        xhr.onabort = () => {
-            const err = new Error("aborted");
-            err.reason = "aborted";
-            err.detail = "upload aborted";
-            reject(err);
-        };
+function formatOtaRate(state) {
+    const kbps = Number(state.kbps) || 0;
+    const eta = toInt(state.etaSec, -1);
+    return eta >= 0 ? `${kbps.toFixed(1)}KB/s, ~${eta}s left` : `${kbps.toFixed(1)}KB/s`;
+}
 
-        xhr.send(formData);
-    });
+// /ota/begin → /ota/chunk(offset, crc) 반복 → /ota/commit
+// 연결이 끊기면 /ota/begin을 다시 불러 장치가 알려주는 next부터 이어서 보낸다.
+async function uploadOtaChunked(target, file, phaseText, progressStart, progressEnd) {
+    const bytes = new Uint8Array(await file.arrayBuffer());
+    setFirmwareStatus(`${phaseText} (hashing)`, "running");
+    const gzip = bytes.length >= 2 && bytes[0] === 0x1F && bytes[1] === 0x8B;
+    const beginUrl = `/ota/begin?target=${target}&size=${bytes.length}&sha256=${sha256Hex(bytes)}&gzip=${gzip ? 1 : 0}`;
+
+    let failures = 0;
+    const retry = async (err) => {
+        failures++;
+        if (failures > OTA_MAX_RETRIES) throw err;
+        setFirmwareStatus(`${phaseText} (connection lost, retry ${failures}/${OTA_MAX_RETRIES})`, "running");
+        await sleep(Math.min(5000, 500 * failures));
+    };
+
+    let next = -1;
+    let chunkMax = 4096;
+    while (next < bytes.length) {
+        try {
+            if (next < 0) {
+                const begin = await postOta(beginUrl);
+                if (!begin.ok) throw otaError(begin.data.reason || `http_${begin.status}`, begin.data.detail);
+                next = toInt(begin.data.next, 0);
+                chunkMax = toInt(begin.data.chunkMax, chunkMax);
+                continue;
+            }
+
+            const chunk = bytes.subarray(next, Math.min(bytes.length, next + chunkMax));
+            const crc = crc32(chunk).toString(16);
+            const res = await postOta(`/ota/chunk?offset=${next}&crc=${crc}`, chunk);
+            if (res.ok || res.data.reason === "offset_mismatch") {
+                next = toInt(res.data.next, next);
+                failures = 0;
+            } else if (res.data.reason === "no_session") {
+                next = -1; // 세션이 만료됨: begin으로 다시 시작
+                await retry(otaError("no_session"));
+            } else if (res.data.reason === "crc_mismatch") {
+                await retry(otaError("crc_mismatch", "chunk corrupted in transit"));
+            } else {
+                throw otaError(res.data.reason || `http_${res.status}`, res.data.detail);
+            }
+
+            const ratio = bytes.length > 0 ? next / bytes.length : 1;
+            renderFirmwareProgress(progressStart + (progressEnd - progressStart) * ratio);
+            setFirmwareStatus(`${phaseText} ${formatOtaRate(res.data)}`, "running");
+        } catch (e) {
+            if (e && e.reason) throw e;
+            next = -1; // 네트워크 오류: 장치 쪽 next를 다시 물어본다
+            await retry(otaError("network_error", "connection lost during upload"));
+        }
+    }
+
+    const commit = await postOta("/ota/commit");
+    if (!commit.ok || commit.data.status !== "ok") {
+        throw otaError(commit.data.reason || `http_${commit.status}`, commit.data.detail);
+    }
+    return commit.data;
 }
 
 async function uploadFirmwareBin() {
@@ -186,7 +498,7 @@ async function uploadFirmwareBin() {
 
     const firmwareFile = fwInput.files[0];
     if (!isBinFile(firmwareFile)) {
-        setFirmwareStatus("Firmware must be a .bin file.", "error");
+        setFirmwareStatus("Firmware must be a .bin or .bin.gz file.", "error");
         return;
     }
 
@@ -194,7 +506,7 @@ async function uploadFirmwareBin() {
     if (fsInput && fsInput.files && fsInput.files.length > 0) {
         filesystemFile = fsInput.files[0];
         if (!isBinFile(filesystemFile)) {
-            setFirmwareStatus("Filesystem image must be a .bin file.", "error");
+            setFirmwareStatus("Filesystem image must be a .bin or .bin.gz file.", "error");
             return;
         }
     }
@@ -204,15 +516,13 @@ async function uploadFirmwareBin() {
 
     try {
         if (filesystemFile) {
-            setFirmwareStatus("1/2 Uploading filesystem...", "running");
-            await uploadOtaPart("/fs-upload", "filesystem", filesystemFile, 0, 50);
+            await uploadOtaChunked("fs", filesystemFile, "1/2 Uploading filesystem...", 0, 50);
             renderFirmwareProgress(50);
         }
 
         const fwStart = filesystemFile ? 50 : 0;
         const fwPhaseText = filesystemFile ? "2/2 Uploading firmware..." : "Uploading firmware...";
-        setFirmwareStatus(fwPhaseText, "running");
-        const fwResult = await uploadOtaPart("/fw-upload", "firmware", firmwareFile, fwStart, 100);
+        const fwResult = await uploadOtaChunked("fw", firmwareFile, fwPhaseText, fwStart, 100);
 
         renderFirmwareProgress(100);
         if (fwResult.rebooting) {
@@ -263,7 +573,11 @@ function makeDefaultConfig() {
         nEn: false,
         nS: 22,
         nE: 7,
-        nB: 10
+        nB: 10,
+        sync: 0,
+        trS: 1,
+        trMs: 400,
+        sch: []
     };
 }
 
@@ -288,12 +602,22 @@ function normalizeConfig(raw) {
         nEn: !!raw.nEn,
         nS: toInt(raw.nS, 22),
         nE: toInt(raw.nE, 7),
-        nB: toInt(raw.nB, 10)
+        nB: toInt(raw.nB, 10),
+        sync: Math.max(0, Math.min(2, toInt(raw.sync, 0))),
+        trS: Math.max(0, Math.min(2, toInt(raw.trS, 1))),
+        trMs: Math.max(0, Math.min(3000, toInt(raw.trMs, 400))),
+        sch: (Array.isArray(raw.sch) ? raw.sch : []).map((r) => ({
+            d: toInt(r?.d, SCHEDULE_DAYS.EVERY) & SCHEDULE_DAYS.EVERY,
+            h: Math.max(0, Math.min(23, toInt(r?.h, 0))),
+            m: Math.max(0, Math.min(59, toInt(r?.m, 0))),
+            p: Math.max(0, toInt(r?.p, 0))
+        }))
     };
 
     if (normalized.presets.length === 0) normalized.presets = [makeDefaultPreset()];
     if (normalized.ddays.length === 0) normalized.ddays = [{ n: "새 일정", s: "2025-01-01", t: "2025-12-31" }];
     if (normalized.curIdx < 0 || normalized.curIdx >= normalized.presets.length) normalized.curIdx = 0;
+    normalized.sch = normalized.sch.filter((r) => r.d !== 0 && r.p < normalized.presets.length);
 
     clampDDayIndices(normalized);
     return normalized;
@@ -429,9 +753,82 @@ function renderUI() {
     document.getElementById("nE").value = config.nE;
     document.getElementById("nB").value = config.nB;
     document.getElementById("nBVal").innerText = config.nB;
+    document.getElementById("syncRole").value = String(config.sync);
+    document.getElementById("trS").value = String(config.trS);
+    document.getElementById("trMs").value = config.trMs;
+    document.getElementById("trMsVal").innerText = config.trMs;
+    renderSchedules();
     toggleNightBox();
 }
 
+// 요일 비트: bit0=일 ~ bit6=토
+const SCHEDULE_DAYS = { EVERY: 0x7f, WEEKDAYS: 0x3e, WEEKEND: 0x41 };
+const SCHEDULE_DAY_NAMES = ["일", "월", "화", "수", "목", "금", "토"];
+
+function renderSchedules() {
+    const list = document.getElementById("scheduleList");
+    list.innerHTML = "";
+    config.sch.forEach((r, i) => {
+        const div = document.createElement("div");
+        div.className = "list-item";
+        div.style.cssText = "display:flex; flex-wrap:wrap; gap:6px; align-items:center;";
+
+        const days = document.createElement("span");
+        SCHEDULE_DAY_NAMES.forEach((name, bit) => {
+            const on = (r.d & (1 << bit)) !== 0;
+            const b = document.createElement("button");
+            b.className = "btn-small";
+            b.textContent = name;
+            b.style.cssText = `width:auto; padding:4px 6px; margin:0 2px; background:${on ? "#00c853" : "#444"};`;
+            b.onclick = () => {
+                const next = r.d ^ (1 << bit);
+                if (next === 0) return; // 최소 하루는 남긴다
+                r.d = next;
+                renderSchedules();
+            };
+            days.appendChild(b);
+        });
+
+        const time = document.createElement("input");
+        time.type = "time";
+        time.style.width = "auto";
+        time.value = `${String(r.h).padStart(2, "0")}:${String(r.m).padStart(2, "0")}`;
+        time.onchange = () => {
+            const [h, m] = time.value.split(":");
+            r.h = Math.max(0, Math.min(23, toInt(h, 0)));
+            r.m = Math.max(0, Math.min(59, toInt(m, 0)));
+        };
+
+        const preset = document.createElement("select");
+        preset.style.width = "auto";
+        config.presets.forEach((_, idx) => {
+            const opt = document.createElement("option");
+            opt.value = String(idx);
+            opt.textContent = `프리셋 ${idx + 1}`;
+            preset.appendChild(opt);
+        });
+        preset.value = String(r.p);
+        preset.onchange = () => { r.p = toInt(preset.value, 0); };
+
+        const del = document.createElement("button");
+        del.className = "btn-small btn-red";
+        del.textContent = "삭제";
+        del.style.width = "auto";
+        del.onclick = () => {
+            config.sch.splice(i, 1);
+            renderSchedules();
+        };
+
+        div.append(days, time, preset, del);
+        list.appendChild(div);
+    });
+}
+
+function addSchedule() {
+    config.sch.push({ d: SCHEDULE_DAYS.WEEKDAYS, h: 9, m: 0, p: config.curIdx });
+    renderSchedules();
+}
+
 function toggleNightBox() {
     document.getElementById("nightBox").style.display = document.getElementById("nEn").checked ? "block" : "none";
 }
@@ -542,18 +939,27 @@ function updateColorModeUI(prefix) {
     const cfBox = document.getElementById(`${prefix}cf_box`);
     const cfLabel = document.getElementById(`${prefix}cf_label`);
     const cf2Box = document.getElementById(`${prefix}cf2_box`);
+    const cf2Label = document.getElementById(`${prefix}cf2_label`);
+    // 4~6: 채움 색 + 효과 색 (숨쉬기는 빈 칸, 혜성은 머리, 반짝임은 불꽃)
+    const effectLabels = { "4": "숨쉬는 색", "5": "혜성 색", "6": "반짝임 색" };
 
-    if (cm === "1") {
+    if (cm === "1" || cm === "7") {
         cfBox.style.display = "none";
         cf2Box.style.display = "none";
     } else if (cm === "0") {
         cfBox.style.display = "flex";
         cfLabel.innerText = "채움 색";
         cf2Box.style.display = "none";
+    } else if (effectLabels[cm]) {
+        cfBox.style.display = "flex";
+        cfLabel.innerText = "채움 색";
+        cf2Box.style.display = "flex";
+        cf2Label.innerText = effectLabels[cm];
     } else {
         cfBox.style.display = "flex";
         cfLabel.innerText = "시작 색";
         cf2Box.style.display = "flex";
+        cf2Label.innerText = "끝 색상";
     }
 }
 
@@ -717,6 +1123,11 @@ function movePreset(dir) {
     const temp = config.presets[config.curIdx];
     config.presets[config.curIdx] = config.presets[newIdx];
     config.presets[newIdx] = temp;
+    // 전환 규칙이 같은 프리셋을 계속 가리키도록
+    config.sch.forEach((r) => {
+        if (r.p === config.curIdx) r.p = newIdx;
+        else if (r.p === newIdx) r.p = config.curIdx;
+    });
     config.curIdx = newIdx;
     renderUI();
 }
@@ -727,7 +1138,10 @@ function delPreset() {
         return;
     }
     if (!confirm("삭제?")) return;
-    config.presets.splice(config.curIdx, 1);
+    const removed = config.curIdx;
+    config.presets.splice(removed, 1);
+    config.sch = config.sch.filter((r) => r.p !== removed);
+    config.sch.forEach((r) => { if (r.p > removed) r.p--; });
     config.curIdx = 0;
     renderUI();
 }
@@ -798,6 +1212,9 @@ async function uploadConfig() {
     config.nS = toInt(document.getElementById("nS").value, 22);
     config.nE = toInt(document.getElementById("nE").value, 7);
     config.nB = toInt(document.getElementById("nB").value, 10);
+    config.sync = toInt(document.getElementById("syncRole").value, 0);
+    config.trS = toInt(document.getElementById("trS").value, 1);
+    config.trMs = toInt(document.getElementById("trMs").value, 400);
 
     try {
         const res = await fetch("/set-config", {
@@ -0,0 +1,66 @@
+#pragma once
+#include <Arduino.h>
+
+class AsyncWebServer;
+
+// 힙 할당 추적 (/alloc).
+//
+// malloc/calloc/realloc/free를 링커에서 감싸(-Wl,--wrap=...) 할당마다 지금 태스크에 걸린
+// 서브시스템 태그로 센다. String/JsonDocument/new 모두 결국 malloc을 타므로 같이 잡힌다.
+// TIME_TAPE_ALLOC_TRACK 빌드에서만 감싸고, 아니면 태그는 아무 일도 하지 않는다.
+//
+// 해제할 때는 블록 크기만 알 수 있어서 해제한 쪽 태그에 잡힌다. 그래서 서브시스템별 net은
+// "그 범위 안에서 늘어난 양"이다. 전역 live/peak도 추정치다: IDF(WiFi/LWIP 등)가 heap_caps_malloc으로
+// 바로 받은 블록은 할당 때는 보이지 않다가 감싼 free로 돌아올 때만 빠지므로, live는 실제보다 낮게
+// 흘러가고 음수가 될 수도 있다. 실제 힙 사용량은 힙 샘플의 free/largest(IDF 집계)로 본다.
+enum AllocSubsystem : uint8_t
+{
+    ALLOC_OTHER = 0, // 태그 밖 (WiFi/TCP 스택 포함)
+    ALLOC_RENDER,    // 프레임 경로: InteractiveManager/TimerEngine::update, DisplayManager::update (할당 금지)
+    ALLOC_LOG,       // 로그 드레인 (포맷, Serial/WebSocket 전송)
+    ALLOC_CONFIG,    // saveConfigToFile
+    ALLOC_HTTP,      // 웹 핸들러 (/set-config 본문, sendJsonError)
+    ALLOC_HISTORY,   // 기록 로그 태스크 (LittleFS 덧붙이기)
+    ALLOC_SUBSYSTEM_COUNT
+};
+
+enum AllocPolicy : uint8_t
+{
+    ALLOC_POLICY_INHERIT = 0, // 바깥 범위를 따른다
+    ALLOC_POLICY_FORBID,      // 이 범위 안의 할당은 위반
+    ALLOC_POLICY_ALLOW        // 할당 금지 범위 안에서도 허용 (이벤트 때만 도는 경로)
+};
+
+struct AllocStats
+{
+    uint32_t allocs = 0;     // malloc/calloc/realloc 횟수
+    uint32_t frees = 0;
+    uint32_t bytes = 0;      // 할당한 바이트 누계
+    int32_t net = 0;         // 범위 안 할당 - 해제
+    int32_t peakNet = 0;
+    uint32_t violations = 0; // 할당 금지 범위에서의 할당
+};
+
+// RAII 태그: 만든 태스크에서 소멸할 때까지 유효하다. 중첩되면 안쪽 서브시스템으로 세고,
+// 할당 금지 여부는 정책이 ALLOC_POLICY_INHERIT이면 바깥에서 물려받는다.
+class AllocScope
+{
+public:
+    explicit AllocScope(AllocSubsystem subsystem, AllocPolicy policy = ALLOC_POLICY_INHERIT);
+    ~AllocScope();
+    AllocScope(const AllocScope &) = delete;
+    AllocScope &operator=(const AllocScope &) = delete;
+
+private:
+    int8_t _slot;
+    uint8_t _prevSubsystem;
+    bool _prevAllocFree;
+};
+
+void allocLoop(); // loop()에서: 힙 여유/최대 블록을 주기적으로 샘플하고 새 위반을 로그로 남긴다
+void allocAttach(AsyncWebServer &server);
+void allocGetStats(AllocSubsystem subsystem, AllocStats &out);
+uint32_t allocViolationCount();
+
+// 위반 즉시 abort. TIME_TAPE_ALLOC_STRICT나 디버그 빌드(build_type = debug)면 처음부터 켜져 있다.
+void allocSetStrict(bool strict);
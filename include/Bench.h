@@ -0,0 +1,18 @@
+#pragma once
+#include <Arduino.h>
+
+// 마이크로벤치마크 하네스 (TIME_TAPE_BENCH 빌드 전용: env:bench-native, env:bench-esp32).
+// 결과는 한 줄에 JSON 객체 하나(JSON Lines)라 커밋별 출력을 그대로 diff/비교할 수 있다.
+//   {"bench":"config.serialize","case":"msgpack","n":10,"iters":2048,"ns_per_op":5120.3,"min_ns_per_op":5011.0,"cycles_per_op":819,"bytes":812}
+// cycles_per_op는 기기에서만 나온다 (CPU 사이클 카운터).
+typedef void (*BenchFn)(void *ctx);
+
+void benchBegin(const char *target); // 첫 줄: {"meta":...}
+void benchEnd();
+
+// fn을 샘플 하나가 최소 시간을 넘을 만큼 반복하고, 샘플 여러 개의 중앙값을 낸다.
+// n < 0이면 "n"을 생략하고, bytes가 0이면 "bytes"를 생략한다.
+void benchRun(const char *bench, const char *caseName, int n, BenchFn fn, void *ctx, uint32_t bytes = 0);
+
+// 결과를 여기로 흘려 보내 컴파일러가 측정 대상을 지우지 못하게 한다
+void benchKeep(uint32_t value);
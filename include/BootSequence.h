@@ -0,0 +1,49 @@
+#pragma once
+#include <Arduino.h>
+
+class AsyncWebServer;
+
+// 부팅 단계와 단계별 시간 기록 (/boot-trace).
+//
+// 서로 기다릴 필요 없는 느린 단계(파일시스템, WiFi)는 bootRunAsync()로 태스크에 띄우고
+// setup()은 바로 끝난다. 화면은 시간 소스(소프트 리셋 뒤 RTC에 남은 시각, NTP, 동기화 리더)가
+// 하나라도 생기는 순간 부트 애니메이션을 걷고 정상 프레임을 그린다 (bootStep).
+// 시각은 hal::nowUs() 기준 (전원 인가 후 부트로더 시간은 빠진다).
+enum BootPhase : uint8_t
+{
+    BOOT_PHASE_CONFIG = 0,   // NVS 설정 읽기
+    BOOT_PHASE_HARDWARE,     // 디스플레이/버튼/타이머
+    BOOT_PHASE_STORAGE,      // LittleFS 마운트(처음이면 포맷) + 기록 로그 요약
+    BOOT_PHASE_WIFI,         // WiFi 연결 (저장된 AP가 없으면 설정 포털)
+    BOOT_PHASE_SERVICES,     // mDNS, 웹 서버, NTP, OTA, 동기화
+    BOOT_PHASE_TIME,         // 첫 시간 소스까지
+    BOOT_PHASE_FIRST_FRAME,  // 부트 애니메이션이 걷히고 첫 정상 프레임이 나갈 때까지
+    BOOT_PHASE_COUNT
+};
+
+void bootBegin(); // setup() 맨 앞에서 한 번 (리셋 원인 기록)
+void bootPhaseBegin(BootPhase phase);
+void bootPhaseEnd(BootPhase phase, bool ok = true);
+bool bootPhaseStarted(BootPhase phase);
+bool bootPhaseDone(BootPhase phase);
+bool bootPhaseOk(BootPhase phase);
+// 단계에 붙는 짧은 설명 (상수 문자열만: 시간 소스 "rtc"/"network", 실패 이유 등)
+void bootPhaseNote(BootPhase phase, const char *note);
+
+// setup() 뒤로 loop가 부르는 남은 부팅: 시간 소스(TIME)와 첫 연결 뒤 서비스(SERVICES).
+// 기기 동작은 훅으로 받는다 (main.cpp가 채우고, 호스트 테스트는 흉내 낸다).
+struct BootSteps
+{
+    bool (*timeReady)();     // 시간 소스가 있는가 (timeSourceReady)
+    bool (*linkUp)();        // WiFi가 지금 붙어 있는가
+    void (*timeSettled)();   // TIME이 끝날 때 한 번: 시각이 생겼거나, WiFi 뒤로 기다리다 포기했거나
+    void (*wifiFailed)();    // 부팅 연결(BOOT_PHASE_WIFI)이 실패했을 때 한 번
+    void (*startServices)(); // 처음 붙었고 STORAGE도 끝났을 때 한 번 (SERVICES 단계 안에서)
+};
+bool bootStepsPending(); // TIME과 SERVICES가 둘 다 끝날 때까지 true: 그동안 loop가 bootStep()을 부른다
+void bootStep(const BootSteps &steps);
+
+// fn을 별도 태스크에서 phase로 감싸 돌린다. 반환값이 단계 성공 여부. 태스크를 못 만들면 여기서 바로 돈다.
+void bootRunAsync(BootPhase phase, bool (*fn)(), uint32_t stackBytes);
+
+void bootAttach(AsyncWebServer &server); // GET /boot-trace
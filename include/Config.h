@@ -4,9 +4,7 @@
 #include <Arduino.h>
 #include <vector>
 
-// --- 하드웨어 핀 및 LED 설정 ---
-#define PIN_INNER 4
-#define PIN_OUTER 3
+// --- 하드웨어 핀 설정 (LED 링 핀/개수/배치는 Topology.h) ---
 #define SDI_PIN 7
 #define SCLK_PIN 8
 #define LOAD_PIN 9
@@ -17,8 +15,10 @@
 #define BTN_3 10
 #define BTN_4 20
 
-#define NUM_LEDS_INNER 16
-#define NUM_LEDS_OUTER 24
+// 디스플레이 갱신 주기 (동기화 모드에서는 리더 클럭 기준 격자에 맞춰 그린다)
+#define FRAME_INTERVAL_MS 100
+// 프리셋 전환 효과가 도는 동안만 쓰는 주기 (끝나면 FRAME_INTERVAL_MS로 돌아간다)
+#define TRANSITION_FRAME_INTERVAL_MS 20
 
 // --- 모드 상수 정의 ---
 #define MODE_NONE 0
@@ -76,7 +76,7 @@ struct ModePayload
 struct RingConfig
 {
 	int mode = 0;
-	int colorMode = 0; // 0:단색, 1:무지개, 2:시간그라, 3:공간그라
+	int colorMode = 0; // 0:단색, 1:무지개, 2:시간그라, 3:공간그라, 4:숨쉬기, 5:혜성, 6:반짝임, 7:회전 무지개
 	uint32_t colorFill = 0;
 	uint32_t colorFill2 = 0;
 	uint32_t colorEmpty = 0;
@@ -134,6 +134,19 @@ inline bool isInteractiveMode(int mode)
 	return mode >= MODE_COUNTER;
 }
 
+// 요일/시각에 맞춰 프리셋을 자동으로 바꾸는 규칙 (days: bit0=일 ~ bit6=토)
+constexpr uint8_t SCHEDULE_EVERY_DAY = 0x7F;
+constexpr uint8_t SCHEDULE_WEEKDAYS = 0x3E;
+constexpr uint8_t SCHEDULE_WEEKEND = 0x41;
+
+struct ScheduleRule
+{
+	uint8_t days = SCHEDULE_EVERY_DAY;
+	uint8_t hour = 0;
+	uint8_t minute = 0;
+	int preset = 0;
+};
+
 // 전체 설정 구조체
 struct AppConfig
 {
@@ -146,12 +159,35 @@ struct AppConfig
 	int nightStartHour = 22;
 	int nightEndHour = 7;
 	int nightBrightness = 10;
+
+	int syncRole = 0; // SyncManager.h의 SyncRole (0: 끔, 1: 리더, 2: 팔로워)
+
+	int transitionStyle = 1; // 프리셋 전환 효과: graphics/Transition.h의 TransitionStyle (0: 즉시, 1: 페이드, 2: 와이프)
+	int transitionMs = 400;  // 0~3000
+
+	std::vector<ScheduleRule> schedules; // 같은 시각이면 뒤쪽 규칙이 이긴다
 };
 
+// 현재 프리셋의 인터랙티브 모드 (Inner 우선, Outer 차선, 없으면 MODE_NONE)
+inline int activeInteractiveMode(const AppConfig &config)
+{
+	if (config.presets.empty() || config.currentPresetIndex < 0 || config.currentPresetIndex >= (int)config.presets.size())
+		return MODE_NONE;
+	const Preset &p = config.presets[config.currentPresetIndex];
+	if (isInteractiveMode(p.inner.mode))
+		return p.inner.mode;
+	if (isInteractiveMode(p.outer.mode))
+		return p.outer.mode;
+	return MODE_NONE;
+}
+
 // 전역 변수 및 함수 선언
 extern AppConfig appConfig;
 void loadConfig();		  // 설정 불러오기
 void saveConfigToFile();  // (필요시) 현재 설정을 파일로 저장
 void initDefaultConfig(); // 기본값 초기화
+void switchPreset(int index); // 즉시 반영하고 저장은 configSaveLoop()로 미룬다
+void requestConfigSave();     // 잠시 뒤 한 번에 저장 (연속 변경은 합친다)
+void configSaveLoop();        // loop마다: 미뤄 둔 저장 처리
 
 #endif
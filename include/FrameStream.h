@@ -0,0 +1,15 @@
+#pragma once
+#include <Arduino.h>
+
+class AsyncWebServer;
+
+// /ws/frames: 합성된 LED 프레임과 7세그 raw 바이트를 바이너리로 푸시한다.
+//
+// 메시지 형식 (little endian 없음, 모두 1바이트 단위)
+//   [0] 타입 (1: key, 2: delta)  [1] seq  [2] LED 수  [3] 밝기
+//   [4..6] 7세그 h/t/o raw 바이트
+//   key  : LED 수 x (r, g, b)
+//   delta: [7] 변경 수 n, 이어서 n x (idx, r, g, b)
+void frameStreamAttach(AsyncWebServer &server);
+bool frameStreamActive(); // 연결된 클라이언트가 없으면 false (호출 측은 여기서 끝낸다)
+void frameStreamPublish(const uint32_t *pixels, uint8_t count, uint8_t brightness, const uint8_t seg[3]);
@@ -0,0 +1,22 @@
+#pragma once
+#include <Arduino.h>
+
+class AsyncWebServer;
+
+// 뽀모도로/타이머/카운터 활동 기록 (재부팅 후에도 남는다).
+//
+// LittleFS의 세그먼트 파일 8개(각 4KB = 플래시 한 블록)에 8바이트 레코드를 덧붙이기만 하고,
+// 가득 차면 가장 오래된 세그먼트를 통째로 새로 쓴다. 기존 레코드를 고쳐 쓰는 일은 없다.
+// 일별 요약은 부팅 때 한 번 만들어 RAM에 두고 기록할 때마다 갱신하므로,
+// /history 조회는 로그를 다시 읽지 않는다 (원본 이벤트 조회만 파일을 읽는다).
+enum HistoryEventType : uint8_t
+{
+    HISTORY_POMO_WORK = 1, // value: 작업 단계 길이 (분)
+    HISTORY_POMO_REST = 2, // value: 휴식 단계 길이 (분)
+    HISTORY_TIMER = 3,     // value: 타이머 길이 (초)
+    HISTORY_COUNTER = 4    // value: 초기화 직전 카운터 값
+};
+
+void historyBegin(); // LittleFS 마운트 이후 한 번 (기존 세그먼트를 읽어 요약을 만든다)
+void historyRecord(HistoryEventType type, uint32_t value); // 프레임 경로에서 불러도 된다: 대기열에만 넣고 파일은 기록 태스크가 쓴다
+void historyAttach(AsyncWebServer &server);
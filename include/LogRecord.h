@@ -0,0 +1,97 @@
+#pragma once
+#include <Arduino.h>
+#include <cstring>
+#include <type_traits>
+
+// 지연 포맷 로그 레코드.
+//
+// 호출 측은 포맷 문자열 주소(리터럴이라 펌웨어 안에서 바뀌지 않는다 = 포맷 ID)와 인자 원값만 적는다.
+// 문자열로 만드는 일(logRecordFormat)은 드레인 태스크가 출력할 때 한다.
+// 인자는 타입대로 이어 붙인다: 4바이트 이하 정수/enum/bool → 4바이트, 8바이트 정수 → 8,
+// 실수 → double 8, 문자열 → 길이 1바이트 + 내용, 그 밖의 포인터 → 포인터 크기.
+// 공간이 모자라면 거기서 끊고 truncated를 세운다 (출력 끝에 "..." 가 붙는다).
+constexpr size_t kLogArgBytes = 88;
+
+struct LogRecord
+{
+    const char *format;
+    uint8_t level;
+    uint8_t argLen;
+    bool truncated;
+    uint8_t args[kLogArgBytes];
+};
+
+class LogArgWriter
+{
+public:
+    explicit LogArgWriter(LogRecord &record) : _r(record)
+    {
+        _r.argLen = 0;
+        _r.truncated = false;
+    }
+
+    template <typename T, typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, int>::type = 0>
+    void put(T value)
+    {
+        if (sizeof(T) <= 4)
+        {
+            // 부호 있는 타입은 부호 확장해서 (읽는 쪽은 포맷의 %d/%u로 해석한다)
+            const uint32_t word = std::is_signed<T>::value ? (uint32_t)(int32_t)value : (uint32_t)value;
+            putBytes(&word, sizeof(word));
+        }
+        else
+        {
+            const uint64_t word = (uint64_t)value;
+            putBytes(&word, sizeof(word));
+        }
+    }
+
+    void put(double value) { putBytes(&value, sizeof(value)); }
+
+    void put(const char *text)
+    {
+        if (text == nullptr)
+            text = "(null)";
+        if (_r.truncated || _r.argLen >= kLogArgBytes)
+        {
+            _r.truncated = true;
+            return;
+        }
+        size_t len = strlen(text);
+        const size_t room = kLogArgBytes - _r.argLen - 1;
+        if (len > room || len > 255)
+        {
+            len = room < 255 ? room : 255;
+            _r.truncated = true;
+        }
+        _r.args[_r.argLen++] = (uint8_t)len;
+        memcpy(_r.args + _r.argLen, text, len);
+        _r.argLen += (uint8_t)len;
+    }
+
+    void put(const String &text) { put(text.c_str()); }
+
+    template <typename T>
+    void put(const T *pointer)
+    {
+        const uintptr_t word = (uintptr_t)pointer;
+        putBytes(&word, sizeof(word));
+    }
+
+private:
+    void putBytes(const void *bytes, size_t size)
+    {
+        if (_r.truncated || _r.argLen + size > kLogArgBytes)
+        {
+            _r.truncated = true;
+            return;
+        }
+        memcpy(_r.args + _r.argLen, bytes, size);
+        _r.argLen += (uint8_t)size;
+    }
+
+    LogRecord &_r;
+};
+
+// 레코드를 한 줄로 (printf와 같은 규칙, 잘린 줄은 "..."로 끝난다). 반환값은 쓴 길이 (< size).
+size_t logRecordFormat(const LogRecord &record, char *out, size_t size);
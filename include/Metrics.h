@@ -0,0 +1,30 @@
+#pragma once
+#include <Arduino.h>
+
+class AsyncWebServer;
+
+// /metrics: Prometheus 텍스트 형식의 장치 상태.
+// 기록 함수는 hot path에서 불리므로 relaxed atomic 증가만 한다 (락/할당 없음).
+enum MetricsRoute : uint8_t
+{
+    ROUTE_GET_CONFIG = 0,
+    ROUTE_SET_CONFIG,
+    ROUTE_FW_INFO,
+    ROUTE_FW_UPLOAD,
+    ROUTE_FS_UPLOAD,
+    ROUTE_OTA_BEGIN,
+    ROUTE_OTA_CHUNK,
+    ROUTE_OTA_COMMIT,
+    ROUTE_OTA_STATUS,
+    ROUTE_OTA_ABORT,
+    ROUTE_METRICS,
+    ROUTE_HISTORY,
+    ROUTE_ALLOC,
+    ROUTE_TOPOLOGY,
+    ROUTE_BOOT_TRACE,
+    ROUTE_COUNT
+};
+
+void metricsAttach(AsyncWebServer &server);
+void metricsRecordHttp(MetricsRoute route, uint32_t latencyUs);
+void metricsRecordNvsWrite(size_t bytes);
@@ -1,3 +1,6 @@
 #pragma once
-void setupNetwork();
+// 부팅은 단계별로 나뉜다 (BootSequence.h). 마운트는 태스크에서 돌 수 있고, 서비스는 loop에서 시작한다.
+// WiFi 연결 자체는 WifiLink.h.
+bool networkMountStorage();  // LittleFS (마운트가 안 되면 포맷 후 다시)
+void networkStartServices(); // mDNS + 웹 서버 (WiFi 연결 뒤 한 번)
 void networkLoop();
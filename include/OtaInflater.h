@@ -0,0 +1,71 @@
+#pragma once
+#include <Arduino.h>
+
+struct tinfl_decompressor_tag;
+
+// 압축 해제된 바이트를 받는 쪽 (보통 Update.write). false면 중단.
+typedef bool (*OtaSinkFn)(uint8_t *data, size_t len, void *ctx);
+
+// gzip(.bin.gz) OTA 이미지를 스트리밍으로 풀어 sink에 넘긴다.
+// ROM의 tinfl을 쓰고, deflate 창(32KB)만큼의 순환 버퍼 하나로 끝낸다.
+class OtaInflater
+{
+public:
+    static constexpr size_t kWindowSize = 32768; // deflate 최대 거리 (TINFL_LZ_DICT_SIZE)
+
+    static bool isGzip(const uint8_t *data, size_t len);
+
+    OtaInflater() = default;
+    ~OtaInflater();
+    OtaInflater(const OtaInflater &) = delete;
+    OtaInflater &operator=(const OtaInflater &) = delete;
+
+    bool begin();
+    void end();
+    bool write(const uint8_t *data, size_t len, OtaSinkFn sink, void *ctx);
+    bool finish(); // 입력이 끝난 뒤 CRC32/ISIZE 트레일러 검증
+    bool finished() const { return _state == STATE_DONE; }
+    const char *error() const { return _error; }
+
+    size_t inputBytes() const { return _inputBytes; }
+    size_t outputBytes() const { return _outputBytes; }
+
+private:
+    enum State : uint8_t
+    {
+        STATE_HEADER,
+        STATE_EXTRA_LEN,
+        STATE_EXTRA,
+        STATE_NAME,
+        STATE_COMMENT,
+        STATE_HEADER_CRC,
+        STATE_DEFLATE,
+        STATE_TRAILER,
+        STATE_DONE,
+        STATE_ERROR
+    };
+
+    tinfl_decompressor_tag *_decomp = nullptr;
+    uint8_t *_window = nullptr;
+    size_t _windowPos = 0;
+
+    State _state = STATE_HEADER;
+    uint8_t _flags = 0;
+    uint8_t _scratch[10];
+    size_t _scratchLen = 0;
+    size_t _skipRemaining = 0;
+    uint8_t _tail[8]; // 입력의 마지막 8바이트 (gzip 트레일러)
+    size_t _tailLen = 0;
+    size_t _trailerBytes = 0;
+
+    uint32_t _crc = 0;
+    size_t _inputBytes = 0;
+    size_t _outputBytes = 0;
+    const char *_error = nullptr;
+
+    State nextHeaderState(State from) const;
+    size_t parseHeader(const uint8_t *data, size_t len);
+    size_t inflate(const uint8_t *data, size_t len, OtaSinkFn sink, void *ctx);
+    void rememberTail(const uint8_t *data, size_t len);
+    void fail(const char *reason);
+};
@@ -0,0 +1,68 @@
+#pragma once
+#include <Arduino.h>
+#include <mbedtls/sha256.h>
+#include "OtaInflater.h"
+
+// 이어 올리기가 가능한 OTA 세션 (/ota/begin, /ota/chunk, /ota/commit).
+// 청크는 offset + CRC32로 검증한 뒤에만 받아들이고, 플래시에는 4KB 섹터 단위로만 쓴다.
+// 연결이 끊겨도 세션은 RAM에 남아 있으므로 클라이언트는 next 오프셋부터 다시 보내면 된다.
+class OtaSession
+{
+public:
+    static constexpr size_t kSectorSize = 4096;
+    static constexpr size_t kChunkMax = 4096;
+
+    enum ChunkResult : uint8_t
+    {
+        CHUNK_OK,
+        CHUNK_DUPLICATE,       // 이미 받은 범위 (재전송) - next만 다시 알려주면 된다
+        CHUNK_OFFSET_MISMATCH, // 중간이 비었음
+        CHUNK_CRC_MISMATCH,
+        CHUNK_TOO_LARGE,
+        CHUNK_WRITE_FAILED
+    };
+
+    OtaSession() = default;
+    ~OtaSession();
+    OtaSession(const OtaSession &) = delete;
+    OtaSession &operator=(const OtaSession &) = delete;
+
+    bool begin(int updateCommand, size_t size, const uint8_t sha256[32], bool gzip);
+    bool matches(int updateCommand, size_t size, const uint8_t sha256[32]) const;
+    ChunkResult writeChunk(size_t offset, const uint8_t *data, size_t len, uint32_t crc);
+    bool commit();
+    void abort();
+
+    bool active() const { return _active; }
+    int updateCommand() const { return _updateCommand; }
+    size_t received() const { return _received; }
+    size_t size() const { return _size; }
+    bool gzip() const { return _inflater != nullptr; }
+    const char *error() const { return _error; }
+    unsigned long lastActivityAt() const { return _lastActivityAt; }
+
+    float kbps() const { return _kbps; }
+    long etaSeconds() const;
+
+private:
+    bool _active = false;
+    int _updateCommand = -1;
+    size_t _size = 0;
+    size_t _received = 0;
+    uint8_t _expectedSha[32];
+    mbedtls_sha256_context _sha;
+
+    uint8_t *_sector = nullptr; // 압축 해제 후 플래시로 갈 바이트를 섹터 크기로 모은다
+    size_t _sectorLen = 0;
+    OtaInflater *_inflater = nullptr;
+
+    unsigned long _startedAt = 0;
+    unsigned long _lastActivityAt = 0;
+    float _kbps = 0.0f;
+    const char *_error = nullptr;
+
+    static bool sectorSink(uint8_t *data, size_t len, void *ctx);
+    bool appendToSector(const uint8_t *data, size_t len);
+    bool flushSector();
+    void release();
+};
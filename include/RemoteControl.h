@@ -0,0 +1,20 @@
+#pragma once
+#include <Arduino.h>
+
+class AsyncWebServer;
+class ButtonManager;
+
+// /ws/ctrl: 가상 버튼/제스처 입력과 직접 명령을 받는 원격 제어 채널.
+//
+// 요청 (텍스트 JSON, id/t는 그대로 ack에 돌려준다)
+//   {"id":1,"cmd":"press","btn":1..4}
+//   {"id":2,"cmd":"combo"}                      버튼 1+2 동시 입력 (카운터 초기화)
+//   {"id":3,"cmd":"counter","value":42}
+//   {"id":4,"cmd":"timer","action":"start|pause|toggle|reset"}
+//   {"id":5,"cmd":"preset","dir":"next|prev"}
+//   {"id":6,"cmd":"ping","t":1234}
+// 응답
+//   {"id":..,"ok":true,"t":..,"us":<수신~ack 장치 내부 지연>,"state":{...}}
+void remoteControlAttach(AsyncWebServer &server);
+void remoteControlBeginFrame(ButtonManager &buttons); // loop 앞부분: 쌓인 명령 적용
+void remoteControlEndFrame();                        // loop 끝: 결과 상태로 ack
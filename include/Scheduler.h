@@ -0,0 +1,14 @@
+#pragma once
+#include <Arduino.h>
+#include <time.h>
+
+struct ScheduleRule;
+
+// 요일/시각 규칙(AppConfig::schedules)에 따라 프리셋을 자동으로 바꾼다.
+// 다음 발화 시각을 한 번만 계산해 타이머 엔진에 걸어 두고, 그 시각에만 깨어나 전환한다.
+void schedulerBegin();        // timerEngine.begin() 이후 한 번
+void schedulerReload();       // 규칙이 바뀌었을 때 (async_tcp 태스크에서 불러도 된다)
+void schedulerLoop();         // loop마다: 재계산 요청만 처리
+time_t schedulerNextFireAt(); // 다음 전환 시각 (예정 없음/시계 미설정이면 0)
+int schedulerNextPreset();    // 다음 전환 대상 프리셋 (없으면 -1)
+time_t scheduleNextOccurrence(const ScheduleRule &rule, time_t after); // after 이후 규칙이 처음 맞는 지역 시각 (요일이 하나도 없으면 0)
@@ -0,0 +1,17 @@
+#pragma once
+#include <Arduino.h>
+
+class AsyncWebServer;
+class DisplayManager;
+
+// /ws/state: 장치의 런타임 상태를 푸시한다 (클라이언트 폴링 대신).
+//
+// 접속 직후 전체 스냅샷 한 번, 이후에는 바뀐 항목만 담은 delta를 보낸다.
+//   {"t":"snap","seq":1,"preset":0,"presets":3,"mode":11,"counter":0,
+//    "timer":{"running":true,"elapsedMs":1234},"pomo":{"state":0,"running":false,"elapsedMs":0},
+//    "brightness":50,"night":false}
+//   {"t":"delta","seq":2,"preset":1}
+// 타이머 경과 시간은 흐르는 값이라 매번 보내지 않는다. running/elapsedMs로 클라이언트가 외삽하고,
+// 시작/정지/리셋처럼 외삽이 어긋나는 경우에만 다시 보낸다.
+void stateStreamAttach(AsyncWebServer &server);
+void stateStreamEndFrame(const DisplayManager &display); // 프레임마다 한 번: 변경분을 모아 최대 1메시지
@@ -0,0 +1,29 @@
+#pragma once
+#include <Arduino.h>
+
+// 여러 대의 Time Tape를 한 박자로 돌리는 UDP 멀티캐스트 동기화.
+//
+// 리더는 프레임마다 비콘(렌더 클럭, 벽시계, 프리셋, 인터랙티브 상태)을 멀티캐스트하고,
+// 팔로워는 렌더 클럭을 리더에 위상 고정한 뒤 프리셋/카운터/타이머/뽀모도로를 그대로 따라간다.
+// 팔로워의 버튼 입력은 다음 비콘에서 리더 상태로 덮어써진다.
+enum SyncRole : uint8_t
+{
+    SYNC_OFF = 0,
+    SYNC_LEADER = 1,
+    SYNC_FOLLOWER = 2
+};
+
+struct SyncStats
+{
+    SyncRole role;
+    bool locked;            // 팔로워: 최근 비콘을 받고 있는지
+    int32_t offsetMs;       // 팔로워: 리더 클럭 - 로컬 millis()
+    uint32_t spreadMs;      // 팔로워: 최근 비콘들의 오프셋 폭 (네트워크 지터 = 추정 스큐 상한)
+    uint32_t beaconsSent;
+    uint32_t beaconsReceived;
+};
+
+void syncBegin();              // WiFi 연결 후 한 번
+void syncLoop();               // loop마다: 역할 변경 반영, 비콘 송수신
+uint32_t syncMillis();         // 장치 간에 공유되는 렌더 클럭 (동기화가 꺼져 있으면 millis())
+void syncGetStats(SyncStats &out);
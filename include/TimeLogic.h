@@ -4,12 +4,15 @@
 #include <Arduino.h>
 #include <time.h>
 
-void setupTime();
+void setupTimeZone();   // 부팅 맨 앞에서 (RTC에 남은 시각도 바로 지역 시각으로 읽히게)
+void setupTime();       // WiFi 연결 뒤 NTP 시작 (기다리지 않는다)
+bool timeSourceReady(); // RTC 유지 시각, NTP, 동기화 리더 중 하나라도 시각을 줬는가
 bool getLocalTimeInfo(struct tm * info);
-time_t parseDate(String dateStr);
+time_t parseDate(const char *dateStr);
 
 // [수정] 통합 계산 함수들
-float calculateProgress(int mode, struct tm * t, String sDate, String tDate);
+// sDate/tDate는 모드 4(D-Day)에서만 읽는다 (nullptr이면 빈 날짜)
+float calculateProgress(int mode, struct tm * t, const char *sDate, const char *tDate);
 int getDaysInMonth(int month, int year);
 bool isLeap(int year);
 
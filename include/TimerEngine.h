@@ -0,0 +1,121 @@
+#pragma once
+#include <Arduino.h>
+#include <vector>
+#include "TimerWheel.h"
+
+// 이름 붙은 타이머 여러 개를 하나의 타이머 휠 위에서 돌리는 엔진.
+// 스톱워치/카운트다운/뽀모도로/매일 알람을 지원하고, 만료는 update()에서 리스너로 이벤트를 밀어 준다.
+// 시간은 hal::uptimeMs() 기반 64비트 ms라 millis() 롤오버(49일)와 무관하다.
+enum TimerKind : uint8_t
+{
+    TIMER_STOPWATCH,
+    TIMER_COUNTDOWN,
+    TIMER_POMODORO,
+    TIMER_ALARM
+};
+
+// 값은 InteractiveManager::PomoState와 같다 (상태 채널/동기화 비콘에 그대로 실린다)
+enum PomodoroPhase : uint8_t
+{
+    POMODORO_WORK,
+    POMODORO_WAIT_REST,
+    POMODORO_REST,
+    POMODORO_WAIT_WORK
+};
+
+enum TimerEventType : uint8_t
+{
+    TIMER_EVENT_EXPIRED,   // 카운트다운 종료
+    TIMER_EVENT_PHASE_END, // 뽀모도로 작업/휴식 단계 종료 (phase = 끝난 단계)
+    TIMER_EVENT_ALARM      // 알람 시각 도달 (다음 날로 자동 재설정)
+};
+
+typedef uint16_t TimerHandle;
+constexpr TimerHandle kInvalidTimer = 0xFFFF;
+
+struct TimerEvent
+{
+    TimerEventType type;
+    TimerHandle timer;
+    TimerKind kind;
+    uint8_t phase;
+    uint64_t atMs;
+    uint64_t durationMs; // 끝난 카운트다운/단계의 길이
+};
+
+typedef void (*TimerListener)(const TimerEvent &event, void *ctx);
+
+class TimerEngine
+{
+public:
+    static constexpr size_t kNameMax = 16;
+
+    void begin();
+    void update(); // loop마다: 지난 휠 칸을 돌리고 만료 이벤트를 보낸다
+    uint64_t now() const;
+
+    TimerHandle create(const char *name, TimerKind kind);
+    TimerHandle find(const char *name) const;
+    void destroy(TimerHandle h);
+    const char *name(TimerHandle h) const;
+
+    // 값이 같으면 아무것도 하지 않으므로 매번 불러도 된다. 동작 중이면 기한을 다시 건다.
+    void setDuration(TimerHandle h, uint64_t durationMs);
+    void setPomodoro(TimerHandle h, uint64_t workMs, uint64_t restMs);
+    void setAlarm(TimerHandle h, uint8_t hour, uint8_t minute); // 로컬 시각 기준 매일
+
+    void start(TimerHandle h);  // 끝난 카운트다운은 처음부터 다시
+    void pause(TimerHandle h);
+    void reset(TimerHandle h);  // 경과 시간만 지운다 (뽀모도로 단계는 유지)
+    void advancePhase(TimerHandle h); // 뽀모도로 대기 단계 → 다음 단계 시작
+    void restore(TimerHandle h, bool running, uint64_t elapsedMs, uint8_t phase); // 동기화 팔로워용
+
+    bool running(TimerHandle h) const;
+    bool finished(TimerHandle h) const;
+    uint64_t elapsedMs(TimerHandle h) const;
+    uint64_t durationMs(TimerHandle h) const; // 뽀모도로는 현재 단계 길이
+    uint8_t phase(TimerHandle h) const;
+
+    bool addListener(TimerListener listener, void *ctx);
+
+private:
+    struct Timer
+    {
+        char name[kNameMax] = {};
+        TimerKind kind = TIMER_STOPWATCH;
+        bool used = false;
+        bool running = false;
+        bool finished = false;
+        uint8_t phase = POMODORO_WORK;
+        uint64_t startedAt = 0;
+        uint64_t accumulatedMs = 0;
+        uint64_t durationMs = 0;
+        uint64_t workMs = 0;
+        uint64_t restMs = 0;
+        uint8_t alarmHour = 0;
+        uint8_t alarmMinute = 0;
+        time_t alarmAt = 0; // 다음 울릴 벽시계 시각 (시계가 아직 없으면 0)
+        TimerWheel::NodeId node = TimerWheel::kInvalidNode;
+    };
+
+    struct Listener
+    {
+        TimerListener fn;
+        void *ctx;
+    };
+
+    std::vector<Timer> _timers;
+    std::vector<Listener> _listeners;
+    TimerWheel _wheel;
+
+    Timer *get(TimerHandle h);
+    const Timer *get(TimerHandle h) const;
+    uint64_t phaseDuration(const Timer &t) const;
+    void rearm(TimerHandle h);
+    void armAlarm(Timer &t);
+    void emit(TimerEventType type, TimerHandle h, const Timer &t, uint8_t phase, uint64_t durationMs);
+    void handleExpire(TimerHandle h);
+    static void onWheelExpire(TimerWheel::NodeId node, uint32_t owner, void *ctx);
+};
+
+extern TimerEngine timerEngine;
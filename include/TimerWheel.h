@@ -0,0 +1,58 @@
+#pragma once
+#include <Arduino.h>
+#include <vector>
+
+// 계층형 타이머 휠 (4단 x 64칸, 한 칸 10ms, 64비트 ms 타임스탬프).
+// 등록/취소는 O(1), 만료는 칸이 돌아올 때 한꺼번에 꺼낸다 (상위 단은 하위로 내려보내며 재배치).
+// 약 46시간보다 먼 기한은 최상위 단 끝에 두었다가 내려올 때 다시 계산한다.
+class TimerWheel
+{
+public:
+    typedef uint32_t NodeId;
+    typedef void (*ExpireFn)(NodeId node, uint32_t owner, void *ctx);
+    static constexpr NodeId kInvalidNode = 0xFFFFFFFF;
+    static constexpr uint32_t kTickMs = 10;
+
+    TimerWheel();
+    void begin(uint64_t nowMs); // 첫 arm 전에 현재 시각으로 기준을 잡는다
+    NodeId allocate(uint32_t owner); // 노드는 재사용되며, 해제 전까지 arm/disarm을 반복할 수 있다
+    void release(NodeId node);
+
+    void arm(NodeId node, uint64_t deadlineMs); // 이미 걸려 있으면 옮긴다
+    void disarm(NodeId node);
+    bool armed(NodeId node) const;
+    uint64_t deadline(NodeId node) const;
+
+    // now까지 지난 칸을 돌며 기한이 된 노드를 떼어 낸 뒤 onExpire를 부른다.
+    // 콜백 안에서 같은 노드를 다시 arm해도 된다.
+    void advance(uint64_t nowMs, ExpireFn onExpire, void *ctx);
+
+private:
+    static constexpr uint8_t kLevels = 4;
+    static constexpr uint8_t kSlotBits = 6;
+    static constexpr uint32_t kSlots = 1u << kSlotBits;
+    static constexpr int32_t kNil = -1;
+
+    struct Node
+    {
+        uint64_t deadlineMs = 0;
+        uint32_t owner = 0;
+        int32_t prev = kNil;
+        int32_t next = kNil;
+        int16_t list = kNil; // 연결된 리스트 번호 (level * kSlots + slot, kExpiredList) 또는 kNil
+        bool used = false;
+    };
+
+    static constexpr int16_t kExpiredList = kLevels * kSlots;
+
+    std::vector<Node> _nodes;
+    int32_t _heads[kLevels * kSlots + 1];
+    int32_t _freeHead = kNil;
+    uint64_t _currentTick = 0;
+    bool _started = false;
+
+    void link(NodeId node, int16_t list);
+    void unlink(NodeId node);
+    void place(NodeId node);
+    void cascade(uint8_t level);
+};
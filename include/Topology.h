@@ -0,0 +1,142 @@
+#pragma once
+#include <Arduino.h>
+
+class AsyncWebServer;
+
+// LED 링 배치 기술자.
+//
+// 링마다 데이터 핀, LED 수, 스트립 안 시작 위치, 감긴 방향, 회전(논리 0번 = 12시 위치)을 적는다.
+// 논리 프레임(레이어, 효과, /ws/frames)은 배치와 상관없이 안쪽 링 다음 바깥쪽 링 순서로 0부터 이어지고,
+// 물리 스트립 위치로 옮기는 일은 LedDriver::writeFrame 한 곳에서만 한다.
+//
+// 알려진 배치는 빌드 플래그로 고르고(-D TIME_TAPE_TOPOLOGY=kTopologyChain48), 경로표가 constexpr로
+// 만들어져 배치마다 따로 특수화된 커널이 된다. NVS에 저장된 배치(/topology)가 있으면 그것이 이기고,
+// 알려진 배치와 다르면 RAM 경로표를 도는 런타임 커널을 쓴다 (변형 하드웨어용).
+enum RingId : uint8_t
+{
+    RING_INNER = 0,
+    RING_OUTER,
+    RING_COUNT
+};
+
+struct RingTopology
+{
+    int16_t pin;
+    uint16_t count;
+    uint16_t start;    // 스트립에서 이 링의 첫 LED (앞쪽 더미/레벨 시프터 픽셀 건너뛰기)
+    int8_t direction;  // +1: 진행 방향 = 데이터 방향, -1: 반대로 감긴 링
+    uint16_t rotation; // 논리 0번 LED가 start에서 direction 쪽으로 몇 칸째인가
+};
+
+struct Topology
+{
+    const char *name;
+    RingTopology rings[RING_COUNT];
+
+    constexpr uint16_t pixels() const { return rings[RING_INNER].count + rings[RING_OUTER].count; }
+    constexpr uint16_t offset(uint8_t ring) const { return ring == RING_INNER ? 0 : rings[RING_INNER].count; }
+    constexpr uint16_t count(uint8_t ring) const { return rings[ring].count; }
+};
+
+// 레이어/프레임 버퍼 크기. 런타임 배치도 이 안에 들어와야 한다.
+constexpr uint16_t kMaxPixels = 64;
+constexpr uint8_t kMaxStrips = RING_COUNT;
+
+// 지금 보드: 핀 두 개에 링 하나씩
+constexpr Topology kTopologyDual16x24 = {"dual-16-24", {{4, 16, 0, 1, 0}, {3, 24, 0, 1, 0}}};
+// 초기 보드: 한 줄에 더미 8개 + 안쪽 16 + 바깥쪽 24 (총 48)
+constexpr Topology kTopologyChain48 = {"chain-48", {{4, 16, 8, 1, 0}, {4, 24, 24, 1, 0}}};
+
+#ifndef TIME_TAPE_TOPOLOGY
+#define TIME_TAPE_TOPOLOGY kTopologyDual16x24
+#endif
+static constexpr const Topology &kBuildTopology = TIME_TAPE_TOPOLOGY;
+static_assert(kBuildTopology.pixels() <= kMaxPixels, "topology does not fit kMaxPixels");
+
+// 논리 픽셀 하나가 가는 곳
+struct PixelRoute
+{
+    uint8_t strip;
+    uint16_t index;
+};
+
+// 두 번째 링이 첫 번째와 같은 핀이면 같은 스트립을 쓴다
+constexpr uint8_t topologyStripOf(const Topology &t, uint8_t ring)
+{
+    return (ring == RING_OUTER && t.rings[RING_OUTER].pin == t.rings[RING_INNER].pin) ? 0 : ring;
+}
+
+constexpr uint8_t topologyStripCount(const Topology &t)
+{
+    return t.rings[RING_OUTER].pin == t.rings[RING_INNER].pin ? 1 : 2;
+}
+
+// 스트립 길이 = 그 스트립을 쓰는 링들의 끝 중 가장 먼 곳
+constexpr uint16_t topologyStripLength(const Topology &t, uint8_t strip)
+{
+    uint16_t length = 0;
+    for (uint8_t ring = 0; ring < RING_COUNT; ring++)
+    {
+        const uint16_t end = t.rings[ring].start + t.rings[ring].count;
+        if (topologyStripOf(t, ring) == strip && end > length)
+            length = end;
+    }
+    return length;
+}
+
+constexpr PixelRoute topologyRoute(const Topology &t, uint16_t n)
+{
+    const uint8_t ring = n < t.rings[RING_INNER].count ? RING_INNER : RING_OUTER;
+    const RingTopology &r = t.rings[ring];
+    const uint16_t i = n - t.offset(ring);
+    const uint16_t step = r.direction < 0 ? (uint16_t)(r.count - i % r.count) % r.count : i;
+    return {topologyStripOf(t, ring), (uint16_t)(r.start + (r.rotation + step) % r.count)};
+}
+
+constexpr bool topologySame(const Topology &a, const Topology &b)
+{
+    for (uint8_t ring = 0; ring < RING_COUNT; ring++)
+    {
+        const RingTopology &x = a.rings[ring];
+        const RingTopology &y = b.rings[ring];
+        if (x.pin != y.pin || x.count != y.count || x.start != y.start || x.direction != y.direction || x.rotation != y.rotation)
+            return false;
+    }
+    return true;
+}
+
+// 알려진 배치의 경로표 (컴파일 시점에 만들어져 플래시에 들어간다)
+template <const Topology &T>
+struct FixedRoutes
+{
+    static constexpr uint16_t kPixels = T.pixels();
+    struct Table
+    {
+        PixelRoute routes[kPixels];
+    };
+
+    static constexpr Table build()
+    {
+        Table table = {};
+        for (uint16_t n = 0; n < kPixels; n++)
+            table.routes[n] = topologyRoute(T, n);
+        return table;
+    }
+
+    static constexpr Table kTable = build();
+};
+
+template <const Topology &T>
+constexpr typename FixedRoutes<T>::Table FixedRoutes<T>::kTable;
+
+// 링 크기/총합/방향/회전/핀 범위, 같은 스트립의 두 링이 겹치지 않는지
+bool topologyValid(const Topology &t);
+// 경로표가 컴파일돼 들어간 배치인가 (아니면 런타임 커널)
+bool topologyKnown(const Topology &t);
+// NVS에 저장된 배치 (없거나 잘못됐으면 false)
+bool topologyLoad(Topology &out);
+bool topologySave(const Topology &t);
+void topologyClear();
+// 켜질 때 쓸 배치: 저장된 배치, 없으면 빌드 배치. /topology가 이것을 보고한다.
+const Topology &topologyForBoot();
+void topologyAttach(AsyncWebServer &server); // GET/POST /topology (적용은 재부팅 후)
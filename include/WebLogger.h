@@ -1,5 +1,89 @@
 #pragma once
 #include <Arduino.h>
+#include "LogRecord.h"
 
-void webLog(const String& msg);
-void webLogf(const char* format, ...);
+enum LogLevel : uint8_t
+{
+    LOG_LEVEL_DEBUG = 0,
+    LOG_LEVEL_INFO = 1,
+    LOG_LEVEL_WARN = 2,
+    LOG_LEVEL_ERROR = 3
+};
+
+// 빌드 때 정하는 최소 레벨 (0=DEBUG, 1=INFO, 2=WARN, 3=ERROR, 4=모두 끔).
+// 이보다 낮은 WEBLOG_* 호출은 인자 계산까지 통째로 빠진다. -D TIME_TAPE_LOG_LEVEL=2 처럼 숫자로 준다.
+#ifndef TIME_TAPE_LOG_LEVEL
+#define TIME_TAPE_LOG_LEVEL 1
+#endif
+
+// 호출 측은 lock-free 링 버퍼의 슬롯 하나에 포맷 문자열 주소와 인자 원값(LogRecord.h)만 적고 반환한다.
+// 글자로 만드는 일과 Serial/WebSocket 출력은 webLogBegin()이 띄우는 드레인 태스크가 묶어서 처리한다.
+//   WEBLOG_INFO("[Sync] Locked to leader (offset %ld ms)", (long)best);
+// 포맷은 문자열 리터럴이어야 하고 (주소가 ID다), printf와 같은 -Wformat 검사를 받는다.
+#define WEBLOG_DEBUG(...) WEBLOG_AT_LEVEL_0(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define WEBLOG_INFO(...) WEBLOG_AT_LEVEL_1(LOG_LEVEL_INFO, __VA_ARGS__)
+#define WEBLOG_WARN(...) WEBLOG_AT_LEVEL_2(LOG_LEVEL_WARN, __VA_ARGS__)
+#define WEBLOG_ERROR(...) WEBLOG_AT_LEVEL_3(LOG_LEVEL_ERROR, __VA_ARGS__)
+
+#define WEBLOG_RECORD(level, ...)                        \
+    do                                                   \
+    {                                                    \
+        if (false)                                       \
+            webLogCheckFormat("" __VA_ARGS__);           \
+        webLogRecord(level, "" __VA_ARGS__);             \
+    } while (0)
+#define WEBLOG_ELIDED(level, ...)                        \
+    do                                                   \
+    {                                                    \
+        if (false)                                       \
+            webLogCheckFormat("" __VA_ARGS__);           \
+    } while (0)
+
+#if TIME_TAPE_LOG_LEVEL <= 0
+#define WEBLOG_AT_LEVEL_0 WEBLOG_RECORD
+#else
+#define WEBLOG_AT_LEVEL_0 WEBLOG_ELIDED
+#endif
+#if TIME_TAPE_LOG_LEVEL <= 1
+#define WEBLOG_AT_LEVEL_1 WEBLOG_RECORD
+#else
+#define WEBLOG_AT_LEVEL_1 WEBLOG_ELIDED
+#endif
+#if TIME_TAPE_LOG_LEVEL <= 2
+#define WEBLOG_AT_LEVEL_2 WEBLOG_RECORD
+#else
+#define WEBLOG_AT_LEVEL_2 WEBLOG_ELIDED
+#endif
+#if TIME_TAPE_LOG_LEVEL <= 3
+#define WEBLOG_AT_LEVEL_3 WEBLOG_RECORD
+#else
+#define WEBLOG_AT_LEVEL_3 WEBLOG_ELIDED
+#endif
+
+void webLogBegin();
+void webLogSetMinLevel(LogLevel level); // 빌드 레벨 위에서 런타임으로 더 거른다
+void webLogRequestReplay(uint32_t clientId); // 새 /ws/log 클라이언트에 최근 기록 재전송
+uint32_t webLogDroppedCount();
+
+// ---- 매크로 뒷단 (직접 부르지 않는다) ----
+
+// 레벨이 꺼져 있거나 링이 가득 차면 nullptr. 받은 슬롯은 반드시 webLogCommit으로 돌려준다.
+LogRecord *webLogReserve(LogLevel level, uint32_t &ticket);
+void webLogCommit(LogRecord *record, uint32_t ticket);
+
+template <typename... Args>
+inline void webLogRecord(LogLevel level, const char *format, const Args &...args)
+{
+    uint32_t ticket;
+    LogRecord *record = webLogReserve(level, ticket);
+    if (record == nullptr)
+        return;
+    record->format = format;
+    record->level = level;
+    LogArgWriter writer(*record);
+    (writer.put(args), ...);
+    webLogCommit(record, ticket);
+}
+
+inline void webLogCheckFormat(const char *, ...) __attribute__((format(printf, 1, 2)));
+inline void webLogCheckFormat(const char *, ...) {}
@@ -0,0 +1,25 @@
+#pragma once
+#include <Arduino.h>
+
+// WiFi 연결 관리.
+//
+// 마지막으로 붙었던 AP의 BSSID/채널과 IP 임대 정보를 RTC 메모리(소프트 리셋)와 NVS(전원 재인가)에
+// 남겨 두고, 부팅 때 스캔 없이 그 AP로 바로 붙는다. 소프트 리셋 직후에는 DHCP도 건너뛰고 지난 임대를
+// 그대로 쓰며, 붙고 나면 wifiLinkLoop()가 DHCP로 되돌려 임대를 새로 받는다.
+// 안 되면 평소 연결(스캔) → WiFiManager 설정 포털 순서로 내려간다.
+// 연결된 뒤에는 wifiLinkLoop()가 끊김을 감시하고, 렌더링을 막지 않은 채 지터를 섞은 지수 백오프로
+// 다시 붙는다 (코어의 자동 재연결은 끈다).
+struct WifiLinkStats
+{
+    bool connected;
+    uint32_t connects;       // IP를 받은 횟수 (첫 연결 포함)
+    uint32_t cachedConnects; // 그중 캐시(BSSID/채널)로 스캔 없이 붙은 횟수
+    uint32_t lastConnectMs;  // 마지막 연결 시도 시작 → IP까지
+    uint32_t outages;        // 연결된 뒤 끊긴 횟수
+    uint32_t outageMsTotal;  // 끊겨 있던 누적 시간 (지금 끊겨 있으면 그 시간 포함)
+};
+
+bool wifiLinkConnect(); // 부팅 때 한 번 (블로킹: 포털이면 최대 180초). 저장된 AP가 있으면 실패해도 loop가 계속 시도한다.
+void wifiLinkLoop();    // loop마다 (막지 않는다)
+bool wifiLinkConnected();
+void wifiLinkGetStats(WifiLinkStats &out);
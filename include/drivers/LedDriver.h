@@ -1,23 +1,41 @@
 #pragma once
-#include <Adafruit_NeoPixel.h>
+#include "hal/PixelStrip.h"
+#include "Topology.h"
 
+// 두 링을 논리 순서(안쪽 링 다음 바깥쪽 링, 각 링 0번 = 12시)로 다룬다.
+// 물리 스트립 위치는 begin()에 넘긴 배치(Topology)가 정한다.
 class LedDriver {
 public:
-    LedDriver(uint16_t innerCount, int16_t innerPin, uint16_t outerCount, int16_t outerPin, neoPixelType type);
-    void begin();
+    void begin(const Topology& topology);
     void show();
     void clear();
     void setBrightness(uint8_t brightness);
-    
-    // 이 메서드들은 내부적으로 어느 스트립인지 판단해서 호출하거나 통합 제어합니다.
+
+    // 한 프레임 전체 (pixels[numPixels()]). 알려진 배치는 그 배치용으로 컴파일된 커널이,
+    // 나머지는 begin()에서 만든 경로표를 도는 커널이 옮긴다.
+    void writeFrame(const uint32_t* pixels);
+
+    // 픽셀 하나 (경로표로 옮긴다)
     void setPixelColor(uint16_t n, uint32_t c); 
+    uint32_t getPixelColor(uint16_t n) const;
+    uint16_t numPixels() const { return _pixels; }
+    uint8_t getBrightness() const { return _strips[0].getBrightness(); }
+    bool fixedKernel() const { return _kernel != &LedDriver::writeRuntime; }
     
     uint32_t Color(uint8_t r, uint8_t g, uint8_t b);
     uint32_t ColorHSV(uint16_t hue, uint8_t sat, uint8_t val);
 
 private:
-    Adafruit_NeoPixel _inner;
-    Adafruit_NeoPixel _outer;
-    uint16_t _innerCount;
-    uint16_t _outerCount;
-};
\ No newline at end of file
+    typedef void (*FrameKernel)(LedDriver& self, const uint32_t* pixels);
+
+    hal::PixelStrip _strips[kMaxStrips];
+    uint8_t _stripCount = 0;
+    uint16_t _pixels = 0;
+    PixelRoute _routes[kMaxPixels] = {};
+    FrameKernel _kernel = &LedDriver::writeRuntime;
+
+    template <const Topology& T>
+    static void writeFixed(LedDriver& self, const uint32_t* pixels);
+    static void writeRuntime(LedDriver& self, const uint32_t* pixels);
+    static FrameKernel kernelFor(const Topology& topology);
+};
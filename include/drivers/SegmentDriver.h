@@ -1,21 +1,40 @@
 #pragma once
 #include <Arduino.h>
+#include <atomic>
+#include "hal/Hal.h"
 
+// 74HC595 3자리 7세그먼트. 출력 인에이블(OE)이 배선돼 있지 않아서 밝기는 타이머 인터럽트가
+// 정해진 비율만큼 빈 프레임을 래치하는 식으로 낸다 (kPwmTickHz / kPwmSteps = 1kHz PWM).
+// 인터럽트는 틱마다 래치가 바뀔 때만 시프트하므로 PWM 주기마다 최대 두 번 래치한다.
 class SegmentDriver {
 public:
+    static constexpr uint8_t kPwmSteps = 16;
+    static constexpr uint32_t kPwmTickHz = 16000;
+
     SegmentDriver(int sclkPin, int loadPin, int sdiPin);
     void begin();
-    void drawNumber(int num, int dpPos, bool isOff);
+    void drawSegments(const uint8_t lit[3]); // SegmentFont 비트 (활성 high)
     void drawRaw(byte h, byte t, byte o); // 세그먼트 직접 제어 추가
+    void setBrightness(uint8_t brightness); // 0~255, 링과 같은 값. 타이머가 없으면(호스트) 항상 최대
     void test();
-
-    const byte digitPatterns[10] = {
-        0b11000000, 0b11111001, 0b10100100, 0b10110000, 0b10011001,
-        0b10010010, 0b10000010, 0b11111000, 0b10000000, 0b10010000
-    };
+    const byte* raw() const { return _raw; } // 마지막으로 그린 h/t/o 바이트 (PWM 전)
 
 private:
     int _sclkPin;
     int _loadPin;
     int _sdiPin;
+    byte _raw[3] = {0xFF, 0xFF, 0xFF};
+    bool _pwm = false;
+
+    // 그리는 쪽 -> 인터럽트. 패턴은 h<<16 | t<<8 | o (공통 애노드 그대로)
+    std::atomic<uint32_t> _pattern{0xFFFFFF};
+    std::atomic<uint8_t> _duty{kPwmSteps};
+
+    // 인터럽트 전용
+    uint8_t _phase = 0;
+    uint32_t _latched = 0xFFFFFF;
+
+    void latch(byte h, byte t, byte o);
+    void shift(uint32_t pattern);
+    static void onTick(void *self);
 };
@@ -0,0 +1,133 @@
+#pragma once
+#include "graphics/IEffect.h"
+#include "graphics/ColorUtils.h"
+
+// Time-animated ring effects (colorMode 4-7), driven by the frame timestamp.
+//
+// All math is integer per LED with a fixed amount of work (no loops over other LEDs), so the
+// cost of a ring is count x constant. State that outlives a frame lives in fixed arrays
+// indexed by the absolute LED index, because one instance serves both rings. Nothing allocates.
+
+// Fill geometry shared by the effects: the progress edge in 1/256 pixel and per-pixel coverage.
+struct FillEdge {
+    uint32_t edge;
+
+    FillEdge(float progress, int count) {
+        if (progress < 0.0f)
+            progress = 0.0f;
+        if (progress > 1.0f)
+            progress = 1.0f;
+        edge = (uint32_t)(progress * count * 256.0f);
+    }
+
+    // 0 (empty) .. 256 (filled); the edge pixel is anti-aliased.
+    uint32_t cover(int i) const {
+        const uint32_t start = (uint32_t)i * 256;
+        if (edge <= start)
+            return 0;
+        return min<uint32_t>(edge - start, 256);
+    }
+};
+
+// Smooth 0..256 pulse over periodMs (triangle through smoothstep).
+inline uint32_t pulse256(uint32_t timeMs, uint32_t periodMs) {
+    const uint32_t phase = (uint32_t)((uint64_t)(timeMs % periodMs) * 512 / periodMs);
+    const uint32_t tri = phase < 256 ? phase : 511 - phase; // 0..255
+    const uint32_t smooth = (tri * tri * (768 - 2 * tri)) >> 16;
+    return smooth + (smooth >> 7);
+}
+
+// Mode 4: Breathing (the empty region slowly glows between cEmpty and c2)
+class BreathingEffect : public IEffect {
+public:
+    static constexpr uint32_t kPeriodMs = 4000;
+
+    void render(Layer& layer, int startIdx, int count, float progress, uint32_t c1, uint32_t c2, uint32_t cEmpty, uint32_t timeMs) override {
+        const FillEdge fill(progress, count);
+        const uint32_t empty = ColorUtils::mix(cEmpty, c2, pulse256(timeMs, kPeriodMs));
+        for (int i = 0; i < count; i++) {
+            layer.setPixelColor(startIdx + i, ColorUtils::mix(empty, c1, fill.cover(i)));
+        }
+    }
+};
+
+// Mode 5: Comet (a pulsing c2 head sits on the progress edge and trails back into c1)
+class CometEffect : public IEffect {
+public:
+    static constexpr int32_t kTail = 5; // pixels
+    static constexpr uint32_t kPulseMs = 1200;
+
+    void render(Layer& layer, int startIdx, int count, float progress, uint32_t c1, uint32_t c2, uint32_t cEmpty, uint32_t timeMs) override {
+        const FillEdge fill(progress, count);
+        // head never dims below ~60% so the edge stays readable
+        const uint32_t head = ColorUtils::mix(c1, c2, 154 + ((pulse256(timeMs, kPulseMs) * 102) >> 8));
+        for (int i = 0; i < count; i++) {
+            const uint32_t cover = fill.cover(i);
+            uint32_t col = c1;
+            // distance of the pixel centre behind the edge, in 1/256 pixel
+            const int32_t behind = (int32_t)fill.edge - (i * 256 + 128);
+            if (cover > 0 && behind < kTail * 256)
+                col = ColorUtils::mix(c1, head, behind <= 0 ? 256 : 256 - behind / kTail);
+            layer.setPixelColor(startIdx + i, ColorUtils::mix(cEmpty, col, cover));
+        }
+    }
+};
+
+// Mode 6: Sparkle (random filled pixels flash towards c2 and fade back to c1)
+class SparkleEffect : public IEffect {
+public:
+    static constexpr uint32_t kTwinkleMs = 700; // one flash
+    static constexpr uint32_t kDensity = 6;     // about one pixel in kDensity flashes per window
+
+    SparkleEffect() {
+        // per-LED phase so flashes do not start in lockstep
+        uint32_t seed = 0x2545F491;
+        for (uint16_t n = 0; n < Layer::kPixels; n++) {
+            seed = seed * 1664525u + 1013904223u;
+            _phase[n] = (uint16_t)((seed >> 16) % kTwinkleMs);
+        }
+    }
+
+    void render(Layer& layer, int startIdx, int count, float progress, uint32_t c1, uint32_t c2, uint32_t cEmpty, uint32_t timeMs) override {
+        const FillEdge fill(progress, count);
+        for (int i = 0; i < count; i++) {
+            const uint16_t n = (uint16_t)(startIdx + i);
+            const uint32_t t = timeMs + (n < Layer::kPixels ? _phase[n] : 0);
+            const uint32_t window = t / kTwinkleMs;
+
+            uint32_t col = c1;
+            if (hash(n, window) % kDensity == 0)
+                col = ColorUtils::mix(c1, c2, pulse256(t % kTwinkleMs, kTwinkleMs));
+            layer.setPixelColor(n, ColorUtils::mix(cEmpty, col, fill.cover(i)));
+        }
+    }
+
+private:
+    uint16_t _phase[Layer::kPixels];
+
+    static uint32_t hash(uint32_t n, uint32_t window) {
+        uint32_t x = n * 0x9E3779B1u ^ window * 0x85EBCA6Bu;
+        x ^= x >> 16;
+        x *= 0x7FEB352Du;
+        x ^= x >> 15;
+        return x;
+    }
+};
+
+// Mode 7: Rotating Rainbow (the rainbow of mode 1 turns once every kPeriodMs)
+class RotatingRainbowEffect : public IEffect {
+public:
+    static constexpr uint32_t kPeriodMs = 6000;
+
+    void render(Layer& layer, int startIdx, int count, float progress, uint32_t c1, uint32_t c2, uint32_t cEmpty, uint32_t timeMs) override {
+        const FillEdge fill(progress, count);
+        const uint16_t offset = (uint16_t)((uint64_t)(timeMs % kPeriodMs) * 65536 / kPeriodMs);
+        for (int i = 0; i < count; i++) {
+            const uint32_t cover = fill.cover(i);
+            uint32_t col = cEmpty;
+            if (cover > 0)
+                col = ColorUtils::mix(cEmpty, layer.ColorHSV((uint16_t)(i * 65536L / count + offset), 255, 255), cover);
+            layer.setPixelColor(startIdx + i, col);
+        }
+    }
+};
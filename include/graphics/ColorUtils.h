@@ -20,4 +20,12 @@ public:
                ((uint32_t)(g1 + (g2 - g1) * r) << 8) |
                (uint32_t)(b1 + (b2 - b1) * r);
     }
+
+    // Integer version of blend for per-frame kernels: w is the weight of c2 in 0..256.
+    // Red and blue share one multiply (each lane stays below 0x10000), green takes the other.
+    static uint32_t mix(uint32_t c1, uint32_t c2, uint32_t w) {
+        const uint32_t rb = (((c2 & 0xFF00FF) * w + (c1 & 0xFF00FF) * (256 - w)) >> 8) & 0xFF00FF;
+        const uint32_t g = (((c2 & 0x00FF00) * w + (c1 & 0x00FF00) * (256 - w)) >> 8) & 0x00FF00;
+        return rb | g;
+    }
 };
@@ -0,0 +1,157 @@
+#pragma once
+#include <Arduino.h>
+#include <string.h>
+#include "Topology.h"
+#include "hal/PixelStrip.h"
+#include "graphics/ColorUtils.h"
+
+// Layered frame composition for the two rings and the 7-segment cells.
+//
+// Layers stack bottom (LAYER_BASE) to top (LAYER_SYSTEM). Every pixel carries its own alpha
+// (0 = transparent), which is scaled by the layer opacity and blended over the layers below;
+// whatever is left uncovered is black. Segment cells cannot be blended, so the topmost layer
+// that set them and is at least half opaque wins.
+// A visible layer may expire at a given time and fade out over its last fadeMs.
+enum LayerId : uint8_t {
+    LAYER_BASE = 0,   // current preset: ring progress and mode value
+    LAYER_TRANSITION, // frozen frame of the outgoing preset while a transition runs
+    LAYER_OVERLAY,    // transient text: preset number, counter value, IP address
+    LAYER_SYSTEM,     // boot animation
+    LAYER_COUNT
+};
+
+class Layer {
+public:
+    static constexpr uint16_t kPixels = kMaxPixels; // logical order: inner ring, then outer ring
+
+    // Fully transparent, no segments.
+    void clear() {
+        memset(_alpha, 0, sizeof(_alpha));
+        _hasSegments = false;
+    }
+
+    // Same signature as LedDriver so effects can draw into a layer.
+    void setPixelColor(uint16_t n, uint32_t c) { setPixel(n, c, 255); }
+
+    void setPixel(uint16_t n, uint32_t c, uint8_t alpha) {
+        if (n >= kPixels)
+            return;
+        _rgb[n] = c & 0xFFFFFF;
+        _alpha[n] = alpha;
+    }
+
+    uint32_t getPixelColor(uint16_t n) const { return (n < kPixels) ? _rgb[n] : 0; }
+    uint8_t alpha(uint16_t n) const { return (n < kPixels) ? _alpha[n] : 0; }
+
+    void setSegments(const uint8_t lit[3]) {
+        memcpy(_segments, lit, sizeof(_segments));
+        _hasSegments = true;
+    }
+    void clearSegments() { _hasSegments = false; }
+    bool hasSegments() const { return _hasSegments; }
+    const uint8_t *segments() const { return _segments; }
+
+    static uint32_t ColorHSV(uint16_t hue, uint8_t sat = 255, uint8_t val = 255) {
+        return hal::PixelStrip::ColorHSV(hue, sat, val);
+    }
+
+private:
+    uint32_t _rgb[kPixels] = {};
+    uint8_t _alpha[kPixels] = {};
+    uint8_t _segments[3] = {};
+    bool _hasSegments = false;
+};
+
+class Compositor {
+public:
+    Layer &layer(LayerId id) { return _slots[id].layer; }
+
+    // durationMs 0 keeps the layer until hide()/expire(). Otherwise the last fadeMs of the
+    // duration ramp the opacity down to 0.
+    void show(LayerId id, uint32_t nowMs, uint32_t durationMs = 0, uint32_t fadeMs = 0, uint8_t opacity = 255) {
+        Slot &s = _slots[id];
+        s.visible = true;
+        s.opacity = opacity;
+        s.expires = durationMs > 0;
+        s.expiresAtMs = nowMs + durationMs;
+        s.fadeMs = min(fadeMs, durationMs);
+    }
+
+    void hide(LayerId id) { _slots[id].visible = false; }
+
+    // Starts fading a visible layer out now; it is hidden once the fade ends.
+    void expire(LayerId id, uint32_t nowMs, uint32_t fadeMs) {
+        Slot &s = _slots[id];
+        if (!s.visible)
+            return;
+        if (fadeMs == 0) {
+            s.visible = false;
+            return;
+        }
+        s.expires = true;
+        s.expiresAtMs = nowMs + fadeMs;
+        s.fadeMs = fadeMs;
+    }
+
+    bool visible(LayerId id) const { return _slots[id].visible; }
+
+    // Blends the first count pixels of the visible layers into pixels[count] and picks the
+    // segment cells (blank if no layer set any). Layers whose time is up are hidden here.
+    void compose(uint32_t nowMs, uint32_t *pixels, uint8_t segments[3], uint16_t count = Layer::kPixels) {
+        count = min(count, Layer::kPixels);
+        memset(pixels, 0, sizeof(uint32_t) * count);
+        memset(segments, 0, 3);
+
+        for (uint8_t id = 0; id < LAYER_COUNT; id++) {
+            const uint8_t opacity = effectiveOpacity(_slots[id], nowMs);
+            if (opacity == 0)
+                continue;
+
+            const Layer &l = _slots[id].layer;
+            const uint32_t scale = weight(opacity);
+            for (uint16_t n = 0; n < count; n++) {
+                const uint8_t a = (uint8_t)((l.alpha(n) * scale) >> 8);
+                if (a == 255)
+                    pixels[n] = l.getPixelColor(n);
+                else if (a > 0)
+                    pixels[n] = blend(pixels[n], l.getPixelColor(n), a);
+            }
+            if (l.hasSegments() && opacity >= 128)
+                memcpy(segments, l.segments(), 3);
+        }
+    }
+
+    // Maps 0..255 to 0..256 so that 255 is exact under ">> 8".
+    static uint32_t weight(uint8_t a) { return a + (a >> 7); }
+
+    // Integer mix of two 0xRRGGBB colors, a = weight of src (0..255); no divisions.
+    static uint32_t blend(uint32_t dst, uint32_t src, uint8_t a) { return ColorUtils::mix(dst, src, weight(a)); }
+
+private:
+    struct Slot {
+        Layer layer;
+        bool visible = false;
+        bool expires = false;
+        uint8_t opacity = 255;
+        uint32_t expiresAtMs = 0;
+        uint32_t fadeMs = 0;
+    };
+
+    uint8_t effectiveOpacity(Slot &s, uint32_t nowMs) {
+        if (!s.visible)
+            return 0;
+        if (!s.expires)
+            return s.opacity;
+
+        const int32_t remaining = (int32_t)(s.expiresAtMs - nowMs); // wrap-safe
+        if (remaining <= 0) {
+            s.visible = false;
+            return 0;
+        }
+        if ((uint32_t)remaining >= s.fadeMs)
+            return s.opacity;
+        return (uint8_t)((uint64_t)s.opacity * (uint32_t)remaining / s.fadeMs);
+    }
+
+    Slot _slots[LAYER_COUNT];
+};
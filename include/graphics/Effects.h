@@ -5,7 +5,7 @@
 // Mode 0: Solid Fill
 class SolidEffect : public IEffect {
 public:
-    void render(LedDriver& leds, int startIdx, int count, float progress, uint32_t c1, uint32_t c2, uint32_t cEmpty) override {
+    void render(Layer& layer, int startIdx, int count, float progress, uint32_t c1, uint32_t c2, uint32_t cEmpty, uint32_t) override {
         float currentPos = progress * count;
         
         for (int i = 0; i < count; i++) {
@@ -18,7 +18,7 @@ public:
                 // Anti-aliasing for the edge
                 col = ColorUtils::blend(cEmpty, c1, currentPos - i);
             }
-            leds.setPixelColor(idx, col);
+            layer.setPixelColor(idx, col);
         }
     }
 };
@@ -26,21 +26,21 @@ public:
 // Mode 1: Rainbow
 class RainbowEffect : public IEffect {
 public:
-    void render(LedDriver& leds, int startIdx, int count, float progress, uint32_t c1, uint32_t c2, uint32_t cEmpty) override {
+    void render(Layer& layer, int startIdx, int count, float progress, uint32_t c1, uint32_t c2, uint32_t cEmpty, uint32_t) override {
         float currentPos = progress * count;
 
         for (int i = 0; i < count; i++) {
             int idx = startIdx + i;
             uint32_t col = cEmpty;
             // Map position to Hue (0-65535)
-            uint32_t targetColor = leds.ColorHSV(i * 65536L / count, 255, 255);
+            uint32_t targetColor = layer.ColorHSV(i * 65536L / count, 255, 255);
 
             if (currentPos >= i + 1) {
                 col = targetColor;
             } else if (currentPos > i) {
                 col = ColorUtils::blend(cEmpty, targetColor, currentPos - i);
             }
-            leds.setPixelColor(idx, col);
+            layer.setPixelColor(idx, col);
         }
     }
 };
@@ -48,7 +48,7 @@ public:
 // Mode 2: Time Gradient (Whole ring changes color over time/progress)
 class TimeGradientEffect : public IEffect {
 public:
-    void render(LedDriver& leds, int startIdx, int count, float progress, uint32_t c1, uint32_t c2, uint32_t cEmpty) override {
+    void render(Layer& layer, int startIdx, int count, float progress, uint32_t c1, uint32_t c2, uint32_t cEmpty, uint32_t) override {
         float currentPos = progress * count;
         uint32_t solidColor = ColorUtils::blend(c1, c2, progress);
 
@@ -61,7 +61,7 @@ public:
             } else if (currentPos > i) {
                 col = ColorUtils::blend(cEmpty, solidColor, currentPos - i);
             }
-            leds.setPixelColor(idx, col);
+            layer.setPixelColor(idx, col);
         }
     }
 };
@@ -69,7 +69,7 @@ public:
 // Mode 3: Space Gradient (Start is c1, End is c2)
 class SpaceGradientEffect : public IEffect {
 public:
-    void render(LedDriver& leds, int startIdx, int count, float progress, uint32_t c1, uint32_t c2, uint32_t cEmpty) override {
+    void render(Layer& layer, int startIdx, int count, float progress, uint32_t c1, uint32_t c2, uint32_t cEmpty, uint32_t) override {
         float currentPos = progress * count;
 
         for (int i = 0; i < count; i++) {
@@ -84,7 +84,7 @@ public:
             } else if (currentPos > i) {
                 col = ColorUtils::blend(cEmpty, targetColor, currentPos - i);
             }
-            leds.setPixelColor(idx, col);
+            layer.setPixelColor(idx, col);
         }
     }
 };
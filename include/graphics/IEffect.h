@@ -1,5 +1,5 @@
 #pragma once
-#include "drivers/LedDriver.h"
+#include "graphics/Compositor.h"
 
 class IEffect {
 public:
@@ -7,6 +7,7 @@ public:
     
     // Updates the effect state. 
     // progress: 0.0 to 1.0 (how much the ring is filled)
-    // startIdx, count: range of LEDs to affect
-    virtual void render(LedDriver& leds, int startIdx, int count, float progress, uint32_t c1, uint32_t c2, uint32_t cEmpty) = 0;
+    // startIdx, count: range of LEDs to affect (every pixel in the range is written opaque)
+    // timeMs: frame timestamp on the shared render clock (syncMillis), for animated effects
+    virtual void render(Layer& layer, int startIdx, int count, float progress, uint32_t c1, uint32_t c2, uint32_t cEmpty, uint32_t timeMs) = 0;
 };
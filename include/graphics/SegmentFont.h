@@ -0,0 +1,42 @@
+#pragma once
+#include <Arduino.h>
+
+// 7-segment font, active-high (bit set = segment lit):
+//
+//    aaa
+//   f   b
+//    ggg        bit0=a ... bit6=g, bit7=dp
+//   e   c
+//    ddd  .
+//
+// The display is common-anode, so SegmentDriver inverts these before latching.
+// Characters that have no readable 7-segment shape map to a blank cell.
+class SegmentFont {
+public:
+    static constexpr uint8_t DP = 0x80;
+
+    static constexpr uint8_t glyph(char c) {
+        return (c >= 0x20 && c < 0x7F) ? kGlyphs[c - 0x20] : 0;
+    }
+
+    // '.', ',' and ':' light the decimal point of the previous cell instead of taking a cell.
+    static constexpr bool attachesToPrevious(char c) {
+        return c == '.' || c == ',' || c == ':';
+    }
+
+private:
+    static constexpr uint8_t kGlyphs[96] = {
+        // ' '   !     "     #     $     %     &     '     (     )     *     +     ,     -     .     /
+        0x00, 0x86, 0x22, 0x00, 0x00, 0x00, 0x00, 0x02, 0x39, 0x0F, 0x00, 0x00, 0x80, 0x40, 0x80, 0x52,
+        // 0     1     2     3     4     5     6     7     8     9     :     ;     <     =     >     ?
+        0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F, 0x80, 0x00, 0x00, 0x48, 0x00, 0x53,
+        // @     A     B     C     D     E     F     G     H     I     J     K     L     M     N     O
+        0x00, 0x77, 0x7C, 0x39, 0x5E, 0x79, 0x71, 0x3D, 0x76, 0x06, 0x1E, 0x75, 0x38, 0x15, 0x37, 0x3F,
+        // P     Q     R     S     T     U     V     W     X     Y     Z     [     \     ]     ^     _
+        0x73, 0x6B, 0x33, 0x6D, 0x78, 0x3E, 0x3E, 0x2A, 0x76, 0x6E, 0x5B, 0x39, 0x64, 0x0F, 0x23, 0x08,
+        // `     a     b     c     d     e     f     g     h     i     j     k     l     m     n     o
+        0x20, 0x5F, 0x7C, 0x58, 0x5E, 0x7B, 0x71, 0x6F, 0x74, 0x10, 0x0C, 0x75, 0x30, 0x14, 0x54, 0x5C,
+        // p     q     r     s     t     u     v     w     x     y     z     {     |     }     ~   DEL
+        0x73, 0x67, 0x50, 0x6D, 0x78, 0x1C, 0x1C, 0x14, 0x76, 0x6E, 0x5B, 0x39, 0x30, 0x0F, 0x01, 0x00,
+    };
+};
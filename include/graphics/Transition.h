@@ -0,0 +1,89 @@
+#pragma once
+#include <Arduino.h>
+#include "graphics/Compositor.h"
+
+enum TransitionStyle : uint8_t {
+    TRANSITION_CUT = 0,
+    TRANSITION_FADE,
+    TRANSITION_WIPE
+};
+
+// Preset-change transition between two off-screen buffers: the outgoing frame is frozen into
+// LAYER_TRANSITION once, and the incoming preset keeps rendering live into LAYER_BASE below it.
+//   fade: the frozen layer's opacity ramps to 0 (the compositor does the per-pixel work).
+//   wipe: a soft edge sweeps each ring from its first pixel; per-pixel alpha comes from a
+//         position table computed once.
+class Transition {
+public:
+    static constexpr uint32_t kWipeEdge = 64; // soft edge width, 1/256 of a ring
+
+    Transition() { setTopology(kBuildTopology); }
+
+    // Ring sizes come from the topology picked at boot.
+    void setTopology(const Topology &t) {
+        memset(_position, 0, sizeof(_position));
+        _pixels = t.pixels();
+        for (uint8_t ring = 0; ring < RING_COUNT; ring++) {
+            for (uint16_t i = 0; i < t.count(ring); i++)
+                _position[t.offset(ring) + i] = (uint8_t)((i * 256 + 128) / t.count(ring));
+        }
+    }
+
+    // Call before the incoming preset is drawn into LAYER_BASE.
+    void begin(Compositor &c, uint8_t style, uint32_t durationMs, uint32_t nowMs) {
+        if (style == TRANSITION_CUT || durationMs == 0) {
+            cancel(c);
+            return;
+        }
+        Layer &frozen = c.layer(LAYER_TRANSITION);
+        frozen = c.layer(LAYER_BASE);
+        frozen.clearSegments(); // the digits switch at once
+        for (uint16_t n = 0; n < _pixels; n++)
+            _sourceAlpha[n] = frozen.alpha(n);
+
+        _style = style;
+        _startMs = nowMs;
+        _durationMs = durationMs;
+        _active = true;
+        c.show(LAYER_TRANSITION, nowMs, durationMs, style == TRANSITION_FADE ? durationMs : 0);
+    }
+
+    void cancel(Compositor &c) {
+        c.hide(LAYER_TRANSITION);
+        _active = false;
+    }
+
+    // Per-frame update; false once the transition is over.
+    bool step(Compositor &c, uint32_t nowMs) {
+        if (!_active)
+            return false;
+        const uint32_t elapsed = nowMs - _startMs;
+        if (elapsed >= _durationMs || !c.visible(LAYER_TRANSITION)) {
+            cancel(c);
+            return false;
+        }
+
+        if (_style == TRANSITION_WIPE) {
+            // front runs 0 .. 256 + edge so both ends are fully covered
+            const uint32_t front = (uint32_t)((uint64_t)elapsed * (256 + kWipeEdge) / _durationMs);
+            Layer &frozen = c.layer(LAYER_TRANSITION);
+            for (uint16_t n = 0; n < _pixels; n++) {
+                const int32_t ahead = (int32_t)(_position[n] + kWipeEdge) - (int32_t)front;
+                const uint32_t cover = ahead <= 0 ? 0 : min<uint32_t>(255, (uint32_t)ahead * 255 / kWipeEdge);
+                frozen.setPixel(n, frozen.getPixelColor(n), (uint8_t)((_sourceAlpha[n] * Compositor::weight(cover)) >> 8));
+            }
+        }
+        return true;
+    }
+
+    bool active() const { return _active; }
+
+private:
+    uint8_t _position[Layer::kPixels];    // pixel position along its ring, 0..255
+    uint8_t _sourceAlpha[Layer::kPixels]; // alpha of the frozen frame before the wipe
+    uint16_t _pixels = 0;
+    uint8_t _style = TRANSITION_CUT;
+    uint32_t _startMs = 0;
+    uint32_t _durationMs = 0;
+    bool _active = false;
+};
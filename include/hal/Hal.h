@@ -0,0 +1,62 @@
+#pragma once
+#include <Arduino.h>
+#include <time.h>
+
+// 보드 의존부를 모은 얇은 HAL.
+// 펌웨어(env:esp32-c3-supermini)는 src/hal/HalEsp32.cpp, 호스트 빌드(env:native)는 src/hal/HalNative.cpp가 구현한다.
+// 로그는 WebLogger.h 인터페이스를 그대로 쓴다 (호스트에서는 표준 출력).
+namespace hal
+{
+// ---- 시계 ----
+uint32_t nowMs();      // millis()
+uint32_t nowUs();      // micros()
+uint64_t uptimeMs();   // 롤오버 없는 64비트 ms
+void sleepMs(uint32_t ms);
+time_t wallTime();     // 벽시계 (NTP 전에는 1970년 근처, 소프트 리셋 뒤에는 RTC에 남은 시각)
+bool localTime(struct tm *out); // 시각이 아직 없으면 기다리지 않고 false
+void timeZoneBegin(long gmtOffsetSec);  // 고정 오프셋 TZ만 건다 (네트워크 없이 부팅 맨 앞에서)
+void wallClockBegin(long gmtOffsetSec); // TZ + NTP 동기화 시작 (WiFi 연결 뒤, 기다리지 않는다)
+void setWallClock(time_t epoch);        // NTP 없이 다른 장치가 알려 준 시각을 그대로 쓴다
+
+// ---- GPIO ----
+// writePin/shiftOutMsb는 ISR에서도 부를 수 있다 (기기에서는 IRAM의 레지스터 쓰기).
+void pinOutput(uint8_t pin);
+void pinInputPullup(uint8_t pin);
+void writePin(uint8_t pin, bool high);
+bool readPin(uint8_t pin);
+void shiftOutMsb(uint8_t dataPin, uint8_t clockPin, uint8_t value);
+
+// ---- 주기 인터럽트 ----
+// 하드웨어 타이머 하나로 fn을 hz마다 부른다. fn은 ISR 문맥이다: IRAM_ATTR, 할당/로그/블로킹 금지.
+// 호스트 빌드에는 없다(false): 쓰는 쪽은 인터럽트 없이도 동작해야 한다.
+bool startPeriodicIsr(uint32_t hz, void (*fn)(void *), void *arg);
+// 호출 수와 fn 안에서 쓴 시간 누계 (us, 넘치면 0부터 다시)
+void periodicIsrStats(uint32_t &calls, uint32_t &busyUs);
+
+// ---- 태스크 ----
+// fn이 반환하면 태스크도 끝난다.
+bool startTask(void (*fn)(void *), const char *name, uint32_t stackBytes, void *arg);
+
+// ---- UDP 멀티캐스트 ----
+// 소켓은 하나뿐이다 (SyncManager). 기기는 WiFi STA로, 호스트는 루프백(127.0.0.1)에서만 주고받는다.
+bool networkReady(); // 기기: WiFi 연결됨, 호스트: 항상 true
+bool multicastOpen(const uint8_t group[4], uint16_t port);
+void multicastClose();
+bool multicastSend(const void *data, size_t len);
+int multicastReceive(void *out, size_t len); // 기다리지 않고 패킷 하나 (len보다 길면 잘린다). 없으면 -1
+
+// ---- NVS ----
+// 호출마다 네임스페이스를 열고 닫는다. 반환값은 실제로 쓰거나 읽은 바이트 수.
+size_t storageWriteBytes(const char *ns, const char *key, const void *data, size_t len);
+size_t storageWriteString(const char *ns, const char *key, const String &value);
+size_t storageBytesLength(const char *ns, const char *key);
+size_t storageReadBytes(const char *ns, const char *key, void *out, size_t len);
+String storageReadString(const char *ns, const char *key, const char *fallback);
+
+// ---- 힙 ----
+// 할당 추적(AllocTracker)이 malloc 래퍼 안에서 부른다: 여기서는 할당하면 안 된다.
+uintptr_t currentTaskId();        // 지금 태스크 식별자 (스케줄러 시작 전이면 0)
+size_t heapBlockSize(void *ptr);  // malloc이 돌려준 블록의 실제 크기
+uint32_t heapFreeBytes();         // 호스트는 0 (알 수 없음)
+uint32_t heapLargestFreeBlock();  // 호스트는 0
+} // namespace hal
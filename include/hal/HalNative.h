@@ -0,0 +1,26 @@
+#pragma once
+#include "hal/Hal.h"
+#include <vector>
+
+// 호스트 빌드 전용 훅. 테스트/시뮬레이터가 시계와 입력을 직접 움직이고 출력을 들여다본다.
+namespace hal
+{
+namespace native
+{
+// 수동 시계: 이후 uptime은 advanceMs()와 이 스레드의 sleepMs()로만 흐른다.
+// 다른 스레드(부트 애니메이션 등)의 sleepMs는 실제로 자고, 그런 태스크가 살아 있는 동안은 이 스레드도 실제로 잔다.
+void useManualClock(uint64_t startMs);
+void advanceMs(uint64_t ms);
+void setWallTime(time_t epoch); // 이 시각부터 uptime만큼 흐른다 (0이면 호스트 시계)
+
+void setPinLevel(uint8_t pin, bool high); // 입력 핀 레벨 (풀업이라 기본값은 HIGH)
+bool pinLevel(uint8_t pin);               // 출력 핀은 마지막으로 쓴 값
+std::vector<uint8_t> takeShiftedBytes(); // shiftOutMsb로 나간 최근 256바이트 (가져가면 비운다)
+
+void clearStorage();
+
+// FrameStream 대역: 등록하면 DisplayManager::endFrame()이 /ws/frames로 보낼 프레임을 여기로 넘긴다
+typedef void (*FrameSink)(const uint32_t *pixels, uint8_t count, uint8_t brightness, const uint8_t seg[3], void *ctx);
+void setFrameSink(FrameSink sink, void *ctx);
+} // namespace native
+} // namespace hal
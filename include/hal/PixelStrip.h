@@ -0,0 +1,120 @@
+#pragma once
+#include <Arduino.h>
+
+// NeoPixel 출력. 펌웨어에서는 Adafruit_NeoPixel을 그대로 쓰고,
+// 호스트 빌드에서는 같은 API의 메모리 버퍼가 대신한다 (show()마다 프레임 번호만 올린다).
+#ifdef ARDUINO
+#include <Adafruit_NeoPixel.h>
+
+namespace hal
+{
+typedef Adafruit_NeoPixel PixelStrip;
+}
+#else
+#include <vector>
+
+typedef uint16_t neoPixelType;
+constexpr neoPixelType NEO_GRB = 0x52;
+constexpr neoPixelType NEO_KHZ800 = 0x0000;
+
+namespace hal
+{
+class PixelStrip
+{
+public:
+    PixelStrip() : _pin(-1) {}
+    PixelStrip(uint16_t count, int16_t pin, neoPixelType type) : _pin(pin), _pixels(count, 0) {}
+
+    // Adafruit_NeoPixel의 빈 생성자 + 나중 설정과 같은 흐름 (LedDriver가 배치를 읽고 부른다)
+    void updateLength(uint16_t count) { _pixels.assign(count, 0); }
+    void updateType(neoPixelType type) {}
+    void setPin(int16_t pin) { _pin = pin; }
+
+    void begin() {}
+    void show() { _shows++; }
+    void clear() { std::fill(_pixels.begin(), _pixels.end(), 0); }
+    void setBrightness(uint8_t brightness) { _brightness = brightness; }
+    uint8_t getBrightness() const { return _brightness; }
+    uint16_t numPixels() const { return (uint16_t)_pixels.size(); }
+
+    // 펌웨어와 달리 밝기를 곱해 저장하지 않는다 (getPixelColor가 설정값을 그대로 돌려준다)
+    void setPixelColor(uint16_t n, uint32_t c)
+    {
+        if (n < _pixels.size())
+            _pixels[n] = c & 0xFFFFFF;
+    }
+    uint32_t getPixelColor(uint16_t n) const { return (n < _pixels.size()) ? _pixels[n] : 0; }
+
+    int16_t pin() const { return _pin; }
+    uint32_t shows() const { return _shows; }
+
+    static uint32_t Color(uint8_t r, uint8_t g, uint8_t b) { return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b; }
+
+    // Adafruit_NeoPixel::ColorHSV와 같은 계산 (효과 결과가 기기와 같도록)
+    static uint32_t ColorHSV(uint16_t hue, uint8_t sat = 255, uint8_t val = 255)
+    {
+        uint8_t r, g, b;
+        hue = (hue * 1530L + 32768) / 65536;
+        if (hue < 510)
+        {
+            b = 0;
+            if (hue < 255)
+            {
+                r = 255;
+                g = hue;
+            }
+            else
+            {
+                r = 510 - hue;
+                g = 255;
+            }
+        }
+        else if (hue < 1020)
+        {
+            r = 0;
+            if (hue < 765)
+            {
+                g = 255;
+                b = hue - 510;
+            }
+            else
+            {
+                g = 1020 - hue;
+                b = 255;
+            }
+        }
+        else if (hue < 1530)
+        {
+            g = 0;
+            if (hue < 1275)
+            {
+                r = hue - 1020;
+                b = 255;
+            }
+            else
+            {
+                r = 255;
+                b = 1530 - hue;
+            }
+        }
+        else
+        {
+            r = 255;
+            g = b = 0;
+        }
+        const uint32_t v1 = 1 + val;
+        const uint16_t s1 = 1 + sat;
+        const uint8_t s2 = 255 - sat;
+        return ((((((r * s1) >> 8) + s2) * v1) & 0xff00) << 8) |
+               (((((g * s1) >> 8) + s2) * v1) & 0xff00) |
+               (((((b * s1) >> 8) + s2) * v1) >> 8);
+    }
+
+private:
+    int16_t _pin;
+    std::vector<uint32_t> _pixels;
+    uint8_t _brightness = 255;
+    uint32_t _shows = 0;
+};
+} // namespace hal
+#endif
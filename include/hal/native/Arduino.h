@@ -0,0 +1,128 @@
+#pragma once
+// 호스트 빌드(env:native) 전용 Arduino.h. 코어 모듈이 실제로 쓰는 만큼만 흉내 낸다.
+// 보드 API(millis, digitalWrite 등)는 일부러 두지 않는다: 코어 모듈은 hal::을 거쳐야 한다.
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <time.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW 0x0
+#define IRAM_ATTR
+
+using std::max;
+using std::min;
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+class String
+{
+public:
+    String() {}
+    String(const char *s) : _s(s ? s : "") {}
+    String(const std::string &s) : _s(s) {}
+    explicit String(char c) : _s(1, c) {}
+    explicit String(int v) : _s(std::to_string(v)) {}
+    explicit String(unsigned int v) : _s(std::to_string(v)) {}
+    explicit String(long v) : _s(std::to_string(v)) {}
+    explicit String(unsigned long v) : _s(std::to_string(v)) {}
+
+    const char *c_str() const { return _s.c_str(); }
+    unsigned int length() const { return (unsigned int)_s.size(); }
+    bool isEmpty() const { return _s.empty(); }
+    bool reserve(unsigned int size)
+    {
+        _s.reserve(size);
+        return true;
+    }
+
+    bool concat(const char *s)
+    {
+        if (!s)
+            return false;
+        _s += s;
+        return true;
+    }
+    bool concat(const char *s, unsigned int len)
+    {
+        if (!s)
+            return false;
+        _s.append(s, len);
+        return true;
+    }
+    bool concat(char c)
+    {
+        _s += c;
+        return true;
+    }
+    bool concat(const String &s)
+    {
+        _s += s._s;
+        return true;
+    }
+
+    String &operator+=(const char *s)
+    {
+        concat(s);
+        return *this;
+    }
+    String &operator+=(const String &s)
+    {
+        concat(s);
+        return *this;
+    }
+    String &operator+=(char c)
+    {
+        concat(c);
+        return *this;
+    }
+
+    char operator[](unsigned int i) const { return i < _s.size() ? _s[i] : 0; }
+    bool operator==(const String &o) const { return _s == o._s; }
+    bool operator==(const char *o) const { return _s == (o ? o : ""); }
+    bool operator!=(const String &o) const { return _s != o._s; }
+    bool operator!=(const char *o) const { return !(*this == o); }
+    bool operator<(const String &o) const { return _s < o._s; }
+
+    int indexOf(char c, unsigned int from = 0) const
+    {
+        const size_t pos = _s.find(c, from);
+        return pos == std::string::npos ? -1 : (int)pos;
+    }
+    int indexOf(const char *s, unsigned int from = 0) const
+    {
+        const size_t pos = _s.find(s, from);
+        return pos == std::string::npos ? -1 : (int)pos;
+    }
+    String substring(unsigned int from) const { return from < _s.size() ? String(_s.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const
+    {
+        if (from > to)
+            std::swap(from, to);
+        return from < _s.size() ? String(_s.substr(from, to - from)) : String();
+    }
+    bool startsWith(const char *prefix) const { return _s.rfind(prefix, 0) == 0; }
+    long toInt() const { return strtol(_s.c_str(), nullptr, 10); }
+    float toFloat() const { return strtof(_s.c_str(), nullptr); }
+
+    friend String operator+(String lhs, const String &rhs)
+    {
+        lhs += rhs;
+        return lhs;
+    }
+    friend String operator+(String lhs, const char *rhs)
+    {
+        lhs += rhs;
+        return lhs;
+    }
+
+private:
+    std::string _s;
+};
@@ -2,6 +2,7 @@
 #include <Arduino.h>
 #include "Config.h"
 #include "WebLogger.h"
+#include "hal/Hal.h"
 
 struct ButtonState {
     uint8_t pin;
@@ -25,18 +26,18 @@ public:
 
     void begin() {
         for (int i = 0; i < 4; i++) {
-            pinMode(buttons[i].pin, INPUT_PULLUP);
+            hal::pinInputPullup(buttons[i].pin);
         }
     }
 
     void update() {
         for (int i = 0; i < 4; i++) {
-            bool reading = digitalRead(buttons[i].pin);
+            bool reading = hal::readPin(buttons[i].pin);
             if (reading != buttons[i].lastReading) {
-                buttons[i].lastDebounceTime = millis();
+                buttons[i].lastDebounceTime = hal::nowMs();
             }
 
-            if ((millis() - buttons[i].lastDebounceTime) > debounceDelay) {
+            if ((hal::nowMs() - buttons[i].lastDebounceTime) > debounceDelay) {
                 if (reading != buttons[i].state) {
                     buttons[i].state = reading;
                     if (buttons[i].state == LOW) {
@@ -48,6 +49,17 @@ public:
         }
     }
 
+    // 원격 제어 등에서 물리 버튼과 같은 입력 경로로 눌림 이벤트를 넣는다 (loop 태스크에서만 호출)
+    bool inject(int pin) {
+        for (int i = 0; i < 4; i++) {
+            if (buttons[i].pin == pin) {
+                buttons[i].pressedEvent = true;
+                return true;
+            }
+        }
+        return false;
+    }
+
     bool wasPressed(int pin) {
         for (int i = 0; i < 4; i++) {
             if (buttons[i].pin == pin) {
@@ -64,9 +76,9 @@ public:
     // For debugging
     void checkButtons() {
         update();
-        if (wasPressed(BTN_1)) webLog("Button 1 Pressed!");
-        if (wasPressed(BTN_2)) webLog("Button 2 Pressed!");
-        if (wasPressed(BTN_3)) webLog("Button 3 Pressed!");
-        if (wasPressed(BTN_4)) webLog("Button 4 Pressed!");
+        if (wasPressed(BTN_1)) WEBLOG_INFO("Button 1 Pressed!");
+        if (wasPressed(BTN_2)) WEBLOG_INFO("Button 2 Pressed!");
+        if (wasPressed(BTN_3)) WEBLOG_INFO("Button 3 Pressed!");
+        if (wasPressed(BTN_4)) WEBLOG_INFO("Button 4 Pressed!");
     }
 };
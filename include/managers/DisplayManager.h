@@ -1,33 +1,80 @@
 #pragma once
 #include "drivers/LedDriver.h"
 #include "drivers/SegmentDriver.h"
+#include "managers/SegmentText.h"
 #include "graphics/Effects.h"
+#include "graphics/AnimatedEffects.h"
+#include "graphics/Compositor.h"
+#include "graphics/Transition.h"
 #include "Config.h"
+#include "Topology.h"
+#include <atomic>
 
+// 프레임 카운터 (loop 태스크만 쓰고 /metrics가 읽는다)
+struct DisplayStats {
+    std::atomic<uint32_t> updates{0};       // update() 호출 수
+    std::atomic<uint32_t> updateUsTotal{0}; // update() 누적 시간 (us, 넘치면 0부터 다시)
+    std::atomic<uint32_t> updateUsMax{0};
+    std::atomic<uint32_t> committed{0};     // endFrame() 수
+    std::atomic<uint32_t> streamed{0};      // 그중 /ws/frames로 나간 프레임
+};
+
+// 화면의 유일한 주인. 바탕(프리셋)/오버레이(글자)/시스템(부트) 레이어를 Compositor로 합쳐
+// LED와 7세그먼트에 내보내는 곳은 commitFrame() 하나뿐이다.
+// 부팅 중(setup이 막혀 있는 동안)에는 부트 태스크가, stopBootAnimation() 뒤로는 loop의 update()가 커밋한다.
 class DisplayManager {
 public:
     DisplayManager();
     void begin();
     void update(const AppConfig& config);
-    void startBootAnimation(); // 비동기 시작
-    void stopBootAnimation();  // 종료
-    void displayIP(uint32_t ipAddress); // IP 표시
-    void displayPreset(int presetIndex);
+    void startBootAnimation(); // 부트 레이어를 켜고 부트 태스크가 프레임을 내보낸다
+    // 커밋을 loop로 넘기고 부트 레이어를 fadeMs 동안 흐리게 지운다 (태스크의 다음 프레임까지만 기다린다)
+    void stopBootAnimation(uint32_t fadeMs = kBootFadeMs);
+    // 7세그먼트 오버레이: 큐에 넣기만 하고 바로 돌아온다 (다음 update()부터 보인다)
+    void displayIP(uint32_t ipAddress);          // "IP 192.168.0.10" 한 바퀴
+    void displayPreset(const AppConfig& config); // "P 1" + D-Day 이름
     void displayTemporaryValue(int value);
-    bool isBooting() const { return _isBooting; }
+    void endFrame(); // 한 프레임의 모든 그리기가 끝난 지점 (프레임 스트림 커밋)
+    bool isBooting() const { return _bootPump; }
+    const DisplayStats& stats() const { return _stats; }
+    uint8_t brightness() const { return _leds.getBrightness(); } // 야간 모드 반영 후 실제 밝기
+    const Topology& topology() const { return *_topology; }
+    bool isNightActive() const { return _nightActive; }
+    bool transitionActive() const { return _transition.active(); } // loop가 TRANSITION_FRAME_INTERVAL_MS로 그린다
+
+    static constexpr uint32_t kBootFadeMs = 400;
 
 private:
+    static constexpr uint32_t kOverlayMs = 1500;
+    static constexpr uint32_t kBootFrameMs = 40;
+
+    const Topology* _topology; // begin()에서 정해지고 그 뒤로 바뀌지 않는다
     LedDriver _leds;
     SegmentDriver _seg;
-    bool _isBooting = false;
-    TaskHandle_t _bootTaskHandle = NULL;
+    SegmentText _text;
+    Compositor _compositor;
+    Transition _transition;
+    int _lastPresetIndex = -1; // 바뀌면 전환 효과 시작 (버튼, /set-config, 스케줄 모두 여기서 잡힌다)
+    std::atomic<bool> _bootPump{false};    // 부트 태스크가 커밋 주인이다 (stop이 내린다)
+    std::atomic<bool> _pumpRunning{false}; // 태스크가 끝나면 태스크가 내린다
+    uint32_t _bootStartMs = 0;
+    bool _nightActive = false;
+    DisplayStats _stats;
     
     // 효과 전략들
     SolidEffect _solidEffect;
     RainbowEffect _rainbowEffect;
     TimeGradientEffect _timeGradEffect;
     SpaceGradientEffect _spaceGradEffect;
+    BreathingEffect _breathingEffect;
+    CometEffect _cometEffect;
+    SparkleEffect _sparkleEffect;
+    RotatingRainbowEffect _rotatingRainbowEffect;
 
     IEffect* getEffect(int mode);
-    void renderRing(int startIdx, int count, float progress, int colorMode, uint32_t c1, uint32_t c2, uint32_t cEmpty);
+    void render(const AppConfig& config);
+    void renderBootLayer(uint32_t nowMs);
+    void commitFrame(uint32_t nowMs);
+    static void formatNumber(char* out, size_t size, int value, int dpPos);
+    void renderRing(int startIdx, int count, float progress, int colorMode, uint32_t c1, uint32_t c2, uint32_t cEmpty, uint32_t timeMs);
 };
@@ -2,54 +2,69 @@
 #include <Arduino.h>
 #include "Config.h"
 #include "WebLogger.h"
+#include "TimerEngine.h"
+#include <atomic>
+
+// 원격 제어/상태 채널에 내보내는 인터랙티브 상태 요약
+struct InteractiveSnapshot
+{
+    long counter;
+    bool timerRunning;
+    unsigned long timerElapsedMs;
+    uint8_t pomoState;
+    bool pomoRunning;
+    unsigned long pomoElapsedMs;
+};
 
 class InteractiveManager
 {
 public:
+    enum PomoState : uint8_t
+    {
+        POMO_WORK,
+        POMO_WAIT_REST,
+        POMO_REST,
+        POMO_WAIT_WORK
+    };
+
     InteractiveManager();
-    void begin();
-    void update(); // Called in loop
+    void begin();  // Call after timerEngine.begin()
+    void update(); // Called in loop: pushes the active preset's durations into the timer engine
+    void reloadPresets(); // 설정이 통째로 바뀐 뒤 (웹 태스크에서도 된다): 다음 update()가 현재 프리셋 길이를 다시 읽는다
 
     // Button Inputs
     void handleButton1(int mode); // Reset / Decrease
     void handleButton2(int mode); // Start / Increase / Pause
     void resetCounter();
 
+    // Direct Commands (remote control)
+    void setCounter(long value);
+    void startTimer();
+    void pauseTimer();
+    void resetTimer();
+
     // Data Access for Display
     float getProgress(const RingConfig &ring);
     int getDisplayNumber(int mode);
     bool shouldBlink(int mode); // For Pomodoro waiting state
 
-    bool isTimerRunning() { return _timerRunning; }
-    bool isPomoRunning() { return _pomoRunning; }
+    bool isTimerRunning() { return timerEngine.running(_timer); }
+    bool isPomoRunning() { return timerEngine.running(_pomodoro); }
+    void getSnapshot(InteractiveSnapshot &out);
+    void applySnapshot(const InteractiveSnapshot &in); // 동기화 팔로워: 리더 상태를 그대로 따른다
 
 private:
     // Counter State
     long _counterValue = 0;
 
-    // Timer State
-    unsigned long _timerStartTime = 0;
-    unsigned long _timerPauseTime = 0;
-    unsigned long _accumulatedTime = 0; // Paused duration
-    bool _timerRunning = false;
-    bool _timerFinished = false;
+    // Timer / Pomodoro live in the timer engine; expiry arrives as events
+    TimerHandle _timer = kInvalidTimer;
+    TimerHandle _pomodoro = kInvalidTimer;
+    int _appliedPreset = -1;
+    std::atomic<bool> _reloadRequested{false};
 
-    // Pomodoro State
-    enum PomoState
-    {
-        POMO_WORK,
-        POMO_WAIT_REST,
-        POMO_REST,
-        POMO_WAIT_WORK
-    };
-    PomoState _pomoState = POMO_WORK;
-    unsigned long _pomoStartTime = 0;
-    unsigned long _pomoPauseTime = 0;
-    unsigned long _pomoAccumulated = 0;
-    bool _pomoRunning = false;
-
-    // Helper
-    unsigned long getElapsed(unsigned long start, unsigned long accumulated, bool running);
+    void applyPresetDurations();
+    static void onTimerEvent(const TimerEvent &event, void *ctx);
 };
 
 extern InteractiveManager interactiveManager;
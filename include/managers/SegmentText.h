@@ -0,0 +1,73 @@
+#pragma once
+#include <Arduino.h>
+
+// 3자리 7세그먼트용 글자 엔진.
+//
+// 바탕(base)은 매 프레임 DisplayManager가 넣는 현재 모드 값이고, 그 위에 시간 제한이 있는
+// 작업(job)을 큐로 쌓는다. 우선순위가 가장 높은 작업이 보이고, 같은 우선순위는 넣은 순서대로 돈다.
+// 3칸보다 긴 글은 마퀴로 흐르고(바탕은 반복), 깜빡임은 작업 플래그로 준다.
+// 모든 진행은 tick()에 넘긴 시각으로만 움직인다 (지연/할당 없음).
+enum SegmentTextPriority : uint8_t
+{
+    SEG_PRIORITY_OVERLAY = 1, // 프리셋 번호, 카운터 값, D-Day 이름
+    SEG_PRIORITY_SYSTEM = 2   // IP 주소 등
+};
+
+enum SegmentTextFlags : uint8_t
+{
+    SEG_TEXT_BLINK = 1 << 0,   // 250ms 켜짐/꺼짐
+    SEG_TEXT_REPLACE = 1 << 1  // 같은 우선순위의 대기/진행 중 작업을 먼저 지운다
+};
+
+class SegmentText
+{
+public:
+    static constexpr size_t kMaxCells = 32;
+    static constexpr size_t kMaxJobs = 8;
+    static constexpr uint32_t kMarqueeStepMs = 350;
+    static constexpr uint32_t kMarqueeHoldMs = 800; // 마퀴 처음/끝에서 멈추는 시간
+
+    // 바뀌었을 때만 다시 배치한다. 칸 수가 같으면 마퀴 위치를 이어 간다.
+    void setBase(const char *text);
+
+    // durationMs는 최소 표시 시간: 3칸보다 긴 글은 적어도 한 바퀴 흐르고 끝에서 멈춘다.
+    // 그릴 글자가 없거나(한글만 있는 이름 등) 큐가 차면 false.
+    bool post(const char *text, uint8_t priority, uint32_t durationMs, uint8_t flags = 0);
+    void cancel(uint8_t priority);
+    bool overlayActive() const { return _jobCount > 0; }
+
+    // 지금 보일 세그먼트 (활성 high, SegmentFont 비트 배치). 작업이 보이면 true, 바탕이면 false.
+    bool tick(uint32_t nowMs, uint8_t out[3]);
+
+private:
+    struct Cells
+    {
+        uint8_t glyphs[kMaxCells];
+        uint8_t count = 0;
+    };
+
+    struct Job
+    {
+        Cells cells;
+        uint8_t priority = 0;
+        uint8_t flags = 0;
+        uint32_t durationMs = 0;
+        uint32_t elapsedMs = 0; // 보이는 동안만 센다 (위 작업에 가려지면 멈춤)
+        uint32_t seq = 0;
+    };
+
+    Cells _base;
+    char _baseText[kMaxCells + 1] = "";
+    uint32_t _baseElapsedMs = 0;
+    Job _jobs[kMaxJobs];
+    uint8_t _jobCount = 0;
+    uint32_t _nextSeq = 0;
+    uint32_t _lastTickMs = 0;
+    bool _ticked = false;
+
+    static void layout(const char *text, Cells &out);
+    static uint32_t passMs(const Cells &cells);
+    static void window(const Cells &cells, uint32_t elapsedMs, bool loop, uint8_t out[3]);
+    int activeJob() const;
+    void removeJob(int index);
+};
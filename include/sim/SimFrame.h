@@ -0,0 +1,28 @@
+#pragma once
+#include "Topology.h"
+#include <cstdio>
+#include <vector>
+
+// 호스트 시뮬레이터가 받는 한 프레임 (DisplayManager::endFrame()이 /ws/frames로 보내는 것과 같은 내용).
+struct SimFrame
+{
+    uint32_t pixels[kMaxPixels] = {};
+    uint8_t count = 0;
+    uint8_t brightness = 0;
+    uint8_t seg[3] = {0xFF, 0xFF, 0xFF}; // 공통 애노드: 비트가 0이면 점등 (bit0=a ... bit6=g, bit7=dp)
+};
+
+// hal::native::setFrameSink()에 넘기는 수집기 (ctx = SimFrame*)
+void simCaptureFrame(const uint32_t *pixels, uint8_t count, uint8_t brightness, const uint8_t seg[3], void *ctx);
+
+// 픽셀/밝기/세그먼트를 모두 덮는 FNV-1a (골든 프레임 비교용)
+uint32_t simFrameHash(const SimFrame &frame, uint32_t seed = 2166136261u);
+
+// 터미널용 트루컬러 ANSI 그림 (두 링 + 가운데 3자리 7세그먼트)
+void simDrawAnsi(const SimFrame &frame, FILE *out);
+
+// 웹 미리보기(data/script.js drawPreview)와 같은 배치의 RGB 이미지
+constexpr int kSimImageSize = 240;
+void simRasterize(const SimFrame &frame, std::vector<uint8_t> &rgb);
+bool simWritePpm(const SimFrame &frame, const char *path);
+bool simWritePng(const SimFrame &frame, const char *path);
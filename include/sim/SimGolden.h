@@ -0,0 +1,9 @@
+#pragma once
+#include "managers/DisplayManager.h"
+#include "sim/SimFrame.h"
+
+// 골든 프레임: 링 모드 × 색 모드 × 7세그먼트 모드 전체 조합을 고정된 시각 몇 개에서 그려
+// 조합마다 해시 하나로 묶는다. 렌더 경로를 바꿔도 픽셀 단위로 같은지 이 파일로 확인한다.
+// captured는 hal::native::setFrameSink(simCaptureFrame, &captured)로 등록돼 있어야 한다.
+// update면 파일을 새로 쓴다. 반환: 불일치 수 (파일을 못 읽거나 못 쓰면 -1)
+int simGoldenRun(DisplayManager &display, const SimFrame &captured, const char *path, bool update);
@@ -0,0 +1,4 @@
+# env:native 전용: build_flags의 새니타이저는 컴파일에만 붙으므로 링크 단계에도 넘긴다.
+Import("env")
+
+env.Append(LINKFLAGS=["-fsanitize=address,undefined", "-fno-omit-frame-pointer", "-pthread"])
@@ -0,0 +1,452 @@
+#include "AllocTracker.h"
+#include "WebLogger.h"
+#include "hal/Hal.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#ifdef ARDUINO
+#include <ESPAsyncWebServer.h>
+#include <memory>
+#include "Metrics.h"
+#endif
+
+namespace
+{
+// 태그를 동시에 걸 수 있는 태스크 수 (loopTask, async_tcp, logDrain, 부트 애니메이션 ...).
+// 자리가 없으면 그 태그는 무시되고 ALLOC_OTHER로 센다.
+constexpr size_t kMaxScopedTasks = 6;
+constexpr uint32_t kSampleIntervalMs = 10000;
+constexpr size_t kSampleCount = 60; // 10초 × 60 = 최근 10분
+
+constexpr const char *kSubsystemNames[ALLOC_SUBSYSTEM_COUNT] = {"other", "render", "log", "config", "http", "history"};
+
+#if defined(TIME_TAPE_ALLOC_STRICT) || defined(__PLATFORMIO_BUILD_DEBUG__)
+constexpr bool kStrictDefault = true;
+#else
+constexpr bool kStrictDefault = false;
+#endif
+
+// task는 자리를 잡은 태스크만 바꾸고, 나머지 필드는 그 태스크만 읽고 쓴다.
+struct TaskScope
+{
+    std::atomic<uintptr_t> task{0};
+    uint8_t subsystem = ALLOC_OTHER;
+    bool allocFree = false;
+    uint8_t depth = 0;
+};
+
+struct SubsystemStats
+{
+    std::atomic<uint32_t> allocs{0};
+    std::atomic<uint32_t> frees{0};
+    std::atomic<uint32_t> bytes{0};
+    std::atomic<int32_t> net{0};
+    std::atomic<int32_t> peakNet{0};
+    std::atomic<uint32_t> violations{0};
+};
+
+struct HeapSample
+{
+    uint32_t uptimeS;
+    uint32_t freeBytes;
+    uint32_t largestBlock;
+    uint32_t liveBytes;
+};
+
+TaskScope g_scopes[kMaxScopedTasks];
+SubsystemStats g_stats[ALLOC_SUBSYSTEM_COUNT];
+std::atomic<int32_t> g_liveBytes{0};
+std::atomic<int32_t> g_peakBytes{0};
+std::atomic<uint32_t> g_failed{0};
+std::atomic<uint32_t> g_violations{0};
+std::atomic<bool> g_strict{kStrictDefault};
+
+// 아래는 loop()만 쓴다 (/alloc은 응답 시작 때 복사해 간다)
+HeapSample g_samples[kSampleCount];
+std::atomic<uint32_t> g_sampleTotal{0};
+uint32_t g_lastSampleMs = 0;
+uint32_t g_reportedViolations = 0;
+
+TaskScope *findScope(uintptr_t task)
+{
+    if (task == 0)
+        return nullptr;
+    for (TaskScope &scope : g_scopes)
+    {
+        if (scope.task.load(std::memory_order_relaxed) == task)
+            return &scope;
+    }
+    return nullptr;
+}
+
+void raiseMax(std::atomic<int32_t> &peak, int32_t value)
+{
+    int32_t seen = peak.load(std::memory_order_relaxed);
+    while (value > seen && !peak.compare_exchange_weak(seen, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+// malloc 래퍼 안에서 불린다: 락도 할당도 없이 atomic만 만진다.
+void recordAlloc(size_t size, size_t replaced)
+{
+    const TaskScope *scope = findScope(hal::currentTaskId());
+    SubsystemStats &stats = g_stats[scope ? scope->subsystem : ALLOC_OTHER];
+    const int32_t delta = (int32_t)size - (int32_t)replaced;
+
+    stats.allocs.fetch_add(1, std::memory_order_relaxed);
+    stats.bytes.fetch_add((uint32_t)size, std::memory_order_relaxed);
+    raiseMax(stats.peakNet, stats.net.fetch_add(delta, std::memory_order_relaxed) + delta);
+    raiseMax(g_peakBytes, g_liveBytes.fetch_add(delta, std::memory_order_relaxed) + delta);
+
+    if (scope && scope->allocFree)
+    {
+        stats.violations.fetch_add(1, std::memory_order_relaxed);
+        g_violations.fetch_add(1, std::memory_order_relaxed);
+        if (g_strict.load(std::memory_order_relaxed))
+        {
+            // stdio 버퍼가 또 할당하지 않게 고정 버퍼로 한 번에 쓴다
+            char msg[96];
+            snprintf(msg, sizeof(msg), "[Alloc] %u bytes allocated inside allocation-free %s scope\n",
+                     (unsigned)size, kSubsystemNames[scope->subsystem]);
+            fputs(msg, stderr);
+            abort();
+        }
+    }
+}
+
+void recordFree(size_t size)
+{
+    const TaskScope *scope = findScope(hal::currentTaskId());
+    SubsystemStats &stats = g_stats[scope ? scope->subsystem : ALLOC_OTHER];
+    stats.frees.fetch_add(1, std::memory_order_relaxed);
+    stats.net.fetch_sub((int32_t)size, std::memory_order_relaxed);
+    g_liveBytes.fetch_sub((int32_t)size, std::memory_order_relaxed);
+}
+} // namespace
+
+#ifdef TIME_TAPE_ALLOC_TRACK
+extern "C"
+{
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void __real_free(void *ptr);
+
+void *__wrap_malloc(size_t size)
+{
+    void *ptr = __real_malloc(size);
+    if (ptr)
+        recordAlloc(hal::heapBlockSize(ptr), 0);
+    else if (size > 0)
+        g_failed.fetch_add(1, std::memory_order_relaxed);
+    return ptr;
+}
+
+void *__wrap_calloc(size_t count, size_t size)
+{
+    void *ptr = __real_calloc(count, size);
+    if (ptr)
+        recordAlloc(hal::heapBlockSize(ptr), 0);
+    else if (count > 0 && size > 0)
+        g_failed.fetch_add(1, std::memory_order_relaxed);
+    return ptr;
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    const size_t before = ptr ? hal::heapBlockSize(ptr) : 0;
+    void *moved = __real_realloc(ptr, size);
+    if (moved)
+        recordAlloc(hal::heapBlockSize(moved), before);
+    else if (size == 0 && ptr)
+        recordFree(before); // realloc(p, 0)은 해제
+    else if (size > 0)
+        g_failed.fetch_add(1, std::memory_order_relaxed);
+    return moved;
+}
+
+void __wrap_free(void *ptr)
+{
+    if (ptr)
+        recordFree(hal::heapBlockSize(ptr));
+    __real_free(ptr);
+}
+}
+
+#ifndef ARDUINO
+// 호스트의 operator new는 libstdc++ 공유 라이브러리 안에서 malloc을 부르므로 --wrap이 닿지 않는다.
+// 여기서 malloc으로 돌려 std::string(String 대역)/vector 할당도 같이 센다. (기기는 정적 링크라 필요 없다)
+void *operator new(size_t size)
+{
+    void *ptr = malloc(size ? size : 1);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    return malloc(size ? size : 1);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+    return malloc(size ? size : 1);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    free(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept
+{
+    free(ptr);
+}
+#endif
+#endif // TIME_TAPE_ALLOC_TRACK
+
+AllocScope::AllocScope(AllocSubsystem subsystem, AllocPolicy policy)
+    : _slot(-1), _prevSubsystem(ALLOC_OTHER), _prevAllocFree(false)
+{
+    const uintptr_t task = hal::currentTaskId();
+    if (task == 0)
+        return;
+    TaskScope *scope = findScope(task);
+    for (size_t i = 0; scope == nullptr && i < kMaxScopedTasks; i++)
+    {
+        uintptr_t empty = 0;
+        if (g_scopes[i].task.compare_exchange_strong(empty, task, std::memory_order_relaxed))
+        {
+            scope = &g_scopes[i];
+            scope->subsystem = ALLOC_OTHER;
+            scope->allocFree = false;
+            scope->depth = 0;
+        }
+    }
+    if (scope == nullptr)
+        return;
+
+    _slot = (int8_t)(scope - g_scopes);
+    _prevSubsystem = scope->subsystem;
+    _prevAllocFree = scope->allocFree;
+    scope->subsystem = subsystem;
+    if (policy != ALLOC_POLICY_INHERIT)
+        scope->allocFree = (policy == ALLOC_POLICY_FORBID);
+    scope->depth++;
+}
+
+AllocScope::~AllocScope()
+{
+    if (_slot < 0)
+        return;
+    TaskScope &scope = g_scopes[_slot];
+    scope.subsystem = _prevSubsystem;
+    scope.allocFree = _prevAllocFree;
+    if (--scope.depth == 0)
+        scope.task.store(0, std::memory_order_relaxed);
+}
+
+void allocGetStats(AllocSubsystem subsystem, AllocStats &out)
+{
+    const SubsystemStats &stats = g_stats[subsystem < ALLOC_SUBSYSTEM_COUNT ? subsystem : ALLOC_OTHER];
+    out.allocs = stats.allocs.load(std::memory_order_relaxed);
+    out.frees = stats.frees.load(std::memory_order_relaxed);
+    out.bytes = stats.bytes.load(std::memory_order_relaxed);
+    out.net = stats.net.load(std::memory_order_relaxed);
+    out.peakNet = stats.peakNet.load(std::memory_order_relaxed);
+    out.violations = stats.violations.load(std::memory_order_relaxed);
+}
+
+uint32_t allocViolationCount()
+{
+    return g_violations.load(std::memory_order_relaxed);
+}
+
+void allocSetStrict(bool strict)
+{
+    g_strict.store(strict, std::memory_order_relaxed);
+}
+
+void allocLoop()
+{
+    const uint32_t now = hal::nowMs();
+    if (g_sampleTotal.load(std::memory_order_relaxed) > 0 && now - g_lastSampleMs < kSampleIntervalMs)
+        return;
+    g_lastSampleMs = now;
+
+    const uint32_t total = g_sampleTotal.load(std::memory_order_relaxed);
+    HeapSample &sample = g_samples[total % kSampleCount];
+    sample.uptimeS = now / 1000;
+    sample.freeBytes = hal::heapFreeBytes();
+    sample.largestBlock = hal::heapLargestFreeBlock();
+    // live는 추정치라 음수로 흐를 수 있다 (AllocTracker.h). 샘플 필드는 부호가 없어 0에서 자르고,
+    // 부호 있는 원래 값은 /alloc 맨 위 live에 그대로 나간다.
+    sample.liveBytes = (uint32_t)max<int32_t>(0, g_liveBytes.load(std::memory_order_relaxed));
+    g_sampleTotal.store(total + 1, std::memory_order_release);
+
+    const uint32_t violations = allocViolationCount();
+    if (violations != g_reportedViolations)
+    {
+        WEBLOG_WARN("[Alloc] %lu allocation(s) inside allocation-free scopes",
+                    (unsigned long)(violations - g_reportedViolations));
+        g_reportedViolations = violations;
+    }
+}
+
+#ifdef ARDUINO
+namespace
+{
+#ifdef TIME_TAPE_ALLOC_TRACK
+constexpr bool kTracking = true;
+#else
+constexpr bool kTracking = false;
+#endif
+
+// 응답 시작 때 값을 복사해 두고 조각씩 JSON으로 흘려보낸다.
+struct AllocCursor
+{
+    AllocStats rows[ALLOC_SUBSYSTEM_COUNT];
+    HeapSample samples[kSampleCount];
+    size_t sampleCount = 0;
+    int32_t live = 0;
+    int32_t peak = 0;
+    uint32_t failed = 0;
+    uint32_t violations = 0;
+
+    uint8_t part = 0; // 0: 머리, 1: 서브시스템, 2: 샘플, 3: 꼬리
+    size_t item = 0;
+    char buf[192];
+    size_t len = 0;
+    size_t pos = 0;
+
+    void snapshot()
+    {
+        for (uint8_t i = 0; i < ALLOC_SUBSYSTEM_COUNT; i++)
+            allocGetStats((AllocSubsystem)i, rows[i]);
+        live = g_liveBytes.load(std::memory_order_relaxed);
+        peak = g_peakBytes.load(std::memory_order_relaxed);
+        failed = g_failed.load(std::memory_order_relaxed);
+        violations = allocViolationCount();
+
+        // 오래된 것부터
+        const uint32_t total = g_sampleTotal.load(std::memory_order_acquire);
+        sampleCount = min<size_t>(total, kSampleCount);
+        for (size_t i = 0; i < sampleCount; i++)
+            samples[i] = g_samples[(total - sampleCount + i) % kSampleCount];
+    }
+
+    int formatPart()
+    {
+        switch (part)
+        {
+        case 0:
+            part++;
+            return snprintf(buf, sizeof(buf),
+                            "{\"tracking\":%s,\"live\":%ld,\"peak\":%ld,\"liveApprox\":true,\"failed\":%lu,\"violations\":%lu,\"subsystems\":[",
+                            kTracking ? "true" : "false", (long)live, (long)peak, (unsigned long)failed,
+                            (unsigned long)violations);
+        case 1:
+            if (item < ALLOC_SUBSYSTEM_COUNT)
+            {
+                const size_t i = item++;
+                const AllocStats &s = rows[i];
+                return snprintf(buf, sizeof(buf),
+                                "%s{\"name\":\"%s\",\"allocs\":%lu,\"frees\":%lu,\"bytes\":%lu,\"net\":%ld,\"peakNet\":%ld,\"violations\":%lu}",
+                                i == 0 ? "" : ",", kSubsystemNames[i], (unsigned long)s.allocs, (unsigned long)s.frees,
+                                (unsigned long)s.bytes, (long)s.net, (long)s.peakNet, (unsigned long)s.violations);
+            }
+            part++;
+            item = 0;
+            return snprintf(buf, sizeof(buf), "],\"samples\":[");
+        case 2:
+            if (item < sampleCount)
+            {
+                const size_t i = item++;
+                const HeapSample &s = samples[i];
+                return snprintf(buf, sizeof(buf), "%s{\"t\":%lu,\"free\":%lu,\"largest\":%lu,\"live\":%lu}",
+                                i == 0 ? "" : ",", (unsigned long)s.uptimeS, (unsigned long)s.freeBytes,
+                                (unsigned long)s.largestBlock, (unsigned long)s.liveBytes);
+            }
+            part++;
+            return snprintf(buf, sizeof(buf), "]}");
+        default:
+            return 0;
+        }
+    }
+
+    size_t fill(uint8_t *out, size_t maxLen)
+    {
+        size_t written = 0;
+        while (written < maxLen)
+        {
+            if (pos == len)
+            {
+                const int n = formatPart();
+                if (n <= 0)
+                    break;
+                len = min((size_t)n, sizeof(buf) - 1);
+                pos = 0;
+            }
+            const size_t n = min(len - pos, maxLen - written);
+            memcpy(out + written, buf + pos, n);
+            pos += n;
+            written += n;
+        }
+        return written;
+    }
+};
+
+void resetCounters()
+{
+    for (SubsystemStats &stats : g_stats)
+    {
+        stats.allocs.store(0, std::memory_order_relaxed);
+        stats.frees.store(0, std::memory_order_relaxed);
+        stats.bytes.store(0, std::memory_order_relaxed);
+        stats.net.store(0, std::memory_order_relaxed);
+        stats.peakNet.store(0, std::memory_order_relaxed);
+    }
+    g_peakBytes.store(g_liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+} // namespace
+
+void allocAttach(AsyncWebServer &server)
+{
+    // /alloc          서브시스템별 할당 통계 + 최근 10분 힙 샘플
+    // /alloc?reset=1  보낸 뒤 서브시스템 카운터와 peak를 0부터 다시 센다 (위반 수는 유지)
+    server.on("/alloc", HTTP_GET, [](AsyncWebServerRequest *request)
+              {
+        const uint32_t startUs = micros();
+        AllocScope scope(ALLOC_HTTP);
+        auto cursor = std::make_shared<AllocCursor>();
+        cursor->snapshot();
+        if (request->hasParam("reset"))
+            resetCounters();
+
+        AsyncWebServerResponse *response = request->beginChunkedResponse(
+            "application/json",
+            [cursor](uint8_t *buffer, size_t maxLen, size_t index) -> size_t
+            { return cursor->fill(buffer, maxLen); });
+        request->send(response);
+        metricsRecordHttp(ROUTE_ALLOC, micros() - startUs); });
+}
+#endif
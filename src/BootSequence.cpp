@@ -0,0 +1,226 @@
+#include "BootSequence.h"
+#include "WebLogger.h"
+#include "hal/Hal.h"
+#include <atomic>
+#include <cstdio>
+#ifdef ARDUINO
+#include <ESPAsyncWebServer.h>
+#include <esp_system.h>
+#include "Metrics.h"
+#endif
+
+namespace
+{
+constexpr const char *kPhaseNames[BOOT_PHASE_COUNT] = {"config", "hardware", "storage", "wifi", "services", "time", "first_frame"};
+// bootRunAsync 태스크 이름 (/metrics가 이름으로 찾는 시스템 "wifi" 태스크와 겹치지 않게)
+constexpr const char *kTaskNames[BOOT_PHASE_COUNT] = {"bootConfig", "bootHw", "bootStorage", "bootWifi", "bootServices", "bootTime", "bootFrame"};
+// 시간 소스 없이 부트 애니메이션을 붙들고 있는 최대 시간 (WiFi 연결 뒤부터. 예전 NTP 대기와 같다)
+constexpr uint32_t kTimeWaitAfterWifiMs = 10000;
+
+enum PhaseState : uint8_t
+{
+    PHASE_PENDING = 0,
+    PHASE_RUNNING,
+    PHASE_OK,
+    PHASE_FAILED
+};
+
+// 단계마다 한 태스크만 쓰고 /boot-trace(async_tcp)가 읽는다
+struct PhaseTrace
+{
+    std::atomic<uint32_t> startUs{0};
+    std::atomic<uint32_t> endUs{0};
+    std::atomic<uint8_t> state{PHASE_PENDING};
+    std::atomic<const char *> note{nullptr};
+};
+
+PhaseTrace g_phases[BOOT_PHASE_COUNT];
+int g_resetReason = -1;
+
+struct AsyncPhase
+{
+    BootPhase phase;
+    bool (*fn)();
+};
+AsyncPhase g_async[BOOT_PHASE_COUNT];
+uint32_t g_wifiDoneAt = 0; // 부팅 연결이 끝난 시각 (0이면 아직, loop 태스크만 쓴다)
+
+void runPhase(BootPhase phase, bool (*fn)())
+{
+    bootPhaseBegin(phase);
+    bootPhaseEnd(phase, fn());
+}
+
+#ifdef ARDUINO
+const char *resetReasonName(int reason)
+{
+    switch (reason)
+    {
+    case ESP_RST_POWERON:
+        return "power_on";
+    case ESP_RST_SW:
+        return "software";
+    case ESP_RST_PANIC:
+        return "panic";
+    case ESP_RST_INT_WDT:
+    case ESP_RST_TASK_WDT:
+    case ESP_RST_WDT:
+        return "watchdog";
+    case ESP_RST_DEEPSLEEP:
+        return "deep_sleep";
+    case ESP_RST_BROWNOUT:
+        return "brownout";
+    default:
+        return "other";
+    }
+}
+
+const char *stateName(uint8_t state)
+{
+    switch (state)
+    {
+    case PHASE_RUNNING:
+        return "running";
+    case PHASE_OK:
+        return "ok";
+    case PHASE_FAILED:
+        return "failed";
+    default:
+        return "pending";
+    }
+}
+#endif
+} // namespace
+
+void bootBegin()
+{
+#ifdef ARDUINO
+    g_resetReason = (int)esp_reset_reason();
+#endif
+}
+
+void bootPhaseBegin(BootPhase phase)
+{
+    PhaseTrace &p = g_phases[phase];
+    p.startUs.store(hal::nowUs(), std::memory_order_relaxed);
+    p.state.store(PHASE_RUNNING, std::memory_order_release);
+}
+
+void bootPhaseEnd(BootPhase phase, bool ok)
+{
+    PhaseTrace &p = g_phases[phase];
+    if (p.state.load(std::memory_order_acquire) != PHASE_RUNNING)
+        return;
+    const uint32_t endUs = hal::nowUs();
+    p.endUs.store(endUs, std::memory_order_relaxed);
+    p.state.store(ok ? PHASE_OK : PHASE_FAILED, std::memory_order_release);
+
+    const uint32_t tookMs = (endUs - p.startUs.load(std::memory_order_relaxed)) / 1000;
+    const char *note = p.note.load(std::memory_order_relaxed);
+    WEBLOG_INFO("[Boot] %s %s in %u ms%s%s", kPhaseNames[phase], ok ? "ok" : "failed", (unsigned)tookMs, note ? ": " : "",
+                note ? note : "");
+}
+
+bool bootPhaseStarted(BootPhase phase)
+{
+    return g_phases[phase].state.load(std::memory_order_acquire) != PHASE_PENDING;
+}
+
+bool bootPhaseDone(BootPhase phase)
+{
+    return g_phases[phase].state.load(std::memory_order_acquire) >= PHASE_OK;
+}
+
+bool bootPhaseOk(BootPhase phase)
+{
+    return g_phases[phase].state.load(std::memory_order_acquire) == PHASE_OK;
+}
+
+void bootPhaseNote(BootPhase phase, const char *note)
+{
+    g_phases[phase].note.store(note, std::memory_order_relaxed);
+}
+
+void bootRunAsync(BootPhase phase, bool (*fn)(), uint32_t stackBytes)
+{
+    g_async[phase] = {phase, fn};
+    auto taskFn = [](void *arg)
+    {
+        const AsyncPhase &job = *static_cast<const AsyncPhase *>(arg);
+        runPhase(job.phase, job.fn);
+    };
+    if (!hal::startTask(taskFn, kTaskNames[phase], stackBytes, &g_async[phase]))
+        runPhase(phase, fn);
+}
+
+bool bootStepsPending()
+{
+    return !bootPhaseDone(BOOT_PHASE_TIME) || !bootPhaseDone(BOOT_PHASE_SERVICES);
+}
+
+void bootStep(const BootSteps &steps)
+{
+    // 시간 소스가 생기면 (또는 WiFi 뒤로도 끝내 안 생기면) 부트 애니메이션을 걷는다.
+    // 콜드 부트는 WiFi가 먼저 붙고 NTP가 나중에 오므로 서비스를 띄운 뒤에도 여기를 계속 지난다.
+    if (!bootPhaseDone(BOOT_PHASE_TIME))
+    {
+        const bool ready = steps.timeReady();
+        const bool gaveUp = g_wifiDoneAt != 0 && hal::nowMs() - g_wifiDoneAt > kTimeWaitAfterWifiMs;
+        if (ready || gaveUp)
+        {
+            bootPhaseNote(BOOT_PHASE_TIME, !ready ? "none" : bootPhaseOk(BOOT_PHASE_WIFI) ? "network" : "rtc");
+            bootPhaseEnd(BOOT_PHASE_TIME, ready);
+            steps.timeSettled();
+        }
+    }
+
+    if (bootPhaseDone(BOOT_PHASE_WIFI) && g_wifiDoneAt == 0)
+    {
+        g_wifiDoneAt = hal::nowMs() | 1;
+        if (!bootPhaseOk(BOOT_PHASE_WIFI))
+            steps.wifiFailed();
+    }
+
+    // 서비스는 처음 붙었을 때 한 번 (부팅 연결이든 나중에 뒤에서 붙었든).
+    // 정적 파일과 /history가 LittleFS를 쓰므로 마운트(STORAGE)가 끝나기 전에는 띄우지 않는다: 캐시된 BSSID 연결이 더 빠를 수 있다.
+    if (g_wifiDoneAt != 0 && bootPhaseDone(BOOT_PHASE_STORAGE) && !bootPhaseStarted(BOOT_PHASE_SERVICES) && steps.linkUp())
+    {
+        bootPhaseBegin(BOOT_PHASE_SERVICES);
+        steps.startServices();
+        bootPhaseEnd(BOOT_PHASE_SERVICES);
+    }
+}
+
+#ifdef ARDUINO
+void bootAttach(AsyncWebServer &server)
+{
+    // {"resetReason":"software","phases":[{"name":"config","state":"ok","startMs":1.2,"durationMs":3.4,"note":null},...]}
+    // 진행 중인 단계의 durationMs는 지금까지 걸린 시간이다.
+    server.on("/boot-trace", HTTP_GET, [](AsyncWebServerRequest *request)
+              {
+        const uint32_t startUs = micros();
+        const uint32_t nowUs = hal::nowUs();
+        char body[160 + BOOT_PHASE_COUNT * 112];
+        size_t len = snprintf(body, sizeof(body), "{\"resetReason\":\"%s\",\"phases\":[",
+                              g_resetReason < 0 ? "unknown" : resetReasonName(g_resetReason));
+        for (uint8_t i = 0; i < BOOT_PHASE_COUNT && len < sizeof(body); i++)
+        {
+            const PhaseTrace &p = g_phases[i];
+            const uint8_t state = p.state.load(std::memory_order_acquire);
+            const uint32_t begin = p.startUs.load(std::memory_order_relaxed);
+            const uint32_t end = (state >= PHASE_OK) ? p.endUs.load(std::memory_order_relaxed) : nowUs;
+            const char *note = p.note.load(std::memory_order_relaxed);
+            char noteJson[40] = "null";
+            if (note)
+                snprintf(noteJson, sizeof(noteJson), "\"%s\"", note);
+            len += snprintf(body + len, sizeof(body) - len,
+                            "%s{\"name\":\"%s\",\"state\":\"%s\",\"startMs\":%.1f,\"durationMs\":%.1f,\"note\":%s}",
+                            i ? "," : "", kPhaseNames[i], stateName(state), state == PHASE_PENDING ? 0.0 : begin / 1000.0,
+                            state == PHASE_PENDING ? 0.0 : (end - begin) / 1000.0, noteJson);
+        }
+        if (len < sizeof(body))
+            snprintf(body + len, sizeof(body) - len, "]}");
+        request->send(200, "application/json", body);
+        metricsRecordHttp(ROUTE_BOOT_TRACE, micros() - startUs); });
+}
+#endif
@@ -234,6 +234,9 @@ void configToJson(JsonDocument &doc, const AppConfig &config)
     doc["nS"] = config.nightStartHour;
     doc["nE"] = config.nightEndHour;
     doc["nB"] = config.nightBrightness;
+    doc["sync"] = config.syncRole;
+    doc["trS"] = config.transitionStyle;
+    doc["trMs"] = config.transitionMs;
 
     JsonArray presets = doc["presets"].to<JsonArray>();
     for (const Preset &p : config.presets)
@@ -252,6 +255,16 @@ void configToJson(JsonDocument &doc, const AppConfig &config)
         obj["s"] = d.startDate;
         obj["t"] = d.targetDate;
     }
+
+    JsonArray schedules = doc["sch"].to<JsonArray>();
+    for (const ScheduleRule &r : config.schedules)
+    {
+        JsonObject obj = schedules.add<JsonObject>();
+        obj["d"] = r.days;
+        obj["h"] = r.hour;
+        obj["m"] = r.minute;
+        obj["p"] = r.preset;
+    }
 }
 
 bool configFromJson(JsonDocument &doc, AppConfig &config)
@@ -263,6 +276,15 @@ bool configFromJson(JsonDocument &doc, AppConfig &config)
     parsed.nightStartHour = doc["nS"] | 22;
     parsed.nightEndHour = doc["nE"] | 7;
     parsed.nightBrightness = doc["nB"] | 10;
+    parsed.syncRole = doc["sync"] | 0;
+    if (parsed.syncRole < 0 || parsed.syncRole > 2)
+        parsed.syncRole = 0;
+    parsed.transitionStyle = doc["trS"] | 1;
+    if (parsed.transitionStyle < 0 || parsed.transitionStyle > 2)
+        parsed.transitionStyle = 1;
+    parsed.transitionMs = doc["trMs"] | 400;
+    if (parsed.transitionMs < 0 || parsed.transitionMs > 3000)
+        parsed.transitionMs = 400;
 
     JsonArray presets = doc["presets"];
     if (presets.isNull())
@@ -303,6 +325,30 @@ bool configFromJson(JsonDocument &doc, AppConfig &config)
         parsed.currentPresetIndex = 0;
     }
 
+    // 잘못된 스케줄 규칙은 설정 전체를 거부하지 않고 그 규칙만 버린다
+    JsonArray schedules = doc["sch"];
+    if (!schedules.isNull())
+    {
+        for (JsonObject sObj : schedules)
+        {
+            const int days = sObj["d"] | 0;
+            const int hour = sObj["h"] | -1;
+            const int minute = sObj["m"] | -1;
+            const int preset = sObj["p"] | -1;
+            if ((days & SCHEDULE_EVERY_DAY) == 0 || hour < 0 || hour > 23 || minute < 0 || minute > 59 ||
+                preset < 0 || preset >= (int)parsed.presets.size())
+            {
+                continue;
+            }
+            ScheduleRule r;
+            r.days = (uint8_t)(days & SCHEDULE_EVERY_DAY);
+            r.hour = (uint8_t)hour;
+            r.minute = (uint8_t)minute;
+            r.preset = preset;
+            parsed.schedules.push_back(r);
+        }
+    }
+
     config = parsed;
     return true;
 }
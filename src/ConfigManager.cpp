@@ -1,23 +1,28 @@
 #include "Config.h"
 #include "ConfigCodec.h"
+#include "WebLogger.h"
+#include "Metrics.h"
+#include "AllocTracker.h"
+#include "hal/Hal.h"
 #include <ArduinoJson.h>
-#include <Preferences.h>
 #include <vector>
 
 AppConfig appConfig;
-Preferences preferences;
 
 namespace
 {
 const char *kPrefNs = "time-tape";
 const char *kPrefKeyConfigBin = "config_bin";
 const char *kPrefKeyConfigJson = "config";
+
+constexpr unsigned long kSaveDebounceMs = 3000; // 버튼 연타/스케줄 전환을 한 번의 NVS 쓰기로 합친다
+bool g_savePending = false;
+unsigned long g_saveRequestedAt = 0;
 }
 
 void initDefaultConfig()
 {
-	appConfig.presets.clear();
-	appConfig.ddays.clear();
+	appConfig = AppConfig(); // 스케줄·밝기 등 이전 설정이 남지 않게 통째로 되돌린다
 
 	Preset p1;
 	p1.inner.mode = 0;
@@ -43,42 +48,37 @@ void initDefaultConfig()
 
 void saveConfigToFile()
 {
-    preferences.begin(kPrefNs, false);
-    
+    AllocScope scope(ALLOC_CONFIG);
     JsonDocument doc;
     configToJson(doc, appConfig);
 
     const size_t msgpackSize = measureMsgPack(doc);
     std::vector<uint8_t> msgpack(msgpackSize);
     serializeMsgPack(doc, msgpack.data(), msgpack.size());
-    size_t written = preferences.putBytes(kPrefKeyConfigBin, msgpack.data(), msgpack.size());
+    size_t written = hal::storageWriteBytes(kPrefNs, kPrefKeyConfigBin, msgpack.data(), msgpack.size());
+    metricsRecordNvsWrite(written);
 
     // 백업/하위호환용 JSON도 함께 저장
     String jsonStr;
     serializeJson(doc, jsonStr);
-    size_t jsonWritten = preferences.putString(kPrefKeyConfigJson, jsonStr);
+    size_t jsonWritten = hal::storageWriteString(kPrefNs, kPrefKeyConfigJson, jsonStr);
+    metricsRecordNvsWrite(jsonWritten);
 
     if (written != msgpack.size() || jsonWritten == 0)
     {
-        Serial.println("[Config] Warning: config save may be incomplete");
+        WEBLOG_WARN("[Config] Warning: config save may be incomplete");
     }
-
-    preferences.end();
 }
 
 void loadConfig()
 {
-    preferences.begin(kPrefNs, true);
-    size_t msgpackSize = preferences.getBytesLength(kPrefKeyConfigBin);
-    String jsonStr = preferences.getString(kPrefKeyConfigJson, "");
-    preferences.end();
+    size_t msgpackSize = hal::storageBytesLength(kPrefNs, kPrefKeyConfigBin);
+    String jsonStr = hal::storageReadString(kPrefNs, kPrefKeyConfigJson, "");
 
     if (msgpackSize > 0)
     {
         std::vector<uint8_t> msgpack(msgpackSize);
-        preferences.begin(kPrefNs, true);
-        size_t read = preferences.getBytes(kPrefKeyConfigBin, msgpack.data(), msgpack.size());
-        preferences.end();
+        size_t read = hal::storageReadBytes(kPrefNs, kPrefKeyConfigBin, msgpack.data(), msgpack.size());
 
         if (read == msgpack.size())
         {
@@ -118,3 +118,28 @@ void loadConfig()
 
     appConfig = parsed;
 }
+
+void switchPreset(int index)
+{
+    if (appConfig.presets.empty() || index < 0 || index >= (int)appConfig.presets.size())
+        return;
+    if (index == appConfig.currentPresetIndex)
+        return;
+    appConfig.currentPresetIndex = index;
+    requestConfigSave();
+}
+
+void requestConfigSave()
+{
+    g_savePending = true;
+    g_saveRequestedAt = hal::nowMs();
+}
+
+void configSaveLoop()
+{
+    if (g_savePending && hal::nowMs() - g_saveRequestedAt >= kSaveDebounceMs)
+    {
+        g_savePending = false;
+        saveConfigToFile();
+    }
+}
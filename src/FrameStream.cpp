@@ -0,0 +1,162 @@
+#include "FrameStream.h"
+#include <ESPAsyncWebServer.h>
+#include <atomic>
+#include <cstring>
+#include "Topology.h"
+
+AsyncWebSocket wsFrames("/ws/frames");
+
+namespace
+{
+enum FrameType : uint8_t
+{
+    FRAME_KEY = 1,
+    FRAME_DELTA = 2
+};
+
+constexpr size_t kMaxFrameClients = 4;
+constexpr size_t kMaxFrameLeds = kMaxPixels;
+constexpr size_t kFrameHeaderSize = 7;
+constexpr size_t kFrameBufferSize = kFrameHeaderSize + 1 + kMaxFrameLeds * 4;
+
+// id는 WebSocket 이벤트(async_tcp 태스크)가 쓰고, 나머지는 publish(loop 태스크)만 쓴다.
+struct FrameClient
+{
+    std::atomic<uint32_t> id{0};
+    uint32_t ownerId = 0; // 아래 last가 누구 기준인지 (id와 다르면 key frame부터)
+    uint8_t last[kMaxFrameLeds * 3];
+    uint8_t lastSeg[3];
+    uint8_t lastBrightness = 0;
+};
+
+FrameClient g_clients[kMaxFrameClients];
+std::atomic<uint8_t> g_clientCount{0};
+uint8_t g_seq = 0;
+uint8_t g_packet[kFrameBufferSize];
+
+void onFrameEvent(AsyncWebSocket *socket, AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len)
+{
+    if (type == WS_EVT_CONNECT)
+    {
+        for (FrameClient &slot : g_clients)
+        {
+            uint32_t expected = 0;
+            if (slot.id.compare_exchange_strong(expected, client->id()))
+            {
+                g_clientCount.fetch_add(1);
+                return;
+            }
+        }
+        client->text("{\"status\":\"error\",\"reason\":\"too_many_clients\"}");
+        client->close();
+    }
+    else if (type == WS_EVT_DISCONNECT)
+    {
+        for (FrameClient &slot : g_clients)
+        {
+            uint32_t expected = client->id();
+            if (slot.id.compare_exchange_strong(expected, 0))
+            {
+                g_clientCount.fetch_sub(1);
+                return;
+            }
+        }
+    }
+}
+
+size_t writeHeader(FrameType type, uint8_t count, uint8_t brightness, const uint8_t seg[3])
+{
+    g_packet[0] = type;
+    g_packet[1] = g_seq;
+    g_packet[2] = count;
+    g_packet[3] = brightness;
+    g_packet[4] = seg[0];
+    g_packet[5] = seg[1];
+    g_packet[6] = seg[2];
+    return kFrameHeaderSize;
+}
+
+size_t buildKeyFrame(const uint8_t *rgb, uint8_t count, uint8_t brightness, const uint8_t seg[3])
+{
+    size_t len = writeHeader(FRAME_KEY, count, brightness, seg);
+    memcpy(g_packet + len, rgb, (size_t)count * 3);
+    return len + (size_t)count * 3;
+}
+
+// 바뀐 픽셀만 담는다. delta가 key frame보다 커지면 0을 돌려준다.
+size_t buildDeltaFrame(const uint8_t *rgb, const uint8_t *last, uint8_t count, uint8_t brightness, const uint8_t seg[3], uint8_t &changed)
+{
+    size_t len = writeHeader(FRAME_DELTA, count, brightness, seg);
+    const size_t countPos = len++;
+    changed = 0;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        const uint8_t *px = rgb + i * 3;
+        if (memcmp(px, last + i * 3, 3) == 0)
+            continue;
+        if (len + 4 > kFrameHeaderSize + (size_t)count * 3)
+            return 0;
+        g_packet[len++] = i;
+        g_packet[len++] = px[0];
+        g_packet[len++] = px[1];
+        g_packet[len++] = px[2];
+        changed++;
+    }
+    g_packet[countPos] = changed;
+    return len;
+}
+} // namespace
+
+void frameStreamAttach(AsyncWebServer &server)
+{
+    wsFrames.onEvent(onFrameEvent);
+    server.addHandler(&wsFrames);
+}
+
+bool frameStreamActive()
+{
+    return g_clientCount.load(std::memory_order_relaxed) != 0;
+}
+
+void frameStreamPublish(const uint32_t *pixels, uint8_t count, uint8_t brightness, const uint8_t seg[3])
+{
+    if (count > kMaxFrameLeds)
+        count = kMaxFrameLeds;
+
+    uint8_t rgb[kMaxFrameLeds * 3];
+    for (uint8_t i = 0; i < count; i++)
+    {
+        rgb[i * 3] = (uint8_t)(pixels[i] >> 16);
+        rgb[i * 3 + 1] = (uint8_t)(pixels[i] >> 8);
+        rgb[i * 3 + 2] = (uint8_t)pixels[i];
+    }
+
+    g_seq++;
+    for (FrameClient &slot : g_clients)
+    {
+        const uint32_t id = slot.id.load();
+        if (id == 0)
+            continue;
+        // 큐가 차 있으면 이번 프레임은 건너뛴다. last를 갱신하지 않으므로
+        // 다음 delta가 밀린 변경분을 모두 담는다 (클라이언트 속도에 맞춘 스로틀).
+        if (!wsFrames.availableForWrite(id))
+            continue;
+
+        size_t len = 0;
+        if (slot.ownerId == id)
+        {
+            uint8_t changed = 0;
+            len = buildDeltaFrame(rgb, slot.last, count, brightness, seg, changed);
+            if (len != 0 && changed == 0 && slot.lastBrightness == brightness && memcmp(slot.lastSeg, seg, 3) == 0)
+                continue; // 변화 없음
+        }
+        if (len == 0)
+            len = buildKeyFrame(rgb, count, brightness, seg);
+
+        wsFrames.binary(id, g_packet, len);
+        slot.ownerId = id;
+        slot.lastBrightness = brightness;
+        memcpy(slot.lastSeg, seg, 3);
+        memcpy(slot.last, rgb, (size_t)count * 3);
+    }
+}
@@ -0,0 +1,558 @@
+#include "HistoryLog.h"
+#include <ESPAsyncWebServer.h>
+#include <LittleFS.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <memory>
+#include <time.h>
+#include "AllocTracker.h"
+#include "Config.h"
+#include "Metrics.h"
+#include "WebLogger.h"
+#include "hal/Hal.h"
+
+namespace
+{
+constexpr uint32_t kSegmentMagic = 0x31545348; // "HST1"
+constexpr uint8_t kSegmentCount = 8;
+constexpr size_t kSegmentBytes = 4096;          // 플래시 한 블록
+constexpr time_t kValidEpoch = 1600000000;
+constexpr size_t kSummaryDays = 64;             // 요약을 유지하는 최근 일수 (약 9주)
+constexpr size_t kMaxEventsPerQuery = 4096;
+constexpr size_t kReadBatch = 32;               // 이벤트 조회 시 한 번에 읽는 레코드 수
+constexpr size_t kQueueDepth = 8;               // 기록 태스크가 파일에 덧붙이기 전까지 담아 두는 레코드 수
+
+struct __attribute__((packed)) HistoryRecord
+{
+    uint32_t epoch; // 0이면 벽시계가 없던 때 (요약에서 제외)
+    uint8_t type;
+    uint8_t preset;
+    uint16_t value;
+};
+static_assert(sizeof(HistoryRecord) == 8, "record layout is the on-flash format");
+
+// 세그먼트 첫 8바이트. seq가 가장 큰 세그먼트가 현재 쓰는 세그먼트다.
+struct __attribute__((packed)) SegmentHeader
+{
+    uint32_t magic;
+    uint32_t seq;
+};
+static_assert(sizeof(SegmentHeader) == sizeof(HistoryRecord), "header occupies one record slot");
+
+constexpr size_t kSegmentRecords = (kSegmentBytes - sizeof(SegmentHeader)) / sizeof(HistoryRecord);
+
+struct DaySummary
+{
+    int32_t day = -1; // 1970-01-01부터의 로컬 날짜 수
+    uint16_t workMinutes = 0;
+    uint16_t restMinutes = 0;
+    uint16_t timerMinutes = 0;
+    uint8_t workSessions = 0;
+    uint8_t restSessions = 0;
+    uint8_t timerRuns = 0;
+    uint8_t counterResets = 0;
+    uint32_t counted = 0;
+};
+
+SemaphoreHandle_t g_lock = nullptr; // 세그먼트 파일과 요약은 기록 태스크와 async_tcp(조회)가 함께 본다
+uint32_t g_segSeq[kSegmentCount] = {};   // 0이면 비어 있거나 깨진 세그먼트
+uint16_t g_segCount[kSegmentCount] = {}; // 세그먼트별 레코드 수
+uint8_t g_head = 0;
+uint32_t g_nextSeq = 1;
+std::atomic<bool> g_ready{false}; // 부팅 때 저장소 태스크가 올린다
+QueueHandle_t g_queue = nullptr;   // historyRecord(loop) → 기록 태스크
+DaySummary g_summary[kSummaryDays];
+
+class HistoryLock
+{
+public:
+    HistoryLock() { xSemaphoreTake(g_lock, portMAX_DELAY); }
+    ~HistoryLock() { xSemaphoreGive(g_lock); }
+};
+
+void segmentPath(char *buf, size_t size, uint8_t index)
+{
+    snprintf(buf, size, "/hist%u.bin", (unsigned)index);
+}
+
+int32_t daysFromCivil(int y, unsigned m, unsigned d)
+{
+    y -= m <= 2;
+    const int era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = (unsigned)(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (int32_t)doe - 719468;
+}
+
+void civilFromDays(int32_t z, int &y, unsigned &m, unsigned &d)
+{
+    z += 719468;
+    const int32_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = (unsigned)(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp < 10 ? mp + 3 : mp - 9;
+    y = (int)yoe + era * 400 + (m <= 2);
+}
+
+int32_t localDay(time_t epoch)
+{
+    struct tm local;
+    localtime_r(&epoch, &local);
+    return daysFromCivil(local.tm_year + 1900, (unsigned)local.tm_mon + 1, (unsigned)local.tm_mday);
+}
+
+template <typename T>
+void addSaturating(T &field, uint32_t amount)
+{
+    const uint32_t limit = (T)~(T)0;
+    field = (T)min<uint32_t>((uint32_t)field + amount, limit);
+}
+
+void summarize(const HistoryRecord &r)
+{
+    if (r.epoch < kValidEpoch)
+        return;
+    const int32_t day = localDay((time_t)r.epoch);
+    DaySummary &s = g_summary[(uint32_t)day % kSummaryDays];
+    if (s.day != day)
+    {
+        if (s.day > day)
+            return; // 요약 범위보다 오래된 기록
+        s = DaySummary();
+        s.day = day;
+    }
+
+    switch (r.type)
+    {
+    case HISTORY_POMO_WORK:
+        addSaturating(s.workSessions, 1);
+        addSaturating(s.workMinutes, r.value);
+        break;
+    case HISTORY_POMO_REST:
+        addSaturating(s.restSessions, 1);
+        addSaturating(s.restMinutes, r.value);
+        break;
+    case HISTORY_TIMER:
+        addSaturating(s.timerRuns, 1);
+        addSaturating(s.timerMinutes, (r.value + 30) / 60);
+        break;
+    case HISTORY_COUNTER:
+        addSaturating(s.counterResets, 1);
+        s.counted += r.value;
+        break;
+    }
+}
+
+bool readSegment(uint8_t index)
+{
+    char path[16];
+    segmentPath(path, sizeof(path), index);
+    g_segSeq[index] = 0;
+    g_segCount[index] = 0;
+    if (!LittleFS.exists(path))
+        return false;
+
+    File f = LittleFS.open(path, "r");
+    if (!f)
+        return false;
+    SegmentHeader header;
+    const size_t size = f.size();
+    const bool ok = f.read(reinterpret_cast<uint8_t *>(&header), sizeof(header)) == sizeof(header) && header.magic == kSegmentMagic;
+    f.close();
+    if (!ok)
+        return false;
+
+    g_segSeq[index] = header.seq;
+    // 쓰다가 전원이 나간 반쪽 레코드는 버리고, 이 세그먼트에는 더 덧붙이지 않는다
+    const size_t body = size - sizeof(header);
+    g_segCount[index] = (body % sizeof(HistoryRecord) == 0) ? (uint16_t)(body / sizeof(HistoryRecord)) : (uint16_t)kSegmentRecords;
+    g_segCount[index] = min<uint16_t>(g_segCount[index], kSegmentRecords);
+    return true;
+}
+
+void summarizeSegment(uint8_t index)
+{
+    char path[16];
+    segmentPath(path, sizeof(path), index);
+    File f = LittleFS.open(path, "r");
+    if (!f)
+        return;
+    f.seek(sizeof(SegmentHeader));
+    HistoryRecord batch[kReadBatch];
+    size_t left = g_segCount[index];
+    while (left > 0)
+    {
+        const size_t want = min(left, kReadBatch);
+        const size_t got = f.read(reinterpret_cast<uint8_t *>(batch), want * sizeof(HistoryRecord)) / sizeof(HistoryRecord);
+        for (size_t i = 0; i < got; i++)
+            summarize(batch[i]);
+        if (got < want)
+            break;
+        left -= got;
+    }
+    f.close();
+}
+
+// 다음 세그먼트를 비우고 헤더를 쓴다 (가장 오래된 기록이 통째로 사라진다)
+bool startSegment(uint8_t index)
+{
+    char path[16];
+    segmentPath(path, sizeof(path), index);
+    File f = LittleFS.open(path, "w");
+    if (!f)
+        return false;
+    const SegmentHeader header = {kSegmentMagic, g_nextSeq};
+    const bool ok = f.write(reinterpret_cast<const uint8_t *>(&header), sizeof(header)) == sizeof(header);
+    f.close();
+    if (!ok)
+        return false;
+    g_head = index;
+    g_segSeq[index] = g_nextSeq++;
+    g_segCount[index] = 0;
+    return true;
+}
+
+// 기록 태스크에서만: 세그먼트가 차면 다음 세그먼트를 새로 쓰므로 플래시 지우기만큼 걸릴 수 있다
+void appendRecord(const HistoryRecord &r)
+{
+    AllocScope scope(ALLOC_HISTORY);
+    HistoryLock lock;
+    if (g_segCount[g_head] >= kSegmentRecords && !startSegment((uint8_t)((g_head + 1) % kSegmentCount)))
+    {
+        WEBLOG_WARN("[History] Segment rotate failed");
+        return;
+    }
+
+    char path[16];
+    segmentPath(path, sizeof(path), g_head);
+    File f = LittleFS.open(path, "a");
+    if (!f || f.write(reinterpret_cast<const uint8_t *>(&r), sizeof(r)) != sizeof(r))
+    {
+        if (f)
+            f.close();
+        WEBLOG_WARN("[History] Write failed");
+        return;
+    }
+    f.close();
+    g_segCount[g_head]++;
+    summarize(r);
+}
+
+void writerTask(void *)
+{
+    HistoryRecord r;
+    for (;;)
+    {
+        if (xQueueReceive(g_queue, &r, portMAX_DELAY) == pdTRUE)
+            appendRecord(r);
+    }
+}
+
+const char *typeName(uint8_t type)
+{
+    switch (type)
+    {
+    case HISTORY_POMO_WORK:
+        return "pomo_work";
+    case HISTORY_POMO_REST:
+        return "pomo_rest";
+    case HISTORY_TIMER:
+        return "timer";
+    case HISTORY_COUNTER:
+        return "counter";
+    }
+    return "unknown";
+}
+
+// ---- 조회 ----
+// 응답은 청크로 흘려보낸다. 요약은 요청 시점에 복사해 두고, 원본 이벤트는 최신부터 조금씩 읽는다.
+
+enum HistoryView : uint8_t
+{
+    VIEW_DAY,
+    VIEW_WEEK,
+    VIEW_EVENTS
+};
+
+struct HistoryCursor
+{
+    HistoryView view = VIEW_DAY;
+    DaySummary rows[kSummaryDays];
+    size_t rowCount = 0;
+    size_t row = 0;
+
+    // 이벤트: 최신 세그먼트부터 거꾸로
+    uint8_t segStep = 0;   // g_head에서 몇 세그먼트 전인지
+    int32_t recIndex = -1; // 현재 세그먼트에서 다음에 읽을 레코드 (-1이면 세그먼트 시작 전)
+    uint32_t segSeq = 0;   // 읽는 중 세그먼트가 새로 쓰이면 멈춘다
+    size_t eventsLeft = 0;
+    HistoryRecord batch[kReadBatch];
+    size_t batchLen = 0;
+    size_t batchPos = 0;
+
+    bool opened = false;
+    bool closed = false;
+    bool first = true;
+    char buf[192];
+    size_t len = 0;
+    size_t pos = 0;
+
+    bool nextRecord(HistoryRecord &out)
+    {
+        while (batchPos == batchLen)
+        {
+            if (eventsLeft == 0 || segStep >= kSegmentCount)
+                return false;
+            HistoryLock lock;
+            const uint8_t index = (uint8_t)((g_head + kSegmentCount - segStep) % kSegmentCount);
+            if (recIndex < 0)
+            {
+                // 새 세그먼트로 넘어가기: 비었거나 순서가 끊기면 끝
+                if (g_segSeq[index] == 0 || (segSeq != 0 && g_segSeq[index] != segSeq - 1))
+                    return false;
+                segSeq = g_segSeq[index];
+                recIndex = (int32_t)g_segCount[index] - 1;
+                if (recIndex < 0)
+                {
+                    segStep++;
+                    continue;
+                }
+            }
+            else if (g_segSeq[index] != segSeq)
+            {
+                return false; // 조회 중 덮어써졌다
+            }
+
+            const size_t want = min<size_t>(min<size_t>(kReadBatch, (size_t)recIndex + 1), eventsLeft);
+            const size_t startRec = (size_t)recIndex + 1 - want;
+            char path[16];
+            segmentPath(path, sizeof(path), index);
+            File f = LittleFS.open(path, "r");
+            if (!f || !f.seek(sizeof(SegmentHeader) + startRec * sizeof(HistoryRecord)))
+                return false;
+            batchLen = f.read(reinterpret_cast<uint8_t *>(batch), want * sizeof(HistoryRecord)) / sizeof(HistoryRecord);
+            f.close();
+            if (batchLen != want)
+                return false;
+            // 최신이 먼저 나가도록 뒤집는다
+            for (size_t i = 0; i < batchLen / 2; i++)
+                std::swap(batch[i], batch[batchLen - 1 - i]);
+            batchPos = 0;
+            recIndex -= (int32_t)want;
+            if (recIndex < 0)
+                segStep++;
+        }
+        out = batch[batchPos++];
+        eventsLeft--;
+        return true;
+    }
+
+    int formatRow(const DaySummary &s)
+    {
+        int y;
+        unsigned m, d;
+        civilFromDays(s.day, y, m, d);
+        return snprintf(buf, sizeof(buf),
+                        "%s{\"date\":\"%04d-%02u-%02u\",\"work\":%u,\"workMin\":%u,\"rest\":%u,\"restMin\":%u,"
+                        "\"timers\":%u,\"timerMin\":%u,\"counters\":%u,\"counted\":%lu}",
+                        first ? "" : ",", y, m, d, (unsigned)s.workSessions, (unsigned)s.workMinutes,
+                        (unsigned)s.restSessions, (unsigned)s.restMinutes, (unsigned)s.timerRuns,
+                        (unsigned)s.timerMinutes, (unsigned)s.counterResets, (unsigned long)s.counted);
+    }
+
+    int formatItem()
+    {
+        if (view == VIEW_EVENTS)
+        {
+            HistoryRecord r;
+            if (!nextRecord(r))
+                return 0;
+            return snprintf(buf, sizeof(buf), "%s{\"t\":%lu,\"type\":\"%s\",\"preset\":%u,\"value\":%u}", first ? "" : ",",
+                            (unsigned long)r.epoch, typeName(r.type), (unsigned)r.preset, (unsigned)r.value);
+        }
+        if (row < rowCount)
+            return formatRow(rows[row++]);
+        return 0;
+    }
+
+    // 다음 조각을 buf에 채운다. 끝이면 false.
+    bool nextLine()
+    {
+        int n = 0;
+        if (!opened)
+        {
+            opened = true;
+            n = snprintf(buf, sizeof(buf), "{\"%s\":[", view == VIEW_EVENTS ? "events" : (view == VIEW_WEEK ? "weeks" : "days"));
+        }
+        else if (!closed)
+        {
+            n = formatItem();
+            if (n > 0)
+            {
+                first = false;
+            }
+            else
+            {
+                closed = true;
+                n = snprintf(buf, sizeof(buf), "]}");
+            }
+        }
+        if (n <= 0)
+            return false;
+        len = min((size_t)n, sizeof(buf) - 1);
+        pos = 0;
+        return true;
+    }
+
+    size_t fill(uint8_t *out, size_t maxLen)
+    {
+        size_t written = 0;
+        while (written < maxLen)
+        {
+            if (pos == len && !nextLine())
+                break;
+            const size_t n = min(len - pos, maxLen - written);
+            memcpy(out + written, buf + pos, n);
+            pos += n;
+            written += n;
+        }
+        return written;
+    }
+};
+} // namespace
+
+void historyBegin()
+{
+    if (!g_lock)
+        g_lock = xSemaphoreCreateMutex();
+    HistoryLock lock;
+
+    uint32_t newestSeq = 0;
+    for (uint8_t i = 0; i < kSegmentCount; i++)
+    {
+        if (readSegment(i) && g_segSeq[i] > newestSeq)
+        {
+            newestSeq = g_segSeq[i];
+            g_head = i;
+        }
+    }
+    g_nextSeq = newestSeq + 1;
+
+    // 세그먼트는 순환하며 쓰므로 head 다음부터가 오래된 순서다
+    size_t total = 0;
+    for (uint8_t step = 1; step <= kSegmentCount; step++)
+    {
+        const uint8_t index = (uint8_t)((g_head + step) % kSegmentCount);
+        if (g_segSeq[index] == 0)
+            continue;
+        summarizeSegment(index);
+        total += g_segCount[index];
+    }
+
+    bool ready = (newestSeq != 0) || startSegment(0);
+    if (ready && !g_queue)
+    {
+        // 로그 드레인과 같은 우선순위: loop가 양보할 때 파일에 덧붙인다
+        g_queue = xQueueCreate(kQueueDepth, sizeof(HistoryRecord));
+        ready = g_queue && xTaskCreate(writerTask, "histWrite", 4096, nullptr, 1, nullptr) == pdPASS;
+    }
+    g_ready = ready;
+    if (g_ready)
+        WEBLOG_INFO("[History] %u events in log", (unsigned)total);
+    else
+        WEBLOG_WARN("[History] Log unavailable");
+}
+
+void historyRecord(HistoryEventType type, uint32_t value)
+{
+    if (!g_ready)
+        return;
+
+    const time_t now = hal::wallTime();
+    HistoryRecord r;
+    r.epoch = (now >= kValidEpoch) ? (uint32_t)now : 0;
+    r.type = type;
+    r.preset = (uint8_t)appConfig.currentPresetIndex;
+    r.value = (uint16_t)min<uint32_t>(value, 0xFFFF);
+
+    // 타이머 만료 이벤트로 프레임 경로 안에서 불린다: 미리 잡아 둔 대기열에 복사만 하고 기다리지 않는다
+    if (xQueueSend(g_queue, &r, 0) != pdTRUE)
+        WEBLOG_WARN("[History] Queue full, event dropped");
+}
+
+void historyAttach(AsyncWebServer &server)
+{
+    // /history            최근 7일 일별 요약
+    // /history?days=N     최근 N일 (최대 64)
+    // /history?group=week 주별 합계 (월요일 시작)
+    // /history?events=N   원본 이벤트 최신순 N개
+    server.on("/history", HTTP_GET, [](AsyncWebServerRequest *request)
+              {
+        const uint32_t startUs = micros();
+        if (!g_ready)
+        {
+            request->send(503, "application/json", "{\"status\":\"error\",\"reason\":\"history_unavailable\"}");
+            return;
+        }
+
+        auto cursor = std::make_shared<HistoryCursor>();
+        if (request->hasParam("events"))
+        {
+            cursor->view = VIEW_EVENTS;
+            const long n = request->getParam("events")->value().toInt();
+            cursor->eventsLeft = (size_t)constrain(n, 1L, (long)kMaxEventsPerQuery);
+        }
+        else
+        {
+            const bool weekly = request->hasParam("group") && request->getParam("group")->value() == "week";
+            long days = request->hasParam("days") ? request->getParam("days")->value().toInt() : (weekly ? 28 : 7);
+            days = constrain(days, 1L, (long)kSummaryDays);
+            cursor->view = weekly ? VIEW_WEEK : VIEW_DAY;
+
+            const time_t now = hal::wallTime();
+            const int32_t today = (now >= kValidEpoch) ? localDay(now) : -1;
+            HistoryLock lock;
+            for (int32_t day = today - (int32_t)days + 1; today >= 0 && day <= today; day++)
+            {
+                const DaySummary &s = g_summary[(uint32_t)day % kSummaryDays];
+                if (s.day != day)
+                    continue;
+                if (!weekly)
+                {
+                    cursor->rows[cursor->rowCount++] = s;
+                    continue;
+                }
+                // 1970-01-01은 목요일: 그 주의 월요일로 묶는다
+                const int32_t monday = day - (day + 3) % 7;
+                if (cursor->rowCount == 0 || cursor->rows[cursor->rowCount - 1].day != monday)
+                {
+                    DaySummary &w = cursor->rows[cursor->rowCount++];
+                    w = DaySummary();
+                    w.day = monday;
+                }
+                DaySummary &w = cursor->rows[cursor->rowCount - 1];
+                addSaturating(w.workSessions, s.workSessions);
+                addSaturating(w.workMinutes, s.workMinutes);
+                addSaturating(w.restSessions, s.restSessions);
+                addSaturating(w.restMinutes, s.restMinutes);
+                addSaturating(w.timerRuns, s.timerRuns);
+                addSaturating(w.timerMinutes, s.timerMinutes);
+                addSaturating(w.counterResets, s.counterResets);
+                w.counted += s.counted;
+            }
+        }
+
+        AsyncWebServerResponse *response = request->beginChunkedResponse(
+            "application/json",
+            [cursor](uint8_t *buffer, size_t maxLen, size_t index) -> size_t
+            { return cursor->fill(buffer, maxLen); });
+        request->send(response);
+        metricsRecordHttp(ROUTE_HISTORY, micros() - startUs); });
+}
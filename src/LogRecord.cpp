@@ -0,0 +1,282 @@
+#include "LogRecord.h"
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+constexpr const char *kTruncatedMark = "...";
+
+// 기록된 인자를 앞에서부터 읽는다.
+class LogArgReader
+{
+public:
+    explicit LogArgReader(const LogRecord &record) : _p(record.args), _end(record.args + record.argLen) {}
+
+    bool read(void *out, size_t size)
+    {
+        if ((size_t)(_end - _p) < size)
+            return false;
+        memcpy(out, _p, size);
+        _p += size;
+        return true;
+    }
+
+    bool readString(const char *&text, int &len)
+    {
+        if (_p >= _end || (size_t)(_end - _p - 1) < *_p)
+            return false;
+        len = *_p++;
+        text = reinterpret_cast<const char *>(_p);
+        _p += len;
+        return true;
+    }
+
+    bool readInt(int &out)
+    {
+        int32_t word;
+        if (!read(&word, sizeof(word)))
+            return false;
+        out = word;
+        return true;
+    }
+
+private:
+    const uint8_t *_p;
+    const uint8_t *_end;
+};
+
+class LineWriter
+{
+public:
+    LineWriter(char *out, size_t size) : _out(out), _size(size) { _out[0] = '\0'; }
+
+    void append(const char *text, size_t len)
+    {
+        if (_len + len >= _size)
+            len = _size - 1 - _len;
+        memcpy(_out + _len, text, len);
+        _len += len;
+        _out[_len] = '\0';
+    }
+
+    template <typename... Args>
+    void appendf(const char *spec, Args... args)
+    {
+        const int n = snprintf(_out + _len, _size - _len, spec, args...);
+        if (n > 0)
+            _len += ((size_t)n < _size - _len) ? (size_t)n : _size - 1 - _len;
+    }
+
+    size_t length() const { return _len; }
+
+private:
+    char *_out;
+    size_t _size;
+    size_t _len = 0;
+};
+
+// 길이 수식어가 가리키는 정수의 기록 크기 (4바이트 미만은 기록 때 4로 올라가 있다)
+size_t integerSize(const char *length)
+{
+    if (strcmp(length, "l") == 0)
+        return sizeof(long);
+    if (strcmp(length, "ll") == 0 || strcmp(length, "j") == 0)
+        return 8;
+    if (strcmp(length, "z") == 0)
+        return sizeof(size_t);
+    if (strcmp(length, "t") == 0)
+        return sizeof(ptrdiff_t);
+    return 4;
+}
+
+bool formatInteger(LogArgReader &args, LineWriter &line, const char *prefix, const char *length, char conversion)
+{
+    const size_t size = integerSize(length);
+    const bool isSigned = conversion == 'd' || conversion == 'i';
+    long long value;
+    if (size == 8)
+    {
+        uint64_t word;
+        if (!args.read(&word, sizeof(word)))
+            return false;
+        value = (long long)word;
+    }
+    else
+    {
+        uint32_t word;
+        if (!args.read(&word, sizeof(word)))
+            return false;
+        value = isSigned ? (long long)(int32_t)word : (long long)word;
+    }
+
+    // h/hh는 printf처럼 잘라서 보여 준다
+    if (strcmp(length, "hh") == 0)
+        value = isSigned ? (long long)(signed char)value : (long long)(unsigned char)value;
+    else if (strcmp(length, "h") == 0)
+        value = isSigned ? (long long)(short)value : (long long)(unsigned short)value;
+
+    char spec[24];
+    snprintf(spec, sizeof(spec), "%sll%c", prefix, conversion);
+    if (isSigned)
+        line.appendf(spec, value);
+    else
+        line.appendf(spec, (unsigned long long)value);
+    return true;
+}
+} // namespace
+
+size_t logRecordFormat(const LogRecord &record, char *out, size_t size)
+{
+    LineWriter line(out, size);
+    LogArgReader args(record);
+    bool missing = false;
+
+    const char *p = record.format;
+    while (*p && !missing)
+    {
+        const char *percent = strchr(p, '%');
+        if (percent == nullptr)
+        {
+            line.append(p, strlen(p));
+            break;
+        }
+        line.append(p, percent - p);
+        p = percent + 1;
+        if (*p == '%')
+        {
+            line.append("%", 1);
+            p++;
+            continue;
+        }
+
+        // "%[flags][width][.precision]" 부분을 다시 조립한다 ('*'는 기록된 값으로 바꾼다)
+        char prefix[16] = "%";
+        size_t prefixLen = 1;
+        auto addPrefix = [&](const char *text, size_t len)
+        {
+            if (prefixLen + len < sizeof(prefix))
+            {
+                memcpy(prefix + prefixLen, text, len);
+                prefixLen += len;
+                prefix[prefixLen] = '\0';
+            }
+        };
+        auto addNumber = [&](const char *&cursor)
+        {
+            if (*cursor == '*')
+            {
+                int value = 0;
+                missing = missing || !args.readInt(value);
+                char digits[12];
+                addPrefix(digits, snprintf(digits, sizeof(digits), "%d", value));
+                cursor++;
+                return;
+            }
+            const char *start = cursor;
+            while (*cursor >= '0' && *cursor <= '9')
+                cursor++;
+            addPrefix(start, cursor - start);
+        };
+
+        const char *flags = p;
+        while (*p && strchr("-+ #0", *p))
+            p++;
+        addPrefix(flags, p - flags);
+        addNumber(p);
+        if (*p == '.')
+        {
+            addPrefix(".", 1);
+            p++;
+            addNumber(p);
+        }
+
+        char length[3] = "";
+        for (size_t i = 0; i < 2 && *p && strchr("hljztL", *p); i++)
+            length[i] = *p++;
+
+        const char conversion = *p;
+        if (conversion == '\0' || missing)
+            break;
+        p++;
+
+        switch (conversion)
+        {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+            missing = !formatInteger(args, line, prefix, length, conversion);
+            break;
+        case 'c':
+        {
+            int value;
+            missing = !args.readInt(value);
+            if (!missing)
+            {
+                addPrefix("c", 1);
+                line.appendf(prefix, value);
+            }
+            break;
+        }
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+        {
+            double value;
+            missing = !args.read(&value, sizeof(value));
+            if (!missing)
+            {
+                addPrefix(&conversion, 1);
+                line.appendf(prefix, value);
+            }
+            break;
+        }
+        case 's':
+        {
+            const char *text;
+            int len;
+            missing = !args.readString(text, len);
+            if (!missing)
+            {
+                // 기록된 문자열은 0으로 끝나지 않는다: 정밀도로 길이를 준다 (원래 정밀도가 더 짧으면 그쪽)
+                const char *dot = strchr(prefix, '.');
+                if (dot != nullptr)
+                {
+                    const int precision = atoi(dot + 1);
+                    if (precision < len)
+                        len = precision;
+                    prefixLen = dot - prefix;
+                    prefix[prefixLen] = '\0';
+                }
+                addPrefix(".*s", 3);
+                line.appendf(prefix, len, text);
+            }
+            break;
+        }
+        case 'p':
+        {
+            uintptr_t value;
+            missing = !args.read(&value, sizeof(value));
+            if (!missing)
+                line.appendf("%p", (void *)value);
+            break;
+        }
+        default:
+            // 모르는 변환은 글자 그대로
+            line.append(percent, p - percent);
+            break;
+        }
+    }
+
+    if (missing || record.truncated)
+        line.append(kTruncatedMark, strlen(kTruncatedMark));
+    return line.length();
+}
@@ -0,0 +1,382 @@
+#include "Metrics.h"
+#include <ESPAsyncWebServer.h>
+#include <WiFi.h>
+#include <atomic>
+#include <memory>
+#include "WebLogger.h"
+#include "AllocTracker.h"
+#include "hal/Hal.h"
+#include "SyncManager.h"
+#include "WifiLink.h"
+#include "managers/DisplayManager.h"
+
+extern DisplayManager display;
+extern AsyncWebSocket wsLog;
+extern AsyncWebSocket wsFrames;
+extern AsyncWebSocket wsCtrl;
+extern AsyncWebSocket wsState;
+
+namespace
+{
+// 지연 히스토그램 버킷 상한 (us). 마지막 +Inf는 count로 대신한다.
+constexpr uint32_t kLatencyBucketsUs[] = {1000, 5000, 25000, 100000, 500000};
+constexpr size_t kLatencyBucketCount = sizeof(kLatencyBucketsUs) / sizeof(kLatencyBucketsUs[0]);
+
+constexpr const char *kRouteNames[ROUTE_COUNT] = {
+    "/get-config", "/set-config", "/fw-info", "/fw-upload", "/fs-upload",
+    "/ota/begin", "/ota/chunk", "/ota/commit", "/ota/status", "/ota/abort", "/metrics", "/history", "/alloc", "/topology", "/boot-trace"};
+
+// 스택 여유를 보고할 태스크 (없는 태스크는 건너뛴다)
+constexpr const char *kTaskNames[] = {"loopTask", "async_tcp", "logDrain", "tiT", "wifi", "IDLE"};
+constexpr size_t kTaskCount = sizeof(kTaskNames) / sizeof(kTaskNames[0]);
+
+struct RouteStats
+{
+    std::atomic<uint32_t> count{0};
+    std::atomic<uint32_t> latencyUsTotal{0};
+    std::atomic<uint32_t> buckets[kLatencyBucketCount] = {};
+};
+
+RouteStats g_routes[ROUTE_COUNT];
+std::atomic<uint32_t> g_nvsWrites{0};
+std::atomic<uint32_t> g_nvsWriteBytes{0};
+
+// ---- 렌더링 ----
+// 한 줄씩 만들어 청크 응답 버퍼로 복사한다. 응답마다 커서 하나만 잡으므로
+// 메모리는 지표 개수나 누적 기록과 무관하게 일정하다.
+
+enum MetricFamily : uint8_t
+{
+    FAMILY_UPTIME = 0,
+    FAMILY_HEAP_FREE,
+    FAMILY_HEAP_MIN_FREE,
+    FAMILY_HEAP_LARGEST_BLOCK,
+    FAMILY_TASK_STACK,
+    FAMILY_WIFI_RSSI,
+    FAMILY_WIFI_RECONNECTS,
+    FAMILY_WIFI_CACHED_CONNECTS,
+    FAMILY_WIFI_CONNECT_SECONDS,
+    FAMILY_WIFI_OUTAGES,
+    FAMILY_WIFI_OUTAGE_SECONDS,
+    FAMILY_NVS_WRITES,
+    FAMILY_NVS_WRITE_BYTES,
+    FAMILY_HTTP_REQUESTS,
+    FAMILY_HTTP_LATENCY,
+    FAMILY_WS_CLIENTS,
+    FAMILY_LOG_DROPPED,
+    FAMILY_DISPLAY_UPDATES,
+    FAMILY_DISPLAY_UPDATE_SECONDS,
+    FAMILY_DISPLAY_UPDATE_MAX,
+    FAMILY_DISPLAY_COMMITTED,
+    FAMILY_DISPLAY_STREAMED,
+    FAMILY_FRAME_ALLOCATIONS,
+    FAMILY_SEGMENT_PWM_TICKS,
+    FAMILY_SEGMENT_PWM_SECONDS,
+    FAMILY_SYNC_ROLE,
+    FAMILY_SYNC_LOCKED,
+    FAMILY_SYNC_SKEW,
+    FAMILY_SYNC_BEACONS,
+    FAMILY_COUNT
+};
+
+struct FamilyInfo
+{
+    const char *name;
+    const char *type;
+    const char *help;
+};
+
+constexpr FamilyInfo kFamilies[FAMILY_COUNT] = {
+    {"timetape_uptime_seconds", "counter", "Seconds since boot"},
+    {"timetape_heap_free_bytes", "gauge", "Free heap"},
+    {"timetape_heap_min_free_bytes", "gauge", "Lowest free heap since boot"},
+    {"timetape_heap_largest_free_block_bytes", "gauge", "Largest allocatable heap block"},
+    {"timetape_task_stack_high_water_bytes", "gauge", "Minimum free stack per task since start"},
+    {"timetape_wifi_rssi_dbm", "gauge", "WiFi signal strength"},
+    {"timetape_wifi_reconnects_total", "counter", "WiFi reconnections after the first connection"},
+    {"timetape_wifi_cached_connects_total", "counter", "WiFi connections made to the cached BSSID/channel without a scan"},
+    {"timetape_wifi_last_connect_seconds", "gauge", "Time from the last connection attempt to an IP address"},
+    {"timetape_wifi_outages_total", "counter", "WiFi link losses after a connection"},
+    {"timetape_wifi_outage_seconds_total", "counter", "Time spent disconnected after a connection (includes a current outage)"},
+    {"timetape_nvs_writes_total", "counter", "NVS put operations"},
+    {"timetape_nvs_write_bytes_total", "counter", "Bytes written to NVS"},
+    {"timetape_http_requests_total", "counter", "HTTP requests handled per route"},
+    {"timetape_http_request_duration_seconds", "histogram", "HTTP handler latency per route"},
+    {"timetape_ws_clients", "gauge", "Connected WebSocket clients per channel"},
+    {"timetape_log_dropped_total", "counter", "Log lines dropped by the ring buffer or rate limit"},
+    {"timetape_display_updates_total", "counter", "DisplayManager::update calls"},
+    {"timetape_display_update_seconds_total", "counter", "Time spent in DisplayManager::update (wraps after ~71 min)"},
+    {"timetape_display_update_max_seconds", "gauge", "Slowest DisplayManager::update since boot"},
+    {"timetape_display_frames_committed_total", "counter", "Frames committed via endFrame"},
+    {"timetape_display_frames_streamed_total", "counter", "Frames published to /ws/frames"},
+    {"timetape_frame_heap_allocations_total", "counter", "Heap allocations on the frame path (expected to stay 0)"},
+    {"timetape_segment_pwm_interrupts_total", "counter", "7-segment dimming timer interrupts"},
+    {"timetape_segment_pwm_busy_seconds_total", "counter", "Time spent in the 7-segment dimming interrupt (wraps after ~71 min)"},
+    {"timetape_sync_role", "gauge", "Multi-device sync role (0 off, 1 leader, 2 follower)"},
+    {"timetape_sync_locked", "gauge", "Follower is phase-locked to a leader"},
+    {"timetape_sync_skew_bound_seconds", "gauge", "Spread of recent leader clock offsets (upper bound on render skew)"},
+    {"timetape_sync_beacons_total", "counter", "Sync beacons sent (leader) or received (follower)"},
+};
+
+constexpr size_t kHttpLatencySamplesPerRoute = kLatencyBucketCount + 3; // 버킷들, +Inf, _sum, _count
+constexpr size_t kLineMax = 160;
+
+size_t familySampleCount(uint8_t family)
+{
+    switch (family)
+    {
+    case FAMILY_TASK_STACK:
+        return kTaskCount;
+    case FAMILY_HTTP_REQUESTS:
+        return ROUTE_COUNT;
+    case FAMILY_HTTP_LATENCY:
+        return ROUTE_COUNT * kHttpLatencySamplesPerRoute;
+    case FAMILY_WS_CLIENTS:
+        return 4;
+    default:
+        return 1;
+    }
+}
+
+int formatSeconds(char *buf, size_t size, uint32_t us)
+{
+    return snprintf(buf, size, "%lu.%06lu", (unsigned long)(us / 1000000UL), (unsigned long)(us % 1000000UL));
+}
+
+int formatValue(char *buf, size_t size, const char *name, uint32_t value)
+{
+    return snprintf(buf, size, "%s %lu\n", name, (unsigned long)value);
+}
+
+int formatHttpLatency(char *buf, size_t size, const char *name, size_t index)
+{
+    const size_t route = index / kHttpLatencySamplesPerRoute;
+    const size_t item = index % kHttpLatencySamplesPerRoute;
+    const RouteStats &stats = g_routes[route];
+    const char *routeName = kRouteNames[route];
+
+    if (item < kLatencyBucketCount)
+    {
+        // Prometheus 버킷은 누적값
+        uint32_t cumulative = 0;
+        for (size_t b = 0; b <= item; b++)
+            cumulative += stats.buckets[b].load(std::memory_order_relaxed);
+        char le[16];
+        formatSeconds(le, sizeof(le), kLatencyBucketsUs[item]);
+        return snprintf(buf, size, "%s_bucket{route=\"%s\",le=\"%s\"} %lu\n", name, routeName, le, (unsigned long)cumulative);
+    }
+    const uint32_t count = stats.count.load(std::memory_order_relaxed);
+    if (item == kLatencyBucketCount)
+        return snprintf(buf, size, "%s_bucket{route=\"%s\",le=\"+Inf\"} %lu\n", name, routeName, (unsigned long)count);
+    if (item == kLatencyBucketCount + 1)
+    {
+        char sum[24];
+        formatSeconds(sum, sizeof(sum), stats.latencyUsTotal.load(std::memory_order_relaxed));
+        return snprintf(buf, size, "%s_sum{route=\"%s\"} %s\n", name, routeName, sum);
+    }
+    return snprintf(buf, size, "%s_count{route=\"%s\"} %lu\n", name, routeName, (unsigned long)count);
+}
+
+// 샘플 한 줄. 0을 돌려주면 (예: 없는 태스크) 그 샘플은 건너뛴다.
+int formatSample(char *buf, size_t size, uint8_t family, size_t index)
+{
+    const char *name = kFamilies[family].name;
+    const DisplayStats &ds = display.stats();
+    char seconds[24];
+
+    switch (family)
+    {
+    case FAMILY_UPTIME:
+        return formatValue(buf, size, name, millis() / 1000);
+    case FAMILY_HEAP_FREE:
+        return formatValue(buf, size, name, ESP.getFreeHeap());
+    case FAMILY_HEAP_MIN_FREE:
+        return formatValue(buf, size, name, ESP.getMinFreeHeap());
+    case FAMILY_HEAP_LARGEST_BLOCK:
+        return formatValue(buf, size, name, ESP.getMaxAllocHeap());
+    case FAMILY_TASK_STACK:
+    {
+        TaskHandle_t task = xTaskGetHandle(kTaskNames[index]);
+        if (task == nullptr)
+            return 0;
+        return snprintf(buf, size, "%s{task=\"%s\"} %lu\n", name, kTaskNames[index],
+                        (unsigned long)uxTaskGetStackHighWaterMark(task));
+    }
+    case FAMILY_WIFI_RSSI:
+        if (WiFi.status() != WL_CONNECTED)
+            return 0;
+        return snprintf(buf, size, "%s %d\n", name, (int)WiFi.RSSI());
+    case FAMILY_WIFI_RECONNECTS:
+    case FAMILY_WIFI_CACHED_CONNECTS:
+    case FAMILY_WIFI_CONNECT_SECONDS:
+    case FAMILY_WIFI_OUTAGES:
+    case FAMILY_WIFI_OUTAGE_SECONDS:
+    {
+        WifiLinkStats link;
+        wifiLinkGetStats(link);
+        if (family == FAMILY_WIFI_RECONNECTS)
+            return formatValue(buf, size, name, link.connects > 0 ? link.connects - 1 : 0);
+        if (family == FAMILY_WIFI_CACHED_CONNECTS)
+            return formatValue(buf, size, name, link.cachedConnects);
+        if (family == FAMILY_WIFI_OUTAGES)
+            return formatValue(buf, size, name, link.outages);
+        const uint32_t ms = (family == FAMILY_WIFI_CONNECT_SECONDS) ? link.lastConnectMs : link.outageMsTotal;
+        return snprintf(buf, size, "%s %lu.%03lu\n", name, (unsigned long)(ms / 1000), (unsigned long)(ms % 1000));
+    }
+    case FAMILY_NVS_WRITES:
+        return formatValue(buf, size, name, g_nvsWrites.load(std::memory_order_relaxed));
+    case FAMILY_NVS_WRITE_BYTES:
+        return formatValue(buf, size, name, g_nvsWriteBytes.load(std::memory_order_relaxed));
+    case FAMILY_HTTP_REQUESTS:
+        return snprintf(buf, size, "%s{route=\"%s\"} %lu\n", name, kRouteNames[index],
+                        (unsigned long)g_routes[index].count.load(std::memory_order_relaxed));
+    case FAMILY_HTTP_LATENCY:
+        return formatHttpLatency(buf, size, name, index);
+    case FAMILY_WS_CLIENTS:
+    {
+        static const char *const kChannels[4] = {"log", "frames", "ctrl", "state"};
+        const AsyncWebSocket *sockets[4] = {&wsLog, &wsFrames, &wsCtrl, &wsState};
+        return snprintf(buf, size, "%s{channel=\"%s\"} %u\n", name, kChannels[index], (unsigned)sockets[index]->count());
+    }
+    case FAMILY_LOG_DROPPED:
+        return formatValue(buf, size, name, webLogDroppedCount());
+    case FAMILY_DISPLAY_UPDATES:
+        return formatValue(buf, size, name, ds.updates.load(std::memory_order_relaxed));
+    case FAMILY_DISPLAY_UPDATE_SECONDS:
+        formatSeconds(seconds, sizeof(seconds), ds.updateUsTotal.load(std::memory_order_relaxed));
+        return snprintf(buf, size, "%s %s\n", name, seconds);
+    case FAMILY_DISPLAY_UPDATE_MAX:
+        formatSeconds(seconds, sizeof(seconds), ds.updateUsMax.load(std::memory_order_relaxed));
+        return snprintf(buf, size, "%s %s\n", name, seconds);
+    case FAMILY_DISPLAY_COMMITTED:
+        return formatValue(buf, size, name, ds.committed.load(std::memory_order_relaxed));
+    case FAMILY_DISPLAY_STREAMED:
+        return formatValue(buf, size, name, ds.streamed.load(std::memory_order_relaxed));
+    case FAMILY_FRAME_ALLOCATIONS:
+    {
+        AllocStats render;
+        allocGetStats(ALLOC_RENDER, render);
+        return formatValue(buf, size, name, render.allocs);
+    }
+    case FAMILY_SEGMENT_PWM_TICKS:
+    case FAMILY_SEGMENT_PWM_SECONDS:
+    {
+        uint32_t calls, busyUs;
+        hal::periodicIsrStats(calls, busyUs);
+        if (family == FAMILY_SEGMENT_PWM_TICKS)
+            return formatValue(buf, size, name, calls);
+        formatSeconds(seconds, sizeof(seconds), busyUs);
+        return snprintf(buf, size, "%s %s\n", name, seconds);
+    }
+    case FAMILY_SYNC_ROLE:
+    case FAMILY_SYNC_LOCKED:
+    case FAMILY_SYNC_SKEW:
+    case FAMILY_SYNC_BEACONS:
+    {
+        SyncStats sync;
+        syncGetStats(sync);
+        if (family == FAMILY_SYNC_ROLE)
+            return formatValue(buf, size, name, sync.role);
+        if (family == FAMILY_SYNC_LOCKED)
+            return formatValue(buf, size, name, sync.locked ? 1 : 0);
+        if (family == FAMILY_SYNC_SKEW)
+        {
+            formatSeconds(seconds, sizeof(seconds), sync.spreadMs * 1000UL);
+            return snprintf(buf, size, "%s %s\n", name, seconds);
+        }
+        return formatValue(buf, size, name, sync.role == SYNC_LEADER ? sync.beaconsSent : sync.beaconsReceived);
+    }
+    }
+    return 0;
+}
+
+struct MetricsCursor
+{
+    uint8_t family = 0;
+    size_t line = 0; // 0: HELP, 1: TYPE, 2..: 샘플
+    char buf[kLineMax];
+    size_t len = 0;
+    size_t pos = 0;
+
+    // 다음 줄을 buf에 채운다. 끝이면 false.
+    bool nextLine()
+    {
+        while (family < FAMILY_COUNT)
+        {
+            const FamilyInfo &info = kFamilies[family];
+            int n = 0;
+            if (line == 0)
+                n = snprintf(buf, sizeof(buf), "# HELP %s %s\n", info.name, info.help);
+            else if (line == 1)
+                n = snprintf(buf, sizeof(buf), "# TYPE %s %s\n", info.name, info.type);
+            else if (line - 2 < familySampleCount(family))
+                n = formatSample(buf, sizeof(buf), family, line - 2);
+            else
+            {
+                family++;
+                line = 0;
+                continue;
+            }
+            line++;
+            if (n <= 0)
+                continue;
+            len = min((size_t)n, sizeof(buf) - 1);
+            pos = 0;
+            return true;
+        }
+        return false;
+    }
+
+    size_t fill(uint8_t *out, size_t maxLen)
+    {
+        size_t written = 0;
+        while (written < maxLen)
+        {
+            if (pos == len && !nextLine())
+                break;
+            const size_t n = min(len - pos, maxLen - written);
+            memcpy(out + written, buf + pos, n);
+            pos += n;
+            written += n;
+        }
+        return written;
+    }
+};
+} // namespace
+
+void metricsRecordHttp(MetricsRoute route, uint32_t latencyUs)
+{
+    if (route >= ROUTE_COUNT)
+        return;
+    RouteStats &stats = g_routes[route];
+    stats.count.fetch_add(1, std::memory_order_relaxed);
+    stats.latencyUsTotal.fetch_add(latencyUs, std::memory_order_relaxed);
+    for (size_t b = 0; b < kLatencyBucketCount; b++)
+    {
+        if (latencyUs <= kLatencyBucketsUs[b])
+        {
+            stats.buckets[b].fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+    }
+}
+
+void metricsRecordNvsWrite(size_t bytes)
+{
+    g_nvsWrites.fetch_add(1, std::memory_order_relaxed);
+    g_nvsWriteBytes.fetch_add((uint32_t)bytes, std::memory_order_relaxed);
+}
+
+void metricsAttach(AsyncWebServer &server)
+{
+    server.on("/metrics", HTTP_GET, [](AsyncWebServerRequest *request)
+              {
+        const uint32_t startUs = micros();
+        auto cursor = std::make_shared<MetricsCursor>();
+        AsyncWebServerResponse *response = request->beginChunkedResponse(
+            "text/plain; version=0.0.4",
+            [cursor](uint8_t *buffer, size_t maxLen, size_t index) -> size_t
+            { return cursor->fill(buffer, maxLen); });
+        request->send(response);
+        metricsRecordHttp(ROUTE_METRICS, micros() - startUs); });
+}
@@ -1,5 +1,4 @@
 #include "NetworkManager.h"
-#include <WiFiManager.h>
 #include <ESPAsyncWebServer.h>
 #include <LittleFS.h>
 #include <ESPmDNS.h>
@@ -8,6 +7,18 @@
 #include "Config.h"
 #include "ConfigCodec.h"
 #include "WebLogger.h"
+#include "FrameStream.h"
+#include "RemoteControl.h"
+#include "OtaInflater.h"
+#include "OtaSession.h"
+#include "Metrics.h"
+#include "StateStream.h"
+#include "Scheduler.h"
+#include "managers/InteractiveManager.h"
+#include "HistoryLog.h"
+#include "AllocTracker.h"
+#include "Topology.h"
+#include "BootSequence.h"
 
 AsyncWebServer server(80);
 AsyncWebSocket wsLog("/ws/log");
@@ -28,16 +39,25 @@ struct FwUploadContext
     bool success = false;
     bool rebooting = false;
     OtaTarget target = OTA_TARGET_NONE;
+    OtaInflater *inflater = nullptr; // gzip 이미지일 때만
+
+    ~FwUploadContext() { delete inflater; }
 };
 
 bool g_fwUploadInProgress = false;
+const FwUploadContext *g_fwUploadOwner = nullptr; // Update를 열어 둔 요청의 컨텍스트 (비교용으로만 쓴다)
 bool g_fwRebootRequested = false;
 unsigned long g_fwRebootRequestedAt = 0;
 unsigned long g_fwUploadLastActivityAt = 0;
 String g_fwUploadError;
 
+// 청크 단위 OTA (/ota/*). 연결이 끊겨도 세션은 유지되어 이어 올릴 수 있다.
+OtaSession g_otaSession;
+OtaTarget g_otaSessionTarget = OTA_TARGET_NONE;
+
 constexpr unsigned long kFwRebootDelayMs = 500;
 constexpr unsigned long kFwUploadTimeoutMs = 15000;
+constexpr unsigned long kOtaSessionIdleTimeoutMs = 300000; // 재연결을 기다려 주는 시간
 
 #if defined(U_SPIFFS)
 constexpr int kFsUpdateCommand = U_SPIFFS;
@@ -125,6 +145,7 @@ String updateErrorToString(uint8_t error)
 
 void sendJsonError(AsyncWebServerRequest *request, int statusCode, const String &reason, const String &detail)
 {
+    AllocScope scope(ALLOC_HTTP);
     JsonDocument doc;
     doc["status"] = "error";
     doc["reason"] = reason;
@@ -139,7 +160,19 @@ bool hasBinExtension(const String &filename)
 {
     String lower = filename;
     lower.toLowerCase();
-    return lower.endsWith(".bin");
+    return lower.endsWith(".bin") || lower.endsWith(".gz");
+}
+
+bool hasGzipExtension(const String &filename)
+{
+    String lower = filename;
+    lower.toLowerCase();
+    return lower.endsWith(".gz");
+}
+
+bool updateSink(uint8_t *data, size_t len, void *)
+{
+    return Update.write(data, len) == len;
 }
 
 String getFirmwareVersion()
@@ -162,6 +195,23 @@ void clearFwUploadContext(AsyncWebServerRequest *request)
     }
 }
 
+// 업로드 도중 클라이언트가 끊기면 finalize가 불리지 않는다.
+// ~AsyncWebServerRequest는 _tempObject를 free()만 하므로 여기서 delete하고 비워 둬야 인플레이터(~43KB)가 새지 않는다.
+void abandonFwUpload(AsyncWebServerRequest *request)
+{
+    const FwUploadContext *ctx = reinterpret_cast<FwUploadContext *>(request->_tempObject);
+    if (ctx == nullptr)
+        return; // 정상 종료: finalizeOtaUploadRequest가 이미 정리했다
+    if (g_fwUploadInProgress && g_fwUploadOwner == ctx)
+    {
+        Update.abort();
+        g_fwUploadInProgress = false;
+        g_fwUploadError = "client_disconnected";
+        WEBLOG_WARN("[%s] Upload aborted: client disconnected", targetTag(ctx->target));
+    }
+    clearFwUploadContext(request);
+}
+
 void setFwUploadFailure(FwUploadContext *ctx, const String &reason, const String &detail)
 {
     ctx->reason = reason;
@@ -208,6 +258,8 @@ void handleOtaUploadChunk(AsyncWebServerRequest *request, OtaTarget target, Stri
         clearFwUploadContext(request);
         ctx = new FwUploadContext();
         request->_tempObject = ctx;
+        request->onDisconnect([request]()
+                              { abandonFwUpload(request); });
         g_fwUploadLastActivityAt = millis();
         ctx->target = target;
 
@@ -219,7 +271,7 @@ void handleOtaUploadChunk(AsyncWebServerRequest *request, OtaTarget target, Stri
 
         if (!hasBinExtension(filename))
         {
-            setFwUploadFailure(ctx, "invalid_file_type", "only .bin files are allowed");
+            setFwUploadFailure(ctx, "invalid_file_type", "only .bin or .bin.gz files are allowed");
             return;
         }
 
@@ -230,6 +282,16 @@ void handleOtaUploadChunk(AsyncWebServerRequest *request, OtaTarget target, Stri
             return;
         }
 
+        if (OtaInflater::isGzip(data, len) || hasGzipExtension(filename))
+        {
+            ctx->inflater = new OtaInflater();
+            if (!ctx->inflater->begin())
+            {
+                setFwUploadFailure(ctx, "begin_failed", ctx->inflater->error());
+                return;
+            }
+        }
+
         g_fwUploadError = "";
         if (!Update.begin(UPDATE_SIZE_UNKNOWN, updateCommand))
         {
@@ -238,7 +300,8 @@ void handleOtaUploadChunk(AsyncWebServerRequest *request, OtaTarget target, Stri
         }
 
         g_fwUploadInProgress = true;
-        webLogf("[%s] Upload started: %s", targetTag(target), filename.c_str());
+        g_fwUploadOwner = ctx;
+        WEBLOG_INFO("[%s] Upload started: %s%s", targetTag(target), filename.c_str(), ctx->inflater ? " (gzip)" : "");
     }
 
     if (ctx == nullptr || ctx->reason.length())
@@ -256,19 +319,42 @@ void handleOtaUploadChunk(AsyncWebServerRequest *request, OtaTarget target, Stri
 
     if (len > 0)
     {
-        const size_t written = Update.write(data, len);
-        if (written != len)
+        if (ctx->inflater)
         {
-            setFwUploadFailure(ctx, "write_failed", updateErrorToString(Update.getError()));
-            Update.abort();
-            g_fwUploadInProgress = false;
-            return;
+            // 압축 해제된 바이트는 updateSink를 통해 Update.write로 바로 흘러간다
+            if (!ctx->inflater->write(data, len, updateSink, nullptr))
+            {
+                const char *error = ctx->inflater->error();
+                const bool writeFailed = strcmp(error, "write_failed") == 0;
+                setFwUploadFailure(ctx, writeFailed ? "write_failed" : "inflate_failed",
+                                   writeFailed ? updateErrorToString(Update.getError()) : String(error));
+                Update.abort();
+                g_fwUploadInProgress = false;
+                return;
+            }
+        }
+        else
+        {
+            const size_t written = Update.write(data, len);
+            if (written != len)
+            {
+                setFwUploadFailure(ctx, "write_failed", updateErrorToString(Update.getError()));
+                Update.abort();
+                g_fwUploadInProgress = false;
+                return;
+            }
         }
     }
 
     if (final)
     {
-        if (Update.end(true))
+        if (ctx->inflater && !ctx->inflater->finish())
+        {
+            setFwUploadFailure(ctx, "inflate_failed", ctx->inflater->error());
+            Update.abort();
+            WEBLOG_ERROR("[%s] Upload failed: %s", targetTag(target), ctx->detail.c_str());
+        }
+        else if (Update.end(true))
         {
             ctx->success = true;
             if (target == OTA_TARGET_FLASH)
@@ -277,86 +363,353 @@ void handleOtaUploadChunk(AsyncWebServerRequest *request, OtaTarget target, Stri
                 g_fwRebootRequested = true;
                 g_fwRebootRequestedAt = millis();
             }
-            webLogf("[%s] Upload complete", targetTag(target));
+            if (ctx->inflater)
+            {
+                const size_t in = ctx->inflater->inputBytes();
+                const size_t out = ctx->inflater->outputBytes();
+                // 압축이 안 되는(또는 아주 작은) 이미지는 gzip 쪽이 더 크다: 음수로 남긴다
+                const int saved = out ? (int)(100 - (int64_t)in * 100 / (int64_t)out) : 0;
+                WEBLOG_INFO("[%s] Upload complete (gzip %uKB -> %uKB, %d%% smaller)", targetTag(target),
+                            (unsigned)(in / 1024), (unsigned)(out / 1024), saved);
+            }
+            else
+            {
+                WEBLOG_INFO("[%s] Upload complete", targetTag(target));
+            }
         }
         else
         {
             setFwUploadFailure(ctx, "end_failed", updateErrorToString(Update.getError()));
             Update.abort();
-            webLogf("[%s] Upload failed: %s", targetTag(target), ctx->detail.c_str());
+            WEBLOG_ERROR("[%s] Upload failed: %s", targetTag(target), ctx->detail.c_str());
         }
         g_fwUploadInProgress = false;
     }
 }
-} // namespace
 
-void webLog(const String &msg)
+// 핸들러 실행 시간을 /metrics에 기록한다
+ArRequestHandlerFunction timedRoute(MetricsRoute route, ArRequestHandlerFunction handler)
+{
+    return [route, handler](AsyncWebServerRequest *request)
+    {
+        const uint32_t startUs = micros();
+        AllocScope scope(ALLOC_HTTP);
+        handler(request);
+        metricsRecordHttp(route, micros() - startUs);
+    };
+}
+
+bool parseSha256Hex(const String &hex, uint8_t out[32])
+{
+    if (hex.length() != 64)
+        return false;
+    for (size_t i = 0; i < 32; i++)
+    {
+        uint8_t byte = 0;
+        for (size_t j = 0; j < 2; j++)
+        {
+            const char c = hex[i * 2 + j];
+            uint8_t nibble;
+            if (c >= '0' && c <= '9')
+                nibble = c - '0';
+            else if (c >= 'a' && c <= 'f')
+                nibble = c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F')
+                nibble = c - 'A' + 10;
+            else
+                return false;
+            byte = (byte << 4) | nibble;
+        }
+        out[i] = byte;
+    }
+    return true;
+}
+
+bool readSizeParam(AsyncWebServerRequest *request, const char *name, size_t &out)
+{
+    if (!request->hasParam(name))
+        return false;
+    const String &value = request->getParam(name)->value();
+    if (value.length() == 0)
+        return false;
+    char *end = nullptr;
+    out = strtoul(value.c_str(), &end, 10);
+    return end != nullptr && *end == '\0';
+}
+
+void fillOtaSessionState(JsonObject doc)
+{
+    doc["active"] = g_otaSession.active();
+    if (!g_otaSession.active())
+        return;
+    doc["target"] = (g_otaSessionTarget == OTA_TARGET_FS) ? "fs" : "fw";
+    doc["gzip"] = g_otaSession.gzip();
+    doc["next"] = g_otaSession.received();
+    doc["size"] = g_otaSession.size();
+    doc["kbps"] = roundf(g_otaSession.kbps() * 10.0f) / 10.0f;
+    doc["etaSec"] = g_otaSession.etaSeconds();
+}
+
+void sendOtaSessionState(AsyncWebServerRequest *request, int statusCode, const char *status, const char *reason)
+{
+    JsonDocument doc;
+    JsonObject root = doc.to<JsonObject>();
+    root["status"] = status;
+    if (reason != nullptr)
+        root["reason"] = reason;
+    root["chunkMax"] = OtaSession::kChunkMax;
+    fillOtaSessionState(root);
+
+    String body;
+    serializeJson(doc, body);
+    request->send(statusCode, "application/json", body);
+}
+
+void endOtaSession(bool aborted)
+{
+    if (aborted)
+        g_otaSession.abort();
+    g_otaSessionTarget = OTA_TARGET_NONE;
+    g_fwUploadInProgress = false;
+}
+
+// POST /ota/begin?target=fw|fs&size=N&sha256=HEX[&gzip=1]
+// 같은 target/size/sha256의 세션이 살아 있으면 처음부터가 아니라 next부터 이어서 받는다.
+void handleOtaSessionBegin(AsyncWebServerRequest *request)
+{
+    const String targetName = request->hasParam("target") ? request->getParam("target")->value() : String("fw");
+    const OtaTarget target = (targetName == "fs") ? OTA_TARGET_FS : (targetName == "fw") ? OTA_TARGET_FLASH
+                                                                                         : OTA_TARGET_NONE;
+    size_t size = 0;
+    uint8_t sha256[32];
+    if (target == OTA_TARGET_NONE || !readSizeParam(request, "size", size) || size == 0 ||
+        !request->hasParam("sha256") || !parseSha256Hex(request->getParam("sha256")->value(), sha256))
+    {
+        sendJsonError(request, 400, "invalid_request", "target, size and sha256 are required");
+        return;
+    }
+
+    const int updateCommand = targetUpdateCommand(target);
+    if (updateCommand < 0)
+    {
+        sendJsonError(request, 400, "unsupported_target", "filesystem OTA is not supported in this build");
+        return;
+    }
+    if (g_fwUploadInProgress && !g_otaSession.active())
+    {
+        sendJsonError(request, 409, "upload_in_progress", "another upload is already running");
+        return;
+    }
+
+    g_fwUploadLastActivityAt = millis();
+    if (g_otaSession.matches(updateCommand, size, sha256))
+    {
+        WEBLOG_INFO("[%s] Upload resumed at %u/%u", targetTag(target), (unsigned)g_otaSession.received(), (unsigned)size);
+        sendOtaSessionState(request, 200, "ok", nullptr);
+        return;
+    }
+
+    const bool gzip = request->hasParam("gzip") && request->getParam("gzip")->value() == "1";
+    g_fwUploadError = "";
+    if (!g_otaSession.begin(updateCommand, size, sha256, gzip))
+    {
+        const String detail = (strcmp(g_otaSession.error(), "begin_failed") == 0) ? updateErrorToString(Update.getError())
+                                                                                  : String(g_otaSession.error());
+        endOtaSession(false);
+        sendJsonError(request, 400, "begin_failed", detail);
+        return;
+    }
+
+    g_otaSessionTarget = target;
+    g_fwUploadInProgress = true;
+    WEBLOG_INFO("[%s] Chunked upload started: %uKB%s", targetTag(target), (unsigned)(size / 1024), gzip ? " (gzip)" : "");
+    sendOtaSessionState(request, 200, "ok", nullptr);
+}
+
+// POST /ota/chunk?offset=N&crc=HEX, body = raw bytes (최대 kChunkMax)
+// 본문은 _tempObject에 모아 두었다가 요청이 끝나면 한 번에 검증한다.
+void handleOtaSessionChunkBody(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total)
 {
-    Serial.println(msg);
-    wsLog.textAll(msg);
+    if (index == 0)
+    {
+        free(request->_tempObject);
+        request->_tempObject = (total <= OtaSession::kChunkMax) ? malloc(OtaSession::kChunkMax) : nullptr;
+    }
+    if (request->_tempObject == nullptr || index + len > OtaSession::kChunkMax)
+        return;
+    memcpy(reinterpret_cast<uint8_t *>(request->_tempObject) + index, data, len);
+}
+
+void handleOtaSessionChunk(AsyncWebServerRequest *request)
+{
+    uint8_t *body = reinterpret_cast<uint8_t *>(request->_tempObject);
+    request->_tempObject = nullptr;
+    const size_t len = request->contentLength();
+
+    size_t offset = 0;
+    uint32_t crc = 0;
+    const bool hasCrc = request->hasParam("crc");
+    if (hasCrc)
+        crc = strtoul(request->getParam("crc")->value().c_str(), nullptr, 16);
+
+    if (!g_otaSession.active())
+    {
+        free(body);
+        sendOtaSessionState(request, 409, "error", "no_session");
+        return;
+    }
+    if (body == nullptr || len == 0 || !hasCrc || !readSizeParam(request, "offset", offset))
+    {
+        free(body);
+        sendOtaSessionState(request, 400, "error", "invalid_chunk");
+        return;
+    }
+
+    g_fwUploadLastActivityAt = millis();
+    const OtaSession::ChunkResult result = g_otaSession.writeChunk(offset, body, len, crc);
+    free(body);
+
+    switch (result)
+    {
+    case OtaSession::CHUNK_OK:
+    case OtaSession::CHUNK_DUPLICATE:
+        sendOtaSessionState(request, 200, "ok", nullptr);
+        return;
+    case OtaSession::CHUNK_OFFSET_MISMATCH:
+        sendOtaSessionState(request, 409, "error", "offset_mismatch");
+        return;
+    case OtaSession::CHUNK_CRC_MISMATCH:
+        sendOtaSessionState(request, 422, "error", "crc_mismatch");
+        return;
+    case OtaSession::CHUNK_TOO_LARGE:
+        sendOtaSessionState(request, 400, "error", "chunk_out_of_range");
+        return;
+    case OtaSession::CHUNK_WRITE_FAILED:
+        break;
+    }
+
+    const String detail = (strcmp(g_otaSession.error(), "write_failed") == 0) ? updateErrorToString(Update.getError())
+                                                                              : String(g_otaSession.error());
+    g_fwUploadError = detail;
+    WEBLOG_ERROR("[%s] Upload failed: %s", targetTag(g_otaSessionTarget), detail.c_str());
+    endOtaSession(true);
+    sendJsonError(request, 500, "write_failed", detail);
 }
 
-void webLogf(const char *format, ...)
+void handleOtaSessionCommit(AsyncWebServerRequest *request)
 {
-    char loc_buf[128];
-    va_list arg;
-    va_start(arg, format);
-    vsnprintf(loc_buf, sizeof(loc_buf), format, arg);
-    va_end(arg);
-    webLog(String(loc_buf));
+    if (!g_otaSession.active())
+    {
+        sendOtaSessionState(request, 409, "error", "no_session");
+        return;
+    }
+    if (g_otaSession.received() != g_otaSession.size())
+    {
+        sendOtaSessionState(request, 409, "error", "incomplete");
+        return;
+    }
+
+    const OtaTarget target = g_otaSessionTarget;
+    if (!g_otaSession.commit())
+    {
+        const String detail = (strcmp(g_otaSession.error(), "end_failed") == 0) ? updateErrorToString(Update.getError())
+                                                                                : String(g_otaSession.error());
+        g_fwUploadError = detail;
+        WEBLOG_ERROR("[%s] Upload failed: %s", targetTag(target), detail.c_str());
+        endOtaSession(false);
+        sendJsonError(request, 400, "commit_failed", detail);
+        return;
+    }
+
+    endOtaSession(false);
+    const bool rebooting = (target == OTA_TARGET_FLASH);
+    if (rebooting)
+    {
+        g_fwRebootRequested = true;
+        g_fwRebootRequestedAt = millis();
+    }
+    WEBLOG_INFO("[%s] Chunked upload complete (sha256 ok)", targetTag(target));
+
+    JsonDocument doc;
+    doc["status"] = "ok";
+    doc["message"] = targetSuccessMessage(target);
+    doc["rebooting"] = rebooting;
+    String body;
+    serializeJson(doc, body);
+    request->send(200, "application/json", body);
 }
+} // namespace
 
 void networkLoop()
 {
     const unsigned long now = millis();
 
-    if (g_fwUploadInProgress && (now - g_fwUploadLastActivityAt) > kFwUploadTimeoutMs)
+    if (g_otaSession.active())
     {
+        if ((now - g_fwUploadLastActivityAt) > kOtaSessionIdleTimeoutMs)
+        {
+            endOtaSession(true);
+            g_fwUploadError = "upload_timeout";
+            WEBLOG_WARN("[FW] Chunked upload session expired");
+        }
+    }
+    else if (g_fwUploadInProgress && (now - g_fwUploadLastActivityAt) > kFwUploadTimeoutMs)
+    {
+        // 요청 컨텍스트(인플레이터)는 멈춘 연결이 끊길 때 abandonFwUpload가 정리한다
         Update.abort();
         g_fwUploadInProgress = false;
         g_fwUploadError = "upload_timeout";
-        webLog("[FW] Upload timeout");
+        WEBLOG_WARN("[FW] Upload timeout");
     }
 
     if (g_fwRebootRequested && (now - g_fwRebootRequestedAt) >= kFwRebootDelayMs)
     {
         g_fwRebootRequested = false;
-        webLog("[FW] Rebooting now");
+        WEBLOG_INFO("[FW] Rebooting now");
         ESP.restart();
     }
 }
 
-void setupNetwork()
+bool networkMountStorage()
 {
-    if (!LittleFS.begin())
-    {
-        LittleFS.format();
-        LittleFS.begin();
-    }
-
-    loadConfig();
-
-    WiFiManager wm;
-    wm.setTimeout(180);
-    if (!wm.autoConnect("timetape_setup"))
-        ESP.restart();
+    if (LittleFS.begin())
+        return true;
+    bootPhaseNote(BOOT_PHASE_STORAGE, "formatted");
+    LittleFS.format();
+    return LittleFS.begin();
+}
 
+void networkStartServices()
+{
     if (MDNS.begin("tape"))
-        webLog("mDNS started: http://tape.local");
+        WEBLOG_INFO("mDNS started: http://tape.local");
 
+    wsLog.onEvent([](AsyncWebSocket *socket, AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len)
+                  {
+        if (type == WS_EVT_CONNECT)
+            webLogRequestReplay(client->id()); });
     server.addHandler(&wsLog);
-
-    server.on("/get-config", HTTP_GET, [](AsyncWebServerRequest *r)
-              {
+    frameStreamAttach(server);
+    remoteControlAttach(server);
+    stateStreamAttach(server);
+    metricsAttach(server);
+    historyAttach(server);
+    allocAttach(server);
+    topologyAttach(server);
+    bootAttach(server);
+
+    server.on("/get-config", HTTP_GET, timedRoute(ROUTE_GET_CONFIG, [](AsyncWebServerRequest *r)
+                                                  {
         JsonDocument doc;
         configToJson(doc, appConfig);
 
         String response;
         serializeJson(doc, response);
-        r->send(200, "application/json", response); });
+        r->send(200, "application/json", response); }));
 
     server.on("/set-config", HTTP_POST, [](AsyncWebServerRequest *r) {}, NULL, [](AsyncWebServerRequest *r, uint8_t *data, size_t len, size_t index, size_t total)
               {
+            AllocScope scope(ALLOC_HTTP);
             if (index == 0) {
                 r->_tempObject = new String();
             }
@@ -366,6 +719,7 @@ void setupNetwork()
             body->concat(reinterpret_cast<const char *>(data), len);
 
             if (index + len == total) {
+                const uint32_t startUs = micros();
                 JsonDocument doc;
                 if (deserializeJson(doc, *body)) {
                     delete body;
@@ -384,14 +738,17 @@ void setupNetwork()
 
                 appConfig = parsed;
                 saveConfigToFile();
+                schedulerReload();
+                interactiveManager.reloadPresets(); // 지금 프리셋의 타이머/뽀모도로 길이가 바뀌었을 수 있다
 
                 delete body;
                 r->_tempObject = nullptr;
                 r->send(200, "application/json", "{\"status\":\"ok\"}");
+                metricsRecordHttp(ROUTE_SET_CONFIG, micros() - startUs);
             } });
 
-    server.on("/fw-info", HTTP_GET, [](AsyncWebServerRequest *request)
-              {
+    server.on("/fw-info", HTTP_GET, timedRoute(ROUTE_FW_INFO, [](AsyncWebServerRequest *request)
+                                               {
         JsonDocument doc;
         doc["chipModel"] = ESP.getChipModel();
         doc["chipRev"] = ESP.getChipRevision();
@@ -399,25 +756,38 @@ void setupNetwork()
         doc["uploadInProgress"] = g_fwUploadInProgress;
         doc["fsUploadSupported"] = (kFsUpdateCommand >= 0);
         doc["version"] = getFirmwareVersion();
+        fillOtaSessionState(doc["ota"].to<JsonObject>());
 
         String response;
         serializeJson(doc, response);
-        request->send(200, "application/json", response); });
+        request->send(200, "application/json", response); }));
 
-    server.on("/fw-upload", HTTP_POST, [](AsyncWebServerRequest *request)
-              {
-        finalizeOtaUploadRequest(request, OTA_TARGET_FLASH); },
+    server.on("/fw-upload", HTTP_POST, timedRoute(ROUTE_FW_UPLOAD, [](AsyncWebServerRequest *request)
+                                                 { finalizeOtaUploadRequest(request, OTA_TARGET_FLASH); }),
               [](AsyncWebServerRequest *request, String filename, size_t index, uint8_t *data, size_t len, bool final)
               {
         handleOtaUploadChunk(request, OTA_TARGET_FLASH, filename, index, data, len, final); });
 
-    server.on("/fs-upload", HTTP_POST, [](AsyncWebServerRequest *request)
-              {
-        finalizeOtaUploadRequest(request, OTA_TARGET_FS); },
+    server.on("/fs-upload", HTTP_POST, timedRoute(ROUTE_FS_UPLOAD, [](AsyncWebServerRequest *request)
+                                                 { finalizeOtaUploadRequest(request, OTA_TARGET_FS); }),
               [](AsyncWebServerRequest *request, String filename, size_t index, uint8_t *data, size_t len, bool final)
               {
         handleOtaUploadChunk(request, OTA_TARGET_FS, filename, index, data, len, final); });
 
+    server.on("/ota/begin", HTTP_POST, timedRoute(ROUTE_OTA_BEGIN, handleOtaSessionBegin));
+    server.on("/ota/chunk", HTTP_POST, timedRoute(ROUTE_OTA_CHUNK, handleOtaSessionChunk), NULL, handleOtaSessionChunkBody);
+    server.on("/ota/commit", HTTP_POST, timedRoute(ROUTE_OTA_COMMIT, handleOtaSessionCommit));
+    server.on("/ota/status", HTTP_GET, timedRoute(ROUTE_OTA_STATUS, [](AsyncWebServerRequest *request)
+                                                  { sendOtaSessionState(request, 200, "ok", nullptr); }));
+    server.on("/ota/abort", HTTP_POST, timedRoute(ROUTE_OTA_ABORT, [](AsyncWebServerRequest *request)
+                                                  {
+        if (g_otaSession.active())
+        {
+            WEBLOG_WARN("[%s] Chunked upload aborted", targetTag(g_otaSessionTarget));
+            endOtaSession(true);
+        }
+        sendOtaSessionState(request, 200, "ok", nullptr); }));
+
     server.serveStatic("/", LittleFS, "/").setDefaultFile("index.html");
     server.begin();
 }
@@ -0,0 +1,267 @@
+#include "OtaInflater.h"
+#include <rom/miniz.h>
+#include <esp_rom_crc.h>
+#include <cstring>
+
+namespace
+{
+constexpr uint8_t kGzipId1 = 0x1F;
+constexpr uint8_t kGzipId2 = 0x8B;
+constexpr uint8_t kGzipMethodDeflate = 8;
+
+constexpr uint8_t kFlagHeaderCrc = 0x02;
+constexpr uint8_t kFlagExtra = 0x04;
+constexpr uint8_t kFlagName = 0x08;
+constexpr uint8_t kFlagComment = 0x10;
+
+constexpr size_t kGzipHeaderSize = 10;
+constexpr size_t kGzipTrailerSize = 8;
+
+static_assert(OtaInflater::kWindowSize == TINFL_LZ_DICT_SIZE, "window must match the deflate dictionary");
+
+uint32_t readLe32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+} // namespace
+
+bool OtaInflater::isGzip(const uint8_t *data, size_t len)
+{
+    return len >= 2 && data[0] == kGzipId1 && data[1] == kGzipId2;
+}
+
+OtaInflater::~OtaInflater()
+{
+    end();
+}
+
+bool OtaInflater::begin()
+{
+    end();
+    _decomp = reinterpret_cast<tinfl_decompressor *>(malloc(sizeof(tinfl_decompressor)));
+    _window = reinterpret_cast<uint8_t *>(malloc(kWindowSize));
+    if (_decomp == nullptr || _window == nullptr)
+    {
+        end();
+        fail("inflate_no_memory");
+        return false;
+    }
+
+    tinfl_init(_decomp);
+    _windowPos = 0;
+    _state = STATE_HEADER;
+    _flags = 0;
+    _scratchLen = 0;
+    _skipRemaining = 0;
+    _tailLen = 0;
+    _trailerBytes = 0;
+    _crc = 0;
+    _inputBytes = 0;
+    _outputBytes = 0;
+    _error = nullptr;
+    return true;
+}
+
+void OtaInflater::end()
+{
+    free(_decomp);
+    free(_window);
+    _decomp = nullptr;
+    _window = nullptr;
+}
+
+void OtaInflater::fail(const char *reason)
+{
+    _state = STATE_ERROR;
+    _error = reason;
+}
+
+void OtaInflater::rememberTail(const uint8_t *data, size_t len)
+{
+    if (len >= kGzipTrailerSize)
+    {
+        memcpy(_tail, data + len - kGzipTrailerSize, kGzipTrailerSize);
+        _tailLen = kGzipTrailerSize;
+        return;
+    }
+    const size_t keep = min(_tailLen, kGzipTrailerSize - len);
+    memmove(_tail, _tail + _tailLen - keep, keep);
+    memcpy(_tail + keep, data, len);
+    _tailLen = keep + len;
+}
+
+bool OtaInflater::write(const uint8_t *data, size_t len, OtaSinkFn sink, void *ctx)
+{
+    _inputBytes += len;
+    rememberTail(data, len);
+
+    while (len > 0 && _state != STATE_ERROR)
+    {
+        size_t used = len;
+        if (_state == STATE_DEFLATE)
+        {
+            used = inflate(data, len, sink, ctx);
+        }
+        else if (_state == STATE_TRAILER)
+        {
+            // tinfl이 비트 버퍼로 트레일러 일부를 먼저 삼켰을 수 있어 여기서는 개수만 센다.
+            _trailerBytes += len;
+            if (_trailerBytes > kGzipTrailerSize)
+                fail("inflate_trailing_data");
+        }
+        else if (_state == STATE_DONE)
+        {
+            fail("inflate_trailing_data");
+        }
+        else
+        {
+            used = parseHeader(data, len);
+        }
+        data += used;
+        len -= used;
+    }
+    return _state != STATE_ERROR;
+}
+
+bool OtaInflater::finish()
+{
+    if (_state == STATE_ERROR)
+        return false;
+    if (_state != STATE_TRAILER || _tailLen < kGzipTrailerSize)
+    {
+        fail("inflate_truncated");
+        return false;
+    }
+    if (readLe32(_tail) != _crc)
+    {
+        fail("inflate_crc_mismatch");
+        return false;
+    }
+    if (readLe32(_tail + 4) != (uint32_t)_outputBytes)
+    {
+        fail("inflate_size_mismatch");
+        return false;
+    }
+    _state = STATE_DONE;
+    return true;
+}
+
+OtaInflater::State OtaInflater::nextHeaderState(State from) const
+{
+    switch (from)
+    {
+    case STATE_HEADER:
+        if (_flags & kFlagExtra)
+            return STATE_EXTRA_LEN;
+        [[fallthrough]];
+    case STATE_EXTRA_LEN:
+    case STATE_EXTRA:
+        if (_flags & kFlagName)
+            return STATE_NAME;
+        [[fallthrough]];
+    case STATE_NAME:
+        if (_flags & kFlagComment)
+            return STATE_COMMENT;
+        [[fallthrough]];
+    case STATE_COMMENT:
+        if (_flags & kFlagHeaderCrc)
+            return STATE_HEADER_CRC;
+        [[fallthrough]];
+    default:
+        return STATE_DEFLATE;
+    }
+}
+
+// 헤더는 청크 경계에 걸칠 수 있으므로 한 바이트씩 상태 기계로 읽는다.
+size_t OtaInflater::parseHeader(const uint8_t *data, size_t len)
+{
+    size_t used = 0;
+    while (used < len && _state != STATE_DEFLATE && _state != STATE_ERROR)
+    {
+        const uint8_t b = data[used++];
+        switch (_state)
+        {
+        case STATE_HEADER:
+            _scratch[_scratchLen++] = b;
+            if (_scratchLen < kGzipHeaderSize)
+                break;
+            if (_scratch[0] != kGzipId1 || _scratch[1] != kGzipId2 || _scratch[2] != kGzipMethodDeflate)
+            {
+                fail("invalid_gzip_header");
+                break;
+            }
+            _flags = _scratch[3];
+            _scratchLen = 0;
+            _state = nextHeaderState(STATE_HEADER);
+            break;
+        case STATE_EXTRA_LEN:
+            _scratch[_scratchLen++] = b;
+            if (_scratchLen < 2)
+                break;
+            _skipRemaining = (size_t)_scratch[0] | ((size_t)_scratch[1] << 8);
+            _scratchLen = 0;
+            _state = _skipRemaining ? STATE_EXTRA : nextHeaderState(STATE_EXTRA);
+            break;
+        case STATE_EXTRA:
+            if (--_skipRemaining == 0)
+                _state = nextHeaderState(STATE_EXTRA);
+            break;
+        case STATE_NAME:
+        case STATE_COMMENT:
+            if (b == 0)
+                _state = nextHeaderState(_state);
+            break;
+        case STATE_HEADER_CRC:
+            if (++_scratchLen == 2)
+            {
+                _scratchLen = 0;
+                _state = STATE_DEFLATE;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    return used;
+}
+
+size_t OtaInflater::inflate(const uint8_t *data, size_t len, OtaSinkFn sink, void *ctx)
+{
+    size_t used = 0;
+    for (;;)
+    {
+        size_t inBytes = len - used;
+        size_t outBytes = kWindowSize - _windowPos;
+        uint8_t *out = _window + _windowPos;
+        const tinfl_status status = tinfl_decompress(_decomp, data + used, &inBytes, _window, out, &outBytes,
+                                                     TINFL_FLAG_HAS_MORE_INPUT);
+        used += inBytes;
+
+        if (outBytes > 0)
+        {
+            _crc = esp_rom_crc32_le(_crc, out, outBytes);
+            _outputBytes += outBytes;
+            _windowPos = (_windowPos + outBytes) & (kWindowSize - 1);
+            if (!sink(out, outBytes, ctx))
+            {
+                fail("write_failed");
+                return used;
+            }
+        }
+
+        if (status == TINFL_STATUS_DONE)
+        {
+            _state = STATE_TRAILER;
+            _trailerBytes = 0;
+            return used;
+        }
+        if (status < TINFL_STATUS_DONE)
+        {
+            fail("inflate_corrupt");
+            return used;
+        }
+        if (status == TINFL_STATUS_NEEDS_MORE_INPUT)
+            return used;
+        // TINFL_STATUS_HAS_MORE_OUTPUT: 창이 한 바퀴 돌았으니 이어서 푼다
+    }
+}
@@ -0,0 +1,190 @@
+#include "OtaSession.h"
+#include <Update.h>
+#include <esp_rom_crc.h>
+#include <cstring>
+
+namespace
+{
+constexpr float kRateSmoothing = 0.2f; // 청크 단위 처리량 EWMA 가중치
+}
+
+OtaSession::~OtaSession()
+{
+    abort();
+}
+
+bool OtaSession::begin(int updateCommand, size_t size, const uint8_t sha256[32], bool gzip)
+{
+    abort();
+    _error = nullptr;
+
+    _sector = reinterpret_cast<uint8_t *>(malloc(kSectorSize));
+    if (_sector == nullptr)
+    {
+        _error = "no_memory";
+        return false;
+    }
+    if (gzip)
+    {
+        _inflater = new OtaInflater();
+        if (!_inflater->begin())
+        {
+            _error = _inflater->error();
+            release();
+            return false;
+        }
+    }
+    if (!Update.begin(UPDATE_SIZE_UNKNOWN, updateCommand))
+    {
+        _error = "begin_failed";
+        release();
+        return false;
+    }
+
+    mbedtls_sha256_init(&_sha);
+    mbedtls_sha256_starts(&_sha, 0);
+    memcpy(_expectedSha, sha256, sizeof(_expectedSha));
+    _updateCommand = updateCommand;
+    _size = size;
+    _received = 0;
+    _sectorLen = 0;
+    _startedAt = millis();
+    _lastActivityAt = _startedAt;
+    _kbps = 0.0f;
+    _active = true;
+    return true;
+}
+
+bool OtaSession::matches(int updateCommand, size_t size, const uint8_t sha256[32]) const
+{
+    return _active && _updateCommand == updateCommand && _size == size &&
+           memcmp(_expectedSha, sha256, sizeof(_expectedSha)) == 0;
+}
+
+OtaSession::ChunkResult OtaSession::writeChunk(size_t offset, const uint8_t *data, size_t len, uint32_t crc)
+{
+    if (len > kChunkMax || offset + len > _size)
+        return CHUNK_TOO_LARGE;
+    if (offset + len <= _received)
+        return CHUNK_DUPLICATE;
+    if (offset != _received)
+        return CHUNK_OFFSET_MISMATCH;
+    // 검증 전에는 아무 상태도 건드리지 않는다: 실패한 청크는 그대로 다시 보내면 된다.
+    if (esp_rom_crc32_le(0, data, len) != crc)
+        return CHUNK_CRC_MISMATCH;
+
+    const unsigned long now = millis();
+    const unsigned long dt = now - _lastActivityAt;
+    if (dt > 0)
+    {
+        const float instant = (float)len / (float)dt; // bytes/ms == KB/s 근사 (1000/1024)
+        _kbps = (_kbps == 0.0f) ? instant : (_kbps + kRateSmoothing * (instant - _kbps));
+    }
+    _lastActivityAt = now;
+
+    mbedtls_sha256_update(&_sha, data, len);
+    _received += len;
+
+    const bool ok = _inflater ? _inflater->write(data, len, sectorSink, this) : appendToSector(data, len);
+    if (!ok)
+    {
+        _error = (_inflater && _inflater->error()) ? _inflater->error() : "write_failed";
+        return CHUNK_WRITE_FAILED;
+    }
+    return CHUNK_OK;
+}
+
+bool OtaSession::commit()
+{
+    if (!_active)
+    {
+        _error = "no_session";
+        return false;
+    }
+    if (_received != _size)
+    {
+        _error = "incomplete";
+        return false;
+    }
+
+    uint8_t digest[32];
+    mbedtls_sha256_finish(&_sha, digest);
+    if (memcmp(digest, _expectedSha, sizeof(digest)) != 0)
+    {
+        _error = "sha256_mismatch";
+        abort();
+        return false;
+    }
+    if (_inflater && !_inflater->finish())
+    {
+        _error = _inflater->error();
+        abort();
+        return false;
+    }
+    if (!flushSector() || !Update.end(true))
+    {
+        _error = "end_failed";
+        abort();
+        return false;
+    }
+
+    release();
+    return true;
+}
+
+void OtaSession::abort()
+{
+    if (_active)
+        Update.abort();
+    release();
+}
+
+long OtaSession::etaSeconds() const
+{
+    if (!_active || _kbps <= 0.0f)
+        return -1;
+    const float remainingKb = (float)(_size - _received) / 1000.0f;
+    return (long)(remainingKb / _kbps + 0.5f);
+}
+
+bool OtaSession::sectorSink(uint8_t *data, size_t len, void *ctx)
+{
+    return reinterpret_cast<OtaSession *>(ctx)->appendToSector(data, len);
+}
+
+bool OtaSession::appendToSector(const uint8_t *data, size_t len)
+{
+    while (len > 0)
+    {
+        const size_t n = min(len, kSectorSize - _sectorLen);
+        memcpy(_sector + _sectorLen, data, n);
+        _sectorLen += n;
+        data += n;
+        len -= n;
+        if (_sectorLen == kSectorSize && !flushSector())
+            return false;
+    }
+    return true;
+}
+
+bool OtaSession::flushSector()
+{
+    if (_sectorLen == 0)
+        return true;
+    const size_t written = Update.write(_sector, _sectorLen);
+    const bool ok = written == _sectorLen;
+    _sectorLen = 0;
+    return ok;
+}
+
+void OtaSession::release()
+{
+    if (_active)
+        mbedtls_sha256_free(&_sha);
+    _active = false;
+    free(_sector);
+    _sector = nullptr;
+    _sectorLen = 0;
+    delete _inflater;
+    _inflater = nullptr;
+}
@@ -0,0 +1,246 @@
+#include "RemoteControl.h"
+#include <ESPAsyncWebServer.h>
+#include <ArduinoJson.h>
+#include <freertos/queue.h>
+#include <cstring>
+#include "Config.h"
+#include "managers/ButtonManager.h"
+#include "managers/InteractiveManager.h"
+
+AsyncWebSocket wsCtrl("/ws/ctrl");
+
+namespace
+{
+enum RemoteCommandType : uint8_t
+{
+    RC_PING = 0,
+    RC_PRESS,
+    RC_COMBO,
+    RC_SET_COUNTER,
+    RC_TIMER,
+    RC_PRESET
+};
+
+enum TimerAction : uint8_t
+{
+    TIMER_START = 0,
+    TIMER_PAUSE,
+    TIMER_TOGGLE,
+    TIMER_RESET
+};
+
+struct RemoteCommand
+{
+    uint32_t clientId;
+    uint32_t id;
+    uint32_t clientTime;
+    uint32_t receivedAtUs;
+    RemoteCommandType type;
+    uint8_t arg;
+    int32_t value;
+};
+
+struct PendingAck
+{
+    RemoteCommand cmd;
+    bool ok;
+};
+
+constexpr size_t kCommandQueueDepth = 16;
+constexpr size_t kAckBufferSize = 256;
+
+QueueHandle_t g_commandQueue = nullptr;
+PendingAck g_pendingAcks[kCommandQueueDepth];
+size_t g_pendingAckCount = 0;
+
+const int kButtonPins[4] = {BTN_1, BTN_2, BTN_3, BTN_4};
+
+void sendImmediateError(AsyncWebSocketClient *client, uint32_t id, const char *reason)
+{
+    char buf[96];
+    snprintf(buf, sizeof(buf), "{\"id\":%u,\"ok\":false,\"reason\":\"%s\"}", (unsigned)id, reason);
+    client->text(buf);
+}
+
+// async_tcp 태스크에서 호출: 파싱만 하고 실제 적용은 loop 태스크에 맡긴다.
+bool parseCommand(JsonDocument &doc, RemoteCommand &cmd)
+{
+    const char *name = doc["cmd"] | "";
+    if (strcmp(name, "ping") == 0)
+    {
+        cmd.type = RC_PING;
+        return true;
+    }
+    if (strcmp(name, "press") == 0)
+    {
+        const int btn = doc["btn"] | 0;
+        if (btn < 1 || btn > 4)
+            return false;
+        cmd.type = RC_PRESS;
+        cmd.arg = (uint8_t)(btn - 1);
+        return true;
+    }
+    if (strcmp(name, "combo") == 0)
+    {
+        cmd.type = RC_COMBO;
+        return true;
+    }
+    if (strcmp(name, "counter") == 0)
+    {
+        if (!doc["value"].is<long>())
+            return false;
+        cmd.type = RC_SET_COUNTER;
+        cmd.value = doc["value"].as<long>();
+        return true;
+    }
+    if (strcmp(name, "timer") == 0)
+    {
+        const char *action = doc["action"] | "toggle";
+        cmd.type = RC_TIMER;
+        if (strcmp(action, "start") == 0)
+            cmd.arg = TIMER_START;
+        else if (strcmp(action, "pause") == 0)
+            cmd.arg = TIMER_PAUSE;
+        else if (strcmp(action, "reset") == 0)
+            cmd.arg = TIMER_RESET;
+        else if (strcmp(action, "toggle") == 0)
+            cmd.arg = TIMER_TOGGLE;
+        else
+            return false;
+        return true;
+    }
+    if (strcmp(name, "preset") == 0)
+    {
+        const char *dir = doc["dir"] | "next";
+        cmd.type = RC_PRESET;
+        cmd.arg = (strcmp(dir, "prev") == 0) ? 0 : 1;
+        return true;
+    }
+    return false;
+}
+
+void onCtrlEvent(AsyncWebSocket *socket, AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len)
+{
+    if (type == WS_EVT_CONNECT)
+    {
+        // 작은 명령 프레임이 Nagle에 묶여 지연되지 않도록
+        client->client()->setNoDelay(true);
+        return;
+    }
+    if (type != WS_EVT_DATA)
+        return;
+
+    AwsFrameInfo *info = reinterpret_cast<AwsFrameInfo *>(arg);
+    if (!info->final || info->index != 0 || info->len != len || info->opcode != WS_TEXT)
+        return;
+
+    RemoteCommand cmd = {};
+    cmd.receivedAtUs = micros();
+    cmd.clientId = client->id();
+
+    JsonDocument doc;
+    if (deserializeJson(doc, reinterpret_cast<const char *>(data), len))
+    {
+        sendImmediateError(client, 0, "invalid_json");
+        return;
+    }
+    cmd.id = doc["id"] | 0U;
+    cmd.clientTime = doc["t"] | 0U;
+
+    if (!parseCommand(doc, cmd))
+    {
+        sendImmediateError(client, cmd.id, "invalid_command");
+        return;
+    }
+    if (g_commandQueue == nullptr || xQueueSend(g_commandQueue, &cmd, 0) != pdTRUE)
+    {
+        sendImmediateError(client, cmd.id, "busy");
+    }
+}
+
+bool applyCommand(const RemoteCommand &cmd, ButtonManager &buttons)
+{
+    switch (cmd.type)
+    {
+    case RC_PING:
+        return true;
+    case RC_PRESS:
+        return buttons.inject(kButtonPins[cmd.arg]);
+    case RC_COMBO:
+        return buttons.inject(BTN_1) && buttons.inject(BTN_2);
+    case RC_SET_COUNTER:
+        interactiveManager.setCounter(cmd.value);
+        return true;
+    case RC_TIMER:
+        if (cmd.arg == TIMER_START)
+            interactiveManager.startTimer();
+        else if (cmd.arg == TIMER_PAUSE)
+            interactiveManager.pauseTimer();
+        else if (cmd.arg == TIMER_RESET)
+            interactiveManager.resetTimer();
+        else
+            interactiveManager.handleButton2(MODE_TIMER);
+        return true;
+    case RC_PRESET:
+        // 물리 BTN_3/BTN_4와 같은 경로 (저장/표시 포함)
+        return buttons.inject(cmd.arg ? BTN_4 : BTN_3);
+    }
+    return false;
+}
+
+size_t formatAck(char *buf, size_t size, const PendingAck &ack)
+{
+    InteractiveSnapshot snap;
+    interactiveManager.getSnapshot(snap);
+    const uint32_t latencyUs = micros() - ack.cmd.receivedAtUs;
+
+    const int n = snprintf(buf, size,
+                           "{\"id\":%u,\"ok\":%s,\"t\":%u,\"us\":%u,\"state\":{\"preset\":%d,\"mode\":%d,"
+                           "\"counter\":%ld,\"timer\":{\"running\":%s,\"elapsedMs\":%lu},"
+                           "\"pomo\":{\"state\":%u,\"running\":%s,\"elapsedMs\":%lu}}}",
+                           (unsigned)ack.cmd.id, ack.ok ? "true" : "false", (unsigned)ack.cmd.clientTime, (unsigned)latencyUs,
+                           appConfig.currentPresetIndex, activeInteractiveMode(appConfig),
+                           snap.counter, snap.timerRunning ? "true" : "false", snap.timerElapsedMs,
+                           (unsigned)snap.pomoState, snap.pomoRunning ? "true" : "false", snap.pomoElapsedMs);
+    if (n < 0)
+        return 0;
+    return ((size_t)n < size) ? (size_t)n : size - 1;
+}
+} // namespace
+
+void remoteControlAttach(AsyncWebServer &server)
+{
+    if (g_commandQueue == nullptr)
+        g_commandQueue = xQueueCreate(kCommandQueueDepth, sizeof(RemoteCommand));
+    wsCtrl.onEvent(onCtrlEvent);
+    server.addHandler(&wsCtrl);
+}
+
+void remoteControlBeginFrame(ButtonManager &buttons)
+{
+    if (g_commandQueue == nullptr)
+        return;
+
+    RemoteCommand cmd;
+    while (g_pendingAckCount < kCommandQueueDepth && xQueueReceive(g_commandQueue, &cmd, 0) == pdTRUE)
+    {
+        PendingAck &ack = g_pendingAcks[g_pendingAckCount++];
+        ack.cmd = cmd;
+        ack.ok = applyCommand(cmd, buttons);
+    }
+}
+
+void remoteControlEndFrame()
+{
+    if (g_pendingAckCount == 0)
+        return;
+
+    char buf[kAckBufferSize];
+    for (size_t i = 0; i < g_pendingAckCount; i++)
+    {
+        const size_t len = formatAck(buf, sizeof(buf), g_pendingAcks[i]);
+        if (len > 0)
+            wsCtrl.text(g_pendingAcks[i].cmd.clientId, buf, len);
+    }
+    g_pendingAckCount = 0;
+}
@@ -0,0 +1,131 @@
+#include "Scheduler.h"
+#include <atomic>
+#include "Config.h"
+#include "TimerEngine.h"
+#include "WebLogger.h"
+#include "hal/Hal.h"
+
+namespace
+{
+constexpr time_t kValidEpoch = 1600000000;   // 이보다 이전이면 NTP를 아직 못 받은 것
+constexpr uint64_t kClockRetryMs = 60000;    // 벽시계가 없을 때 다시 계산하는 간격
+constexpr time_t kMaxSleepSec = 3600;        // 더 먼 예정은 중간에 한 번 깨어나 시계 보정(NTP)을 반영
+
+TimerHandle g_timer = kInvalidTimer;
+std::atomic<bool> g_reloadRequested{false};
+time_t g_nextFireAt = 0;
+int g_nextPreset = -1;
+
+void sleepFor(uint64_t delayMs)
+{
+    timerEngine.reset(g_timer);
+    timerEngine.setDuration(g_timer, delayMs);
+    timerEngine.start(g_timer);
+}
+
+void plan(time_t after)
+{
+    g_nextFireAt = 0;
+    g_nextPreset = -1;
+    if (appConfig.schedules.empty())
+    {
+        timerEngine.reset(g_timer);
+        return;
+    }
+
+    const time_t wall = hal::wallTime();
+    if (wall < kValidEpoch)
+    {
+        sleepFor(kClockRetryMs);
+        return;
+    }
+
+    for (const ScheduleRule &rule : appConfig.schedules)
+    {
+        const time_t at = scheduleNextOccurrence(rule, after);
+        if (at != 0 && (g_nextFireAt == 0 || at <= g_nextFireAt))
+        {
+            g_nextFireAt = at;
+            g_nextPreset = rule.preset;
+        }
+    }
+    if (g_nextFireAt == 0)
+    {
+        timerEngine.reset(g_timer);
+        return;
+    }
+
+    const time_t wait = (g_nextFireAt > wall) ? min(g_nextFireAt - wall, kMaxSleepSec) : 0;
+    sleepFor((uint64_t)wait * 1000ULL);
+}
+
+void onTimerEvent(const TimerEvent &event, void *ctx)
+{
+    if (event.timer != g_timer || event.type != TIMER_EVENT_EXPIRED)
+        return;
+
+    const time_t wall = hal::wallTime();
+    if (g_nextFireAt == 0 || wall < g_nextFireAt)
+    {
+        // 중간 기상이거나 시계가 뒤로 밀렸다: 남은 시간만 다시 건다
+        plan(wall);
+        return;
+    }
+
+    const time_t firedAt = g_nextFireAt;
+    if (g_nextPreset != appConfig.currentPresetIndex)
+    {
+        WEBLOG_INFO("[Schedule] Preset Changed: %d", g_nextPreset);
+        switchPreset(g_nextPreset);
+    }
+    plan(firedAt);
+}
+} // namespace
+
+// mktime이 날짜 넘김과 요일을 정규화한다
+time_t scheduleNextOccurrence(const ScheduleRule &rule, time_t after)
+{
+    struct tm today;
+    localtime_r(&after, &today);
+    for (int d = 0; d <= 7; d++)
+    {
+        struct tm day = today;
+        day.tm_mday += d;
+        day.tm_hour = rule.hour;
+        day.tm_min = rule.minute;
+        day.tm_sec = 0;
+        day.tm_isdst = -1;
+        const time_t at = mktime(&day);
+        if (at > after && (rule.days & (1u << day.tm_wday)))
+            return at;
+    }
+    return 0;
+}
+
+void schedulerBegin()
+{
+    g_timer = timerEngine.create("schedule", TIMER_COUNTDOWN);
+    timerEngine.addListener(onTimerEvent, nullptr);
+    plan(hal::wallTime());
+}
+
+void schedulerReload()
+{
+    g_reloadRequested.store(true);
+}
+
+void schedulerLoop()
+{
+    if (g_reloadRequested.exchange(false))
+        plan(hal::wallTime());
+}
+
+time_t schedulerNextFireAt()
+{
+    return g_nextFireAt;
+}
+
+int schedulerNextPreset()
+{
+    return g_nextPreset;
+}
@@ -0,0 +1,242 @@
+#include "StateStream.h"
+#include <ESPAsyncWebServer.h>
+#include <atomic>
+#include <cstdarg>
+#include "Config.h"
+#include "managers/DisplayManager.h"
+#include "managers/InteractiveManager.h"
+
+AsyncWebSocket wsState("/ws/state");
+
+namespace
+{
+constexpr size_t kMaxSnapshotRequests = 4;
+constexpr size_t kStateBufferSize = 320;
+constexpr unsigned long kElapsedToleranceMs = 250; // 외삽 오차가 이보다 크면 경과 시간을 다시 보낸다
+
+struct DeviceState
+{
+    int preset;
+    int presetCount;
+    int mode;
+    long counter;
+    bool timerRunning;
+    unsigned long timerElapsedMs;
+    uint8_t pomoState;
+    bool pomoRunning;
+    unsigned long pomoElapsedMs;
+    uint8_t brightness;
+    bool night;
+};
+
+// 클라이언트가 마지막으로 받은 경과 시간과 그 시각 (외삽 기준점)
+struct ElapsedRef
+{
+    unsigned long elapsedMs;
+    unsigned long sentAt;
+};
+
+// 접속 이벤트(async_tcp 태스크)는 요청만 남기고, 스냅샷은 loop 태스크에서 만든다.
+std::atomic<uint32_t> g_snapshotRequests[kMaxSnapshotRequests];
+std::atomic<bool> g_snapshotAll{false};
+std::atomic<uint8_t> g_clientCount{0};
+
+DeviceState g_last;
+ElapsedRef g_timerRef;
+ElapsedRef g_pomoRef;
+bool g_hasLast = false;
+uint32_t g_seq = 0;
+
+void onStateEvent(AsyncWebSocket *socket, AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len)
+{
+    if (type == WS_EVT_CONNECT)
+    {
+        g_clientCount.fetch_add(1);
+        for (std::atomic<uint32_t> &slot : g_snapshotRequests)
+        {
+            uint32_t expected = 0;
+            if (slot.compare_exchange_strong(expected, client->id()))
+                return;
+        }
+        g_snapshotAll.store(true); // 슬롯이 꽉 차면 모두에게 한 번 더 보낸다
+    }
+    else if (type == WS_EVT_DISCONNECT)
+    {
+        g_clientCount.fetch_sub(1);
+    }
+}
+
+void captureState(DeviceState &s, const DisplayManager &display)
+{
+    InteractiveSnapshot snap;
+    interactiveManager.getSnapshot(snap);
+
+    s.preset = appConfig.currentPresetIndex;
+    s.presetCount = (int)appConfig.presets.size();
+    s.mode = activeInteractiveMode(appConfig);
+    s.counter = snap.counter;
+    s.timerRunning = snap.timerRunning;
+    s.timerElapsedMs = snap.timerElapsedMs;
+    s.pomoState = snap.pomoState;
+    s.pomoRunning = snap.pomoRunning;
+    s.pomoElapsedMs = snap.pomoElapsedMs;
+    s.brightness = display.brightness();
+    s.night = display.isNightActive();
+}
+
+// 클라이언트 쪽 외삽 값과 실제 값이 벌어졌는지 (시작/정지/리셋/단계 전환)
+bool elapsedDrifted(const ElapsedRef &ref, bool wasRunning, unsigned long actual, unsigned long now)
+{
+    const unsigned long predicted = ref.elapsedMs + (wasRunning ? now - ref.sentAt : 0);
+    const unsigned long diff = (actual > predicted) ? actual - predicted : predicted - actual;
+    return diff > kElapsedToleranceMs;
+}
+
+class JsonWriter
+{
+public:
+    JsonWriter(char *buf, size_t size) : _buf(buf), _size(size) {}
+
+    void append(const char *format, ...)
+    {
+        if (_len >= _size)
+            return;
+        va_list args;
+        va_start(args, format);
+        const int n = vsnprintf(_buf + _len, _size - _len, format, args);
+        va_end(args);
+        if (n > 0)
+            _len = min(_len + (size_t)n, _size - 1);
+    }
+
+    size_t length() const { return _len; }
+
+private:
+    char *_buf;
+    size_t _size;
+    size_t _len = 0;
+};
+
+void appendTimer(JsonWriter &w, const DeviceState &s)
+{
+    w.append(",\"timer\":{\"running\":%s,\"elapsedMs\":%lu}", s.timerRunning ? "true" : "false", s.timerElapsedMs);
+}
+
+void appendPomo(JsonWriter &w, const DeviceState &s)
+{
+    w.append(",\"pomo\":{\"state\":%u,\"running\":%s,\"elapsedMs\":%lu}", (unsigned)s.pomoState,
+             s.pomoRunning ? "true" : "false", s.pomoElapsedMs);
+}
+
+size_t formatSnapshot(char *buf, size_t size, const DeviceState &s)
+{
+    JsonWriter w(buf, size);
+    w.append("{\"t\":\"snap\",\"seq\":%u,\"preset\":%d,\"presets\":%d,\"mode\":%d,\"counter\":%ld",
+             (unsigned)g_seq, s.preset, s.presetCount, s.mode, s.counter);
+    appendTimer(w, s);
+    appendPomo(w, s);
+    w.append(",\"brightness\":%u,\"night\":%s}", (unsigned)s.brightness, s.night ? "true" : "false");
+    return w.length();
+}
+
+// 바뀐 항목이 없으면 0
+size_t formatDelta(char *buf, size_t size, const DeviceState &s, unsigned long now)
+{
+    JsonWriter w(buf, size);
+    w.append("{\"t\":\"delta\",\"seq\":%u", (unsigned)(g_seq + 1));
+    const size_t headerLen = w.length();
+
+    if (s.preset != g_last.preset)
+        w.append(",\"preset\":%d", s.preset);
+    if (s.presetCount != g_last.presetCount)
+        w.append(",\"presets\":%d", s.presetCount);
+    if (s.mode != g_last.mode)
+        w.append(",\"mode\":%d", s.mode);
+    if (s.counter != g_last.counter)
+        w.append(",\"counter\":%ld", s.counter);
+    if (s.timerRunning != g_last.timerRunning || elapsedDrifted(g_timerRef, g_last.timerRunning, s.timerElapsedMs, now))
+        appendTimer(w, s);
+    if (s.pomoState != g_last.pomoState || s.pomoRunning != g_last.pomoRunning ||
+        elapsedDrifted(g_pomoRef, g_last.pomoRunning, s.pomoElapsedMs, now))
+        appendPomo(w, s);
+    if (s.brightness != g_last.brightness)
+        w.append(",\"brightness\":%u", (unsigned)s.brightness);
+    if (s.night != g_last.night)
+        w.append(",\"night\":%s", s.night ? "true" : "false");
+
+    if (w.length() == headerLen)
+        return 0;
+    w.append("}");
+    return w.length();
+}
+
+void remember(const DeviceState &s, unsigned long now)
+{
+    // 경과 시간 기준점은 실제로 보냈을 때만 옮긴다 (외삽 오차가 누적되지 않게)
+    if (!g_hasLast || s.timerRunning != g_last.timerRunning || elapsedDrifted(g_timerRef, g_last.timerRunning, s.timerElapsedMs, now))
+        g_timerRef = {s.timerElapsedMs, now};
+    if (!g_hasLast || s.pomoState != g_last.pomoState || s.pomoRunning != g_last.pomoRunning ||
+        elapsedDrifted(g_pomoRef, g_last.pomoRunning, s.pomoElapsedMs, now))
+        g_pomoRef = {s.pomoElapsedMs, now};
+    g_last = s;
+    g_hasLast = true;
+}
+} // namespace
+
+void stateStreamAttach(AsyncWebServer &server)
+{
+    wsState.onEvent(onStateEvent);
+    server.addHandler(&wsState);
+}
+
+void stateStreamEndFrame(const DisplayManager &display)
+{
+    if (g_clientCount.load() == 0)
+    {
+        g_hasLast = false;
+        return;
+    }
+
+    DeviceState current;
+    captureState(current, display);
+    const unsigned long now = millis();
+    char buf[kStateBufferSize];
+
+    if (!g_hasLast || g_snapshotAll.exchange(false))
+    {
+        const size_t len = formatSnapshot(buf, sizeof(buf), current);
+        wsState.textAll(buf, len);
+        for (std::atomic<uint32_t> &slot : g_snapshotRequests)
+            slot.store(0);
+        g_timerRef = {current.timerElapsedMs, now};
+        g_pomoRef = {current.pomoElapsedMs, now};
+        g_last = current;
+        g_hasLast = true;
+        return;
+    }
+
+    // 이번 프레임의 변경분은 기존 클라이언트에게 delta 하나로
+    const size_t deltaLen = formatDelta(buf, sizeof(buf), current, now);
+    if (deltaLen > 0)
+    {
+        g_seq++;
+        wsState.textAll(buf, deltaLen);
+    }
+
+    // 새 클라이언트에게는 최신 상태의 스냅샷
+    bool snapshotReady = false;
+    for (std::atomic<uint32_t> &slot : g_snapshotRequests)
+    {
+        const uint32_t clientId = slot.exchange(0);
+        if (clientId == 0)
+            continue;
+        if (!snapshotReady)
+        {
+            formatSnapshot(buf, sizeof(buf), current);
+            snapshotReady = true;
+        }
+        wsState.text(clientId, buf);
+    }
+
+    remember(current, now);
+}
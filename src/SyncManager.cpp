@@ -0,0 +1,249 @@
+#include "SyncManager.h"
+#include <cstring>
+#include "Config.h"
+#include "WebLogger.h"
+#include "hal/Hal.h"
+#include "managers/InteractiveManager.h"
+
+namespace
+{
+const uint8_t kSyncGroup[4] = {239, 255, 84, 84};
+constexpr uint16_t kSyncPort = 4284;
+constexpr uint32_t kBeaconMagic = 0x31535454; // "TTS1"
+constexpr uint8_t kBeaconVersion = 1;
+
+constexpr uint32_t kLockTimeoutMs = 1500;       // 이만큼 비콘이 없으면 로컬 클럭으로 돌아간다
+constexpr int32_t kStepThresholdMs = 500;       // 오차가 크면 한 번에 맞추고, 작으면 천천히 당긴다
+constexpr int32_t kSlewPerBeaconMs = 2;
+constexpr size_t kOffsetWindow = 8;
+
+enum BeaconFlags : uint8_t
+{
+    BEACON_TIMER_RUNNING = 0x01,
+    BEACON_POMO_RUNNING = 0x02
+};
+
+struct __attribute__((packed)) SyncBeacon
+{
+    uint32_t magic;
+    uint8_t version;
+    uint8_t preset;
+    uint8_t pomoState;
+    uint8_t flags;
+    uint32_t seq;
+    uint32_t leaderMs;  // 보낸 시점의 리더 렌더 클럭
+    uint32_t epochSec;  // 리더 벽시계 (NTP 전이면 0)
+    int32_t counter;
+    uint32_t timerElapsedMs;
+    uint32_t pomoElapsedMs;
+};
+static_assert(sizeof(SyncBeacon) == 32, "beacon layout is part of the wire format");
+
+SyncRole g_role = SYNC_OFF;
+bool g_socketOpen = false;
+uint32_t g_lastOpenAttemptAt = 0;
+constexpr uint32_t kReopenIntervalMs = 5000;
+
+uint32_t g_seq = 0;
+uint32_t g_lastSentSlot = 0;
+uint32_t g_beaconsSent = 0;
+uint32_t g_beaconsReceived = 0;
+
+// 팔로워 클럭: 오프셋 표본 중 최댓값이 전송 지연이 가장 작았던 표본이다.
+int32_t g_offsetSamples[kOffsetWindow];
+size_t g_offsetCount = 0;
+size_t g_offsetNext = 0;
+int32_t g_offsetMs = 0;
+bool g_locked = false;
+uint32_t g_lastBeaconAt = 0;
+uint32_t g_lastSeq = 0;
+
+void closeSocket()
+{
+    if (g_socketOpen)
+        hal::multicastClose();
+    g_socketOpen = false;
+    g_locked = false;
+    g_offsetCount = 0;
+    g_offsetNext = 0;
+}
+
+void openSocket(SyncRole role)
+{
+    closeSocket();
+    g_role = role;
+    g_lastOpenAttemptAt = hal::nowMs();
+    if (role == SYNC_OFF || !hal::networkReady())
+        return;
+    g_socketOpen = hal::multicastOpen(kSyncGroup, kSyncPort);
+    WEBLOG_INFO("[Sync] %s (%s)", role == SYNC_LEADER ? "Leader" : "Follower", g_socketOpen ? "ok" : "socket failed");
+}
+
+void sendBeacon(uint32_t nowMs)
+{
+    InteractiveSnapshot snap;
+    interactiveManager.getSnapshot(snap);
+
+    SyncBeacon b;
+    b.magic = kBeaconMagic;
+    b.version = kBeaconVersion;
+    b.preset = (uint8_t)appConfig.currentPresetIndex;
+    b.pomoState = snap.pomoState;
+    b.flags = (snap.timerRunning ? BEACON_TIMER_RUNNING : 0) | (snap.pomoRunning ? BEACON_POMO_RUNNING : 0);
+    b.seq = ++g_seq;
+    b.leaderMs = nowMs;
+    const time_t now = hal::wallTime();
+    b.epochSec = (now > 1600000000) ? (uint32_t)now : 0;
+    b.counter = (int32_t)snap.counter;
+    b.timerElapsedMs = snap.timerElapsedMs;
+    b.pomoElapsedMs = snap.pomoElapsedMs;
+
+    if (hal::multicastSend(&b, sizeof(b)))
+        g_beaconsSent++;
+}
+
+void trackLeaderClock(uint32_t leaderMs, uint32_t localMs)
+{
+    g_offsetSamples[g_offsetNext] = (int32_t)(leaderMs - localMs);
+    g_offsetNext = (g_offsetNext + 1) % kOffsetWindow;
+    if (g_offsetCount < kOffsetWindow)
+        g_offsetCount++;
+
+    int32_t best = g_offsetSamples[0];
+    for (size_t i = 1; i < g_offsetCount; i++)
+    {
+        if (g_offsetSamples[i] - best > 0)
+            best = g_offsetSamples[i];
+    }
+
+    const int32_t error = best - g_offsetMs;
+    if (!g_locked || error > kStepThresholdMs || error < -kStepThresholdMs)
+    {
+        g_offsetMs = best;
+        if (!g_locked)
+            WEBLOG_INFO("[Sync] Locked to leader (offset %ld ms)", (long)best);
+        g_locked = true;
+    }
+    else if (error != 0)
+    {
+        // 프레임 격자가 튀지 않도록 한 비콘에 조금씩만 당긴다
+        g_offsetMs += (error > 0) ? min(error, kSlewPerBeaconMs) : max(error, -kSlewPerBeaconMs);
+    }
+}
+
+void applyBeacon(const SyncBeacon &b)
+{
+    // NTP를 못 받은 팔로워는 리더 벽시계를 빌린다
+    if (b.epochSec != 0 && hal::wallTime() < 1600000000)
+    {
+        hal::setWallClock((time_t)b.epochSec);
+        WEBLOG_INFO("[Sync] Wall clock taken from leader");
+    }
+
+    if (!appConfig.presets.empty() && b.preset < appConfig.presets.size() && b.preset != appConfig.currentPresetIndex)
+    {
+        // 팔로워는 저장하지 않는다 (리더가 바뀌면 다시 따라간다)
+        appConfig.currentPresetIndex = b.preset;
+    }
+
+    InteractiveSnapshot snap;
+    snap.counter = b.counter;
+    snap.timerRunning = (b.flags & BEACON_TIMER_RUNNING) != 0;
+    snap.timerElapsedMs = b.timerElapsedMs;
+    snap.pomoState = b.pomoState;
+    snap.pomoRunning = (b.flags & BEACON_POMO_RUNNING) != 0;
+    snap.pomoElapsedMs = b.pomoElapsedMs;
+    interactiveManager.applySnapshot(snap);
+}
+
+void receiveBeacons()
+{
+    SyncBeacon b;
+    int len;
+    while ((len = hal::multicastReceive(&b, sizeof(b))) >= 0)
+    {
+        const uint32_t localMs = hal::nowMs();
+        if (len != (int)sizeof(b))
+            continue;
+        if (b.magic != kBeaconMagic || b.version != kBeaconVersion)
+            continue;
+        // 순서가 뒤바뀐 오래된 비콘은 버린다 (리더 재부팅으로 seq가 처음부터면 받아들인다)
+        if (g_locked && (int32_t)(b.seq - g_lastSeq) <= 0 && b.seq > 16)
+            continue;
+
+        g_lastSeq = b.seq;
+        g_lastBeaconAt = localMs;
+        g_beaconsReceived++;
+        trackLeaderClock(b.leaderMs, localMs);
+        applyBeacon(b);
+    }
+}
+} // namespace
+
+void syncBegin()
+{
+    openSocket((SyncRole)appConfig.syncRole);
+}
+
+void syncLoop()
+{
+    const SyncRole wanted = (SyncRole)appConfig.syncRole;
+    if (wanted != g_role)
+        openSocket(wanted);
+    if (!g_socketOpen)
+    {
+        // WiFi가 늦게 붙은 경우 다시 시도
+        if (g_role != SYNC_OFF && hal::nowMs() - g_lastOpenAttemptAt > kReopenIntervalMs)
+            openSocket(g_role);
+        return;
+    }
+
+    if (g_role == SYNC_LEADER)
+    {
+        // 프레임 격자마다 한 번: 팔로워는 이 박자에 맞춰 그린다
+        const uint32_t now = hal::nowMs();
+        const uint32_t slot = now / FRAME_INTERVAL_MS;
+        if (slot != g_lastSentSlot)
+        {
+            g_lastSentSlot = slot;
+            sendBeacon(now);
+        }
+        return;
+    }
+
+    receiveBeacons();
+    if (g_locked && hal::nowMs() - g_lastBeaconAt > kLockTimeoutMs)
+    {
+        g_locked = false;
+        g_offsetCount = 0;
+        WEBLOG_WARN("[Sync] Leader lost, running on local clock");
+    }
+}
+
+uint32_t syncMillis()
+{
+    if (g_role == SYNC_FOLLOWER && g_locked)
+        return hal::nowMs() + (uint32_t)g_offsetMs;
+    return hal::nowMs();
+}
+
+void syncGetStats(SyncStats &out)
+{
+    out.role = g_role;
+    out.locked = g_locked;
+    out.offsetMs = g_offsetMs;
+    out.spreadMs = 0;
+    if (g_offsetCount > 0)
+    {
+        int32_t lo = g_offsetSamples[0];
+        int32_t hi = g_offsetSamples[0];
+        for (size_t i = 1; i < g_offsetCount; i++)
+        {
+            lo = min(lo, g_offsetSamples[i]);
+            hi = max(hi, g_offsetSamples[i]);
+        }
+        out.spreadMs = (uint32_t)(hi - lo);
+    }
+    out.beaconsSent = g_beaconsSent;
+    out.beaconsReceived = g_beaconsReceived;
+}
@@ -1,30 +1,28 @@
 #include "TimeLogic.h"
-#include <NTPClient.h>
-#include <WiFiUdp.h>
 #include "WebLogger.h"
+#include "hal/Hal.h"
 
-WiFiUDP ntpUDP;
-NTPClient timeClient(ntpUDP, "pool.ntp.org");
+namespace {
+constexpr long kGmtOffsetSec = 3600 * 9;
+constexpr time_t kValidEpoch = 1600000000; // 이보다 이전이면 아직 시간 소스가 없는 것
+}
+
+void setupTimeZone() {
+    hal::timeZoneBegin(kGmtOffsetSec);
+}
 
 void setupTime() {
-    timeClient.begin();
-    timeClient.setTimeOffset(3600 * 9); 
-    configTime(3600 * 9, 0, "pool.ntp.org", "time.nist.gov");
+    // 기다리지 않는다: 시각이 생기면 main의 bootStep이 부트 애니메이션을 걷는다
+    hal::wallClockBegin(kGmtOffsetSec);
+    WEBLOG_INFO("NTP sync started");
+}
 
-    webLog("Waiting for NTP time sync: ");
-    time_t now = time(nullptr);
-    int retry = 0;
-    while (now < 8 * 3600 * 2 && retry < 100) { // 약 10초간 대기
-        delay(100);
-        // webLog("."); // 점을 계속 찍으면 웹소켓 부하가 클 수 있으니 생략하거나 묶어서 출력
-        now = time(nullptr);
-        retry++;
-    }
-    webLog("Time synchronized!");
+bool timeSourceReady() {
+    return hal::wallTime() >= kValidEpoch;
 }
 
 bool getLocalTimeInfo(struct tm * info) {
-    return getLocalTime(info);
+    return hal::localTime(info);
 }
 
 bool isLeap(int year) { return (year % 4 == 0 && year % 100 != 0) || (year % 400 == 0); }
@@ -35,10 +33,10 @@ int getDaysInMonth(int month, int year) {
     return days[month];
 }
 
-time_t parseDate(String dateStr) {
+time_t parseDate(const char *dateStr) {
     struct tm t = {0};
     int y, m, d;
-    if(sscanf(dateStr.c_str(), "%d-%d-%d", &y, &m, &d) == 3) {
+    if(dateStr && sscanf(dateStr, "%d-%d-%d", &y, &m, &d) == 3) {
         t.tm_year = y - 1900;
         t.tm_mon = m - 1;
         t.tm_mday = d;
@@ -71,7 +69,7 @@ void getQuarterInfo(struct tm * t, int &totalDays, float &passedDays) {
     passedDays = daysPassedInt + (t->tm_hour / 24.0) + (t->tm_min / 1440.0);
 }
 
-float calculateProgress(int mode, struct tm * t, String sDate, String tDate) {
+float calculateProgress(int mode, struct tm * t, const char *sDate, const char *tDate) {
     if (mode == 0) { // Year
         int total = isLeap(t->tm_year + 1900) ? 366 : 365;
         return (float)t->tm_yday / (float)total;
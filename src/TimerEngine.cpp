@@ -0,0 +1,351 @@
+#include "TimerEngine.h"
+#include <cstring>
+#include <time.h>
+#include "hal/Hal.h"
+
+TimerEngine timerEngine;
+
+namespace
+{
+constexpr time_t kValidEpoch = 1600000000;       // 이보다 이전이면 NTP를 아직 못 받은 것
+constexpr uint64_t kAlarmClockRetryMs = 60000;   // 벽시계가 없을 때 알람 재계산 간격
+}
+
+void TimerEngine::begin()
+{
+    _wheel.begin(now());
+}
+
+uint64_t TimerEngine::now() const
+{
+    return hal::uptimeMs();
+}
+
+void TimerEngine::update()
+{
+    _wheel.advance(now(), onWheelExpire, this);
+}
+
+TimerEngine::Timer *TimerEngine::get(TimerHandle h)
+{
+    return (h < _timers.size() && _timers[h].used) ? &_timers[h] : nullptr;
+}
+
+const TimerEngine::Timer *TimerEngine::get(TimerHandle h) const
+{
+    return (h < _timers.size() && _timers[h].used) ? &_timers[h] : nullptr;
+}
+
+TimerHandle TimerEngine::create(const char *name, TimerKind kind)
+{
+    _wheel.begin(now()); // begin() 전에 만들어도 휠 기준점이 맞도록
+
+    size_t index = 0;
+    while (index < _timers.size() && _timers[index].used)
+        index++;
+    if (index >= kInvalidTimer)
+        return kInvalidTimer;
+    if (index == _timers.size())
+        _timers.emplace_back();
+
+    Timer &t = _timers[index];
+    t = Timer();
+    snprintf(t.name, sizeof(t.name), "%s", name ? name : "");
+    t.kind = kind;
+    t.used = true;
+    t.node = _wheel.allocate((uint32_t)index);
+    return (TimerHandle)index;
+}
+
+TimerHandle TimerEngine::find(const char *name) const
+{
+    for (size_t i = 0; i < _timers.size(); i++)
+    {
+        if (_timers[i].used && strcmp(_timers[i].name, name) == 0)
+            return (TimerHandle)i;
+    }
+    return kInvalidTimer;
+}
+
+void TimerEngine::destroy(TimerHandle h)
+{
+    Timer *t = get(h);
+    if (!t)
+        return;
+    _wheel.release(t->node);
+    t->used = false;
+}
+
+const char *TimerEngine::name(TimerHandle h) const
+{
+    const Timer *t = get(h);
+    return t ? t->name : "";
+}
+
+void TimerEngine::setDuration(TimerHandle h, uint64_t durationMs)
+{
+    Timer *t = get(h);
+    if (!t || t->durationMs == durationMs)
+        return;
+    t->durationMs = durationMs;
+    if (t->running)
+        rearm(h);
+}
+
+void TimerEngine::setPomodoro(TimerHandle h, uint64_t workMs, uint64_t restMs)
+{
+    Timer *t = get(h);
+    if (!t || (t->workMs == workMs && t->restMs == restMs))
+        return;
+    t->workMs = workMs;
+    t->restMs = restMs;
+    if (t->running)
+        rearm(h);
+}
+
+void TimerEngine::setAlarm(TimerHandle h, uint8_t hour, uint8_t minute)
+{
+    Timer *t = get(h);
+    if (!t || (t->alarmHour == hour && t->alarmMinute == minute))
+        return;
+    t->alarmHour = hour;
+    t->alarmMinute = minute;
+    if (t->running)
+        rearm(h);
+}
+
+void TimerEngine::start(TimerHandle h)
+{
+    Timer *t = get(h);
+    if (!t || t->running)
+        return;
+    if (t->kind == TIMER_POMODORO && (t->phase == POMODORO_WAIT_REST || t->phase == POMODORO_WAIT_WORK))
+    {
+        advancePhase(h);
+        return;
+    }
+    if (t->finished)
+    {
+        t->finished = false;
+        t->accumulatedMs = 0;
+    }
+    t->running = true;
+    t->startedAt = now();
+    rearm(h);
+}
+
+void TimerEngine::pause(TimerHandle h)
+{
+    Timer *t = get(h);
+    if (!t || !t->running)
+        return;
+    t->accumulatedMs += now() - t->startedAt;
+    t->running = false;
+    _wheel.disarm(t->node);
+}
+
+void TimerEngine::reset(TimerHandle h)
+{
+    Timer *t = get(h);
+    if (!t)
+        return;
+    t->running = false;
+    t->finished = false;
+    t->accumulatedMs = 0;
+    t->startedAt = now();
+    _wheel.disarm(t->node);
+}
+
+void TimerEngine::advancePhase(TimerHandle h)
+{
+    Timer *t = get(h);
+    if (!t || t->kind != TIMER_POMODORO)
+        return;
+    if (t->phase == POMODORO_WAIT_REST)
+        t->phase = POMODORO_REST;
+    else if (t->phase == POMODORO_WAIT_WORK)
+        t->phase = POMODORO_WORK;
+    else
+        return;
+    t->accumulatedMs = 0;
+    t->startedAt = now();
+    t->running = true;
+    rearm(h);
+}
+
+void TimerEngine::restore(TimerHandle h, bool running, uint64_t elapsedMs, uint8_t phase)
+{
+    Timer *t = get(h);
+    if (!t)
+        return;
+    t->phase = phase;
+    t->accumulatedMs = elapsedMs;
+    t->startedAt = now();
+    t->running = running;
+    t->finished = false;
+    rearm(h);
+}
+
+bool TimerEngine::running(TimerHandle h) const
+{
+    const Timer *t = get(h);
+    return t && t->running;
+}
+
+bool TimerEngine::finished(TimerHandle h) const
+{
+    const Timer *t = get(h);
+    return t && t->finished;
+}
+
+uint64_t TimerEngine::elapsedMs(TimerHandle h) const
+{
+    const Timer *t = get(h);
+    if (!t)
+        return 0;
+    return t->running ? t->accumulatedMs + (now() - t->startedAt) : t->accumulatedMs;
+}
+
+uint64_t TimerEngine::durationMs(TimerHandle h) const
+{
+    const Timer *t = get(h);
+    return t ? phaseDuration(*t) : 0;
+}
+
+uint8_t TimerEngine::phase(TimerHandle h) const
+{
+    const Timer *t = get(h);
+    return t ? t->phase : (uint8_t)POMODORO_WORK;
+}
+
+bool TimerEngine::addListener(TimerListener listener, void *ctx)
+{
+    if (!listener)
+        return false;
+    _listeners.push_back({listener, ctx});
+    return true;
+}
+
+uint64_t TimerEngine::phaseDuration(const Timer &t) const
+{
+    if (t.kind == TIMER_POMODORO)
+    {
+        if (t.phase == POMODORO_WORK)
+            return t.workMs;
+        if (t.phase == POMODORO_REST)
+            return t.restMs;
+        return 0;
+    }
+    return t.durationMs;
+}
+
+// 동작 상태가 바뀔 때마다 불러 휠 기한을 현재 상태에 맞춘다.
+void TimerEngine::rearm(TimerHandle h)
+{
+    Timer &t = _timers[h];
+    if (!t.running)
+    {
+        _wheel.disarm(t.node);
+        return;
+    }
+
+    switch (t.kind)
+    {
+    case TIMER_COUNTDOWN:
+    case TIMER_POMODORO:
+    {
+        if (t.kind == TIMER_POMODORO && t.phase != POMODORO_WORK && t.phase != POMODORO_REST)
+        {
+            _wheel.disarm(t.node);
+            return;
+        }
+        const uint64_t duration = phaseDuration(t);
+        const uint64_t elapsed = elapsedMs(h);
+        const uint64_t current = now();
+        _wheel.arm(t.node, current + (duration > elapsed ? duration - elapsed : 0));
+        break;
+    }
+    case TIMER_ALARM:
+        armAlarm(t);
+        break;
+    default:
+        _wheel.disarm(t.node); // 스톱워치는 만료가 없다
+        break;
+    }
+}
+
+void TimerEngine::armAlarm(Timer &t)
+{
+    const time_t wall = hal::wallTime();
+    if (wall < kValidEpoch)
+    {
+        t.alarmAt = 0;
+        _wheel.arm(t.node, now() + kAlarmClockRetryMs);
+        return;
+    }
+
+    struct tm local;
+    localtime_r(&wall, &local);
+    local.tm_hour = t.alarmHour;
+    local.tm_min = t.alarmMinute;
+    local.tm_sec = 0;
+    time_t target = mktime(&local);
+    if (target <= wall)
+    {
+        local.tm_mday++;
+        target = mktime(&local);
+    }
+    t.alarmAt = target;
+    _wheel.arm(t.node, now() + (uint64_t)(target - wall) * 1000ULL);
+}
+
+void TimerEngine::emit(TimerEventType type, TimerHandle h, const Timer &t, uint8_t phase, uint64_t durationMs)
+{
+    const TimerEvent event = {type, h, t.kind, phase, now(), durationMs};
+    // 리스너가 타이머를 만들거나 지워도 되도록 이벤트는 복사본으로 넘긴다
+    for (size_t i = 0; i < _listeners.size(); i++)
+        _listeners[i].fn(event, _listeners[i].ctx);
+}
+
+void TimerEngine::handleExpire(TimerHandle h)
+{
+    Timer *t = get(h);
+    if (!t)
+        return;
+
+    switch (t->kind)
+    {
+    case TIMER_COUNTDOWN:
+        t->running = false;
+        t->finished = true;
+        t->accumulatedMs = t->durationMs;
+        emit(TIMER_EVENT_EXPIRED, h, *t, t->phase, t->durationMs);
+        break;
+    case TIMER_POMODORO:
+    {
+        const uint8_t ended = t->phase;
+        const uint64_t endedMs = phaseDuration(*t);
+        t->running = false;
+        t->accumulatedMs = 0;
+        t->phase = (ended == POMODORO_WORK) ? POMODORO_WAIT_REST : POMODORO_WAIT_WORK;
+        emit(TIMER_EVENT_PHASE_END, h, *t, ended, endedMs);
+        break;
+    }
+    case TIMER_ALARM:
+    {
+        // 벽시계가 늦게 맞춰졌거나 뒤로 밀렸으면 울리지 않고 다시 계산한다
+        const bool due = t->alarmAt != 0 && hal::wallTime() >= t->alarmAt;
+        armAlarm(*t);
+        if (due)
+            emit(TIMER_EVENT_ALARM, h, *t, t->phase, 0);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void TimerEngine::onWheelExpire(TimerWheel::NodeId node, uint32_t owner, void *ctx)
+{
+    static_cast<TimerEngine *>(ctx)->handleExpire((TimerHandle)owner);
+}
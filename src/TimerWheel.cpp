@@ -0,0 +1,176 @@
+#include "TimerWheel.h"
+
+TimerWheel::TimerWheel()
+{
+    for (int32_t &head : _heads)
+        head = kNil;
+}
+
+void TimerWheel::begin(uint64_t nowMs)
+{
+    // 이미 걸린 노드가 있으면 기준 칸만 옮기면 어긋나므로 처음 한 번만 맞춘다
+    if (_started)
+        return;
+    _currentTick = nowMs / kTickMs;
+    _started = true;
+}
+
+TimerWheel::NodeId TimerWheel::allocate(uint32_t owner)
+{
+    NodeId id;
+    if (_freeHead != kNil)
+    {
+        id = (NodeId)_freeHead;
+        _freeHead = _nodes[id].next;
+    }
+    else
+    {
+        id = (NodeId)_nodes.size();
+        _nodes.emplace_back();
+    }
+    Node &n = _nodes[id];
+    n = Node();
+    n.owner = owner;
+    n.used = true;
+    return id;
+}
+
+void TimerWheel::release(NodeId node)
+{
+    if (node >= _nodes.size() || !_nodes[node].used)
+        return;
+    unlink(node);
+    _nodes[node].used = false;
+    _nodes[node].next = _freeHead;
+    _freeHead = (int32_t)node;
+}
+
+void TimerWheel::arm(NodeId node, uint64_t deadlineMs)
+{
+    if (node >= _nodes.size() || !_nodes[node].used)
+        return;
+    unlink(node);
+    _nodes[node].deadlineMs = deadlineMs;
+    place(node);
+}
+
+void TimerWheel::disarm(NodeId node)
+{
+    if (node < _nodes.size())
+        unlink(node);
+}
+
+bool TimerWheel::armed(NodeId node) const
+{
+    return node < _nodes.size() && _nodes[node].list != kNil;
+}
+
+uint64_t TimerWheel::deadline(NodeId node) const
+{
+    return (node < _nodes.size()) ? _nodes[node].deadlineMs : 0;
+}
+
+void TimerWheel::link(NodeId node, int16_t list)
+{
+    Node &n = _nodes[node];
+    n.list = list;
+    n.prev = kNil;
+    n.next = _heads[list];
+    if (n.next != kNil)
+        _nodes[n.next].prev = (int32_t)node;
+    _heads[list] = (int32_t)node;
+}
+
+void TimerWheel::unlink(NodeId node)
+{
+    Node &n = _nodes[node];
+    if (n.list == kNil)
+        return;
+    if (n.prev != kNil)
+        _nodes[n.prev].next = n.next;
+    else
+        _heads[n.list] = n.next;
+    if (n.next != kNil)
+        _nodes[n.next].prev = n.prev;
+    n.prev = n.next = kNil;
+    n.list = kNil;
+}
+
+// 남은 칸 수로 단을 고르고, 기한 tick의 해당 자리 비트로 칸을 고른다.
+void TimerWheel::place(NodeId node)
+{
+    const uint64_t tick = (_nodes[node].deadlineMs + kTickMs - 1) / kTickMs;
+    if (tick <= _currentTick)
+    {
+        link(node, kExpiredList);
+        return;
+    }
+
+    const uint64_t delta = tick - _currentTick;
+    uint8_t level = 0;
+    while (level < kLevels - 1 && delta >= (1ull << (kSlotBits * (level + 1))))
+        level++;
+
+    // 최상위 단 범위를 넘으면 끝 칸에 두고, 내려올 때 다시 자리를 찾는다
+    const uint64_t maxDelta = (1ull << (kSlotBits * kLevels)) - 1;
+    const uint64_t slotTick = (delta > maxDelta) ? _currentTick + maxDelta : tick;
+    const uint32_t slot = (uint32_t)(slotTick >> (kSlotBits * level)) & (kSlots - 1);
+    link(node, (int16_t)(level * kSlots + slot));
+}
+
+void TimerWheel::cascade(uint8_t level)
+{
+    const uint32_t slot = (uint32_t)(_currentTick >> (kSlotBits * level)) & (kSlots - 1);
+    const int16_t list = (int16_t)(level * kSlots + slot);
+    int32_t cur = _heads[list];
+    _heads[list] = kNil;
+    while (cur != kNil)
+    {
+        const int32_t next = _nodes[cur].next;
+        _nodes[cur].list = kNil;
+        _nodes[cur].prev = _nodes[cur].next = kNil;
+        place((NodeId)cur);
+        cur = next;
+    }
+}
+
+void TimerWheel::advance(uint64_t nowMs, ExpireFn onExpire, void *ctx)
+{
+    if (!_started)
+        begin(nowMs);
+
+    const uint64_t targetTick = nowMs / kTickMs;
+    for (;;)
+    {
+        // 하나씩 떼어 내고 부르므로 콜백이 다른 노드를 disarm/release하거나 다시 arm해도 안전하다
+        while (_heads[kExpiredList] != kNil)
+        {
+            const NodeId node = (NodeId)_heads[kExpiredList];
+            unlink(node);
+            onExpire(node, _nodes[node].owner, ctx);
+        }
+
+        if (_currentTick >= targetTick)
+            break;
+
+        _currentTick++;
+        for (uint8_t level = 1; level < kLevels; level++)
+        {
+            if ((_currentTick & ((1ull << (kSlotBits * level)) - 1)) != 0)
+                break;
+            cascade(level);
+        }
+
+        const uint32_t slot = (uint32_t)_currentTick & (kSlots - 1);
+        int32_t due = _heads[slot];
+        _heads[slot] = kNil;
+        while (due != kNil)
+        {
+            const int32_t next = _nodes[due].next;
+            _nodes[due].list = kNil;
+            _nodes[due].prev = _nodes[due].next = kNil;
+            link((NodeId)due, kExpiredList);
+            due = next;
+        }
+    }
+}
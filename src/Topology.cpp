@@ -0,0 +1,187 @@
+#include "Topology.h"
+#include "hal/Hal.h"
+#include <cstdio>
+#include <cstring>
+#ifdef ARDUINO
+#include <ESPAsyncWebServer.h>
+#include "Metrics.h"
+#endif
+
+namespace
+{
+constexpr const char *kTopologyNs = "topo";
+constexpr const char *kTopologyKey = "rings";
+constexpr uint8_t kTopologyVersion = 1;
+constexpr int16_t kMaxPin = 21; // ESP32-C3 GPIO0..21
+
+// 경로표가 플래시에 구워진 배치 (LedDriver의 고정 커널 목록과 같은 순서)
+const Topology *const kKnownTopologies[] = {&kTopologyDual16x24, &kTopologyChain48};
+
+// NVS에는 이름 없이 링 값만 (버전 바이트가 앞에 붙는다)
+struct StoredTopology
+{
+    uint8_t version;
+    RingTopology rings[RING_COUNT];
+};
+
+Topology g_custom = {"custom", {}};
+
+bool ringsOverlap(const RingTopology &a, const RingTopology &b)
+{
+    return a.start < b.start + b.count && b.start < a.start + a.count;
+}
+
+#ifdef ARDUINO
+// "pin,count,start,direction,rotation"
+bool parseRing(const String &text, RingTopology &out)
+{
+    int pin, count, start, direction, rotation;
+    if (sscanf(text.c_str(), "%d,%d,%d,%d,%d", &pin, &count, &start, &direction, &rotation) != 5)
+        return false;
+    if (count <= 0 || count > kMaxPixels || start < 0 || start > 255 || rotation < 0 || rotation >= count)
+        return false;
+    out = {(int16_t)pin, (uint16_t)count, (uint16_t)start, (int8_t)direction, (uint16_t)rotation};
+    return true;
+}
+
+int formatRing(char *out, size_t size, const char *name, const RingTopology &r)
+{
+    return snprintf(out, size, "\"%s\":{\"pin\":%d,\"count\":%u,\"start\":%u,\"direction\":%d,\"rotation\":%u}",
+                    name, r.pin, (unsigned)r.count, (unsigned)r.start, r.direction, (unsigned)r.rotation);
+}
+
+void sendTopology(AsyncWebServerRequest *request, const Topology &active, bool rebootPending)
+{
+    char inner[112], outer[112], body[320];
+    formatRing(inner, sizeof(inner), "inner", active.rings[RING_INNER]);
+    formatRing(outer, sizeof(outer), "outer", active.rings[RING_OUTER]);
+    snprintf(body, sizeof(body), "{\"name\":\"%s\",\"kernel\":\"%s\",\"pixels\":%u,%s,%s,\"rebootPending\":%s}",
+             active.name, topologyKnown(active) ? "fixed" : "runtime", (unsigned)active.pixels(), inner, outer,
+             rebootPending ? "true" : "false");
+    request->send(200, "application/json", body);
+}
+#endif
+
+Topology g_active = kBuildTopology;
+bool g_rebootPending = false;
+} // namespace
+
+bool topologyValid(const Topology &t)
+{
+    if (t.pixels() == 0 || t.pixels() > kMaxPixels)
+        return false;
+    for (uint8_t ring = 0; ring < RING_COUNT; ring++)
+    {
+        const RingTopology &r = t.rings[ring];
+        if (r.count == 0 || r.pin < 0 || r.pin > kMaxPin || (r.direction != 1 && r.direction != -1) || r.rotation >= r.count)
+            return false;
+    }
+    // 같은 스트립이면 두 링이 겹치면 안 된다
+    if (topologyStripCount(t) == 1 && ringsOverlap(t.rings[RING_INNER], t.rings[RING_OUTER]))
+        return false;
+    return true;
+}
+
+bool topologyKnown(const Topology &t)
+{
+    for (const Topology *known : kKnownTopologies)
+    {
+        if (topologySame(t, *known))
+            return true;
+    }
+    return false;
+}
+
+bool topologyLoad(Topology &out)
+{
+    StoredTopology stored;
+    if (hal::storageBytesLength(kTopologyNs, kTopologyKey) != sizeof(stored) ||
+        hal::storageReadBytes(kTopologyNs, kTopologyKey, &stored, sizeof(stored)) != sizeof(stored) ||
+        stored.version != kTopologyVersion)
+        return false;
+
+    Topology t = {"custom", {stored.rings[RING_INNER], stored.rings[RING_OUTER]}};
+    if (!topologyValid(t))
+        return false;
+    // 알려진 배치와 같으면 그 이름을 쓴다 (LedDriver가 고정 커널을 고른다)
+    for (const Topology *known : kKnownTopologies)
+    {
+        if (topologySame(t, *known))
+            t.name = known->name;
+    }
+    out = t;
+    return true;
+}
+
+bool topologySave(const Topology &t)
+{
+    if (!topologyValid(t))
+        return false;
+    StoredTopology stored = {kTopologyVersion, {t.rings[RING_INNER], t.rings[RING_OUTER]}};
+    return hal::storageWriteBytes(kTopologyNs, kTopologyKey, &stored, sizeof(stored)) == sizeof(stored);
+}
+
+void topologyClear()
+{
+    StoredTopology stored = {};
+    hal::storageWriteBytes(kTopologyNs, kTopologyKey, &stored, sizeof(stored)); // 버전 0 = 없음
+}
+
+const Topology &topologyForBoot()
+{
+    if (topologyLoad(g_custom))
+        g_active = g_custom;
+    else
+        g_active = kBuildTopology;
+    return g_active;
+}
+
+#ifdef ARDUINO
+void topologyAttach(AsyncWebServer &server)
+{
+    // GET  /topology                              지금 쓰는 배치와 커널 종류
+    // POST /topology?layout=chain-48              알려진 배치로
+    // POST /topology?inner=4,16,0,1,0&outer=...   직접 (pin,count,start,direction,rotation)
+    // POST /topology?reset=1                      저장된 배치를 지우고 빌드 배치로
+    // 바꾼 배치는 재부팅 뒤에 적용된다 (LED 출력과 레이어 크기가 부팅 때 정해진다).
+    server.on("/topology", HTTP_GET, [](AsyncWebServerRequest *request)
+              {
+        const uint32_t startUs = micros();
+        sendTopology(request, g_active, g_rebootPending);
+        metricsRecordHttp(ROUTE_TOPOLOGY, micros() - startUs); });
+
+    server.on("/topology", HTTP_POST, [](AsyncWebServerRequest *request)
+              {
+        const uint32_t startUs = micros();
+        bool ok = false;
+        if (request->hasParam("reset"))
+        {
+            topologyClear();
+            ok = true;
+        }
+        else if (request->hasParam("layout"))
+        {
+            const String &name = request->getParam("layout")->value();
+            for (const Topology *known : kKnownTopologies)
+            {
+                if (name == known->name)
+                    ok = topologySave(*known);
+            }
+        }
+        else if (request->hasParam("inner") && request->hasParam("outer"))
+        {
+            Topology t = {"custom", {}};
+            ok = parseRing(request->getParam("inner")->value(), t.rings[RING_INNER]) &&
+                 parseRing(request->getParam("outer")->value(), t.rings[RING_OUTER]) && topologySave(t);
+        }
+
+        if (!ok)
+            request->send(400, "application/json", "{\"status\":\"error\",\"reason\":\"invalid_topology\"}");
+        else
+        {
+            g_rebootPending = true;
+            sendTopology(request, g_active, g_rebootPending);
+        }
+        metricsRecordHttp(ROUTE_TOPOLOGY, micros() - startUs); });
+}
+#endif
@@ -0,0 +1,249 @@
+#include "WebLogger.h"
+#include "AllocTracker.h"
+#include <ESPAsyncWebServer.h>
+#include <atomic>
+#include <cstring>
+
+extern AsyncWebSocket wsLog;
+
+namespace
+{
+constexpr uint32_t kLogSlotCount = 32; // 2의 거듭제곱
+constexpr uint32_t kLogSlotMask = kLogSlotCount - 1;
+constexpr size_t kLogLineMax = 256; // 드레인 쪽에서 포맷한 한 줄
+constexpr size_t kLogHistoryCount = 24;
+constexpr size_t kLogBatchMax = 1024;
+constexpr size_t kReplaySlotCount = 4;
+
+constexpr uint32_t kDrainIntervalMs = 20;
+constexpr uint32_t kWsRateLinesPerSec = 20;
+constexpr uint32_t kWsRateBurst = 40;
+
+// Bounded MPSC queue (Vyukov). seq는 슬롯 인덱스를 뺀 값으로 저장해서
+// 0 초기화 상태가 곧 "모든 슬롯 비어 있음"이 되도록 한다.
+// 슬롯에는 포맷 전 레코드가 들어간다 (LogRecord.h).
+struct LogSlot
+{
+    std::atomic<uint32_t> seq;
+    LogRecord record;
+};
+
+LogSlot g_slots[kLogSlotCount];
+std::atomic<uint32_t> g_enqueuePos{0};
+uint32_t g_dequeuePos = 0; // 드레인 태스크 전용
+
+std::atomic<uint8_t> g_minLevel{LOG_LEVEL_INFO};
+std::atomic<uint32_t> g_droppedCount{0};
+std::atomic<uint32_t> g_replayRequests[kReplaySlotCount];
+TaskHandle_t g_drainTask = nullptr;
+
+// 아래는 드레인 태스크만 접근한다. 기록도 레코드로 두고 재전송할 때 포맷한다.
+LogRecord g_history[kLogHistoryCount];
+size_t g_historyHead = 0;
+size_t g_historyCount = 0;
+char g_batch[kLogBatchMax];
+size_t g_batchLen = 0;
+char g_line[kLogLineMax];
+
+LogSlot *reserveSlot(uint32_t &pos)
+{
+    pos = g_enqueuePos.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        LogSlot &slot = g_slots[pos & kLogSlotMask];
+        const uint32_t seq = slot.seq.load(std::memory_order_acquire) + (pos & kLogSlotMask);
+        const int32_t diff = (int32_t)(seq - pos);
+        if (diff == 0)
+        {
+            if (g_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                return &slot;
+        }
+        else if (diff < 0)
+        {
+            return nullptr; // 가득 참: 생산자는 절대 기다리지 않는다
+        }
+        else
+        {
+            pos = g_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void publishSlot(LogSlot *slot, uint32_t pos)
+{
+    slot->seq.store(pos + 1 - (pos & kLogSlotMask), std::memory_order_release);
+}
+
+bool levelEnabled(LogLevel level)
+{
+    return (uint8_t)level >= g_minLevel.load(std::memory_order_relaxed);
+}
+
+bool popRecord(LogRecord &out)
+{
+    LogSlot &slot = g_slots[g_dequeuePos & kLogSlotMask];
+    const uint32_t seq = slot.seq.load(std::memory_order_acquire) + (g_dequeuePos & kLogSlotMask);
+    if ((int32_t)(seq - (g_dequeuePos + 1)) < 0)
+        return false;
+
+    out = slot.record;
+    slot.seq.store(g_dequeuePos + kLogSlotCount - (g_dequeuePos & kLogSlotMask), std::memory_order_release);
+    g_dequeuePos++;
+    return true;
+}
+
+size_t formatLine(const LogRecord &record)
+{
+    AllocScope scope(ALLOC_LOG); // newlib 부동소수점 포맷은 할당할 수 있다
+    return logRecordFormat(record, g_line, sizeof(g_line));
+}
+
+void rememberRecord(const LogRecord &record)
+{
+    g_history[g_historyHead] = record;
+    g_historyHead = (g_historyHead + 1) % kLogHistoryCount;
+    if (g_historyCount < kLogHistoryCount)
+        g_historyCount++;
+}
+
+void flushBatch(uint32_t clientId)
+{
+    if (g_batchLen == 0)
+        return;
+    AllocScope scope(ALLOC_LOG);
+    if (clientId == 0)
+        wsLog.textAll(g_batch, g_batchLen);
+    else
+        wsLog.text(clientId, g_batch, g_batchLen);
+    g_batchLen = 0;
+}
+
+// 여러 줄을 '\n'으로 이어 한 번의 WebSocket 메시지로 보낸다.
+void appendBatch(const char *text, size_t len, uint32_t clientId)
+{
+    if (g_batchLen && g_batchLen + len + 1 > kLogBatchMax)
+        flushBatch(clientId);
+    if (g_batchLen)
+        g_batch[g_batchLen++] = '\n';
+    memcpy(g_batch + g_batchLen, text, len);
+    g_batchLen += len;
+}
+
+void serviceReplayRequests()
+{
+    for (size_t i = 0; i < kReplaySlotCount; i++)
+    {
+        const uint32_t clientId = g_replayRequests[i].exchange(0, std::memory_order_acq_rel);
+        if (clientId == 0)
+            continue;
+
+        const size_t oldest = (g_historyHead + kLogHistoryCount - g_historyCount) % kLogHistoryCount;
+        for (size_t n = 0; n < g_historyCount; n++)
+        {
+            const size_t idx = (oldest + n) % kLogHistoryCount;
+            appendBatch(g_line, formatLine(g_history[idx]), clientId);
+        }
+        flushBatch(clientId);
+    }
+}
+
+void drainTask(void *)
+{
+    static LogRecord record;
+    uint32_t tokens = kWsRateBurst;
+    uint32_t lastRefillAt = millis();
+    uint32_t suppressed = 0;
+
+    for (;;)
+    {
+        const uint32_t now = millis();
+        const uint32_t refill = (now - lastRefillAt) * kWsRateLinesPerSec / 1000;
+        if (refill > 0)
+        {
+            tokens = min(kWsRateBurst, tokens + refill);
+            lastRefillAt = now;
+        }
+
+        serviceReplayRequests();
+
+        const bool hasClients = wsLog.count() > 0;
+        while (popRecord(record))
+        {
+            const size_t len = formatLine(record);
+            Serial.write(reinterpret_cast<const uint8_t *>(g_line), len);
+            Serial.write('\n');
+            rememberRecord(record);
+
+            if (!hasClients)
+                continue;
+            if (tokens == 0)
+            {
+                suppressed++;
+                continue;
+            }
+            tokens--;
+            appendBatch(g_line, len, 0);
+        }
+
+        if (suppressed > 0 && tokens > 0)
+        {
+            char note[48];
+            const int n = snprintf(note, sizeof(note), "[Log] %u lines suppressed", (unsigned)suppressed);
+            appendBatch(note, (size_t)n, 0);
+            g_droppedCount.fetch_add(suppressed, std::memory_order_relaxed);
+            suppressed = 0;
+            tokens--;
+        }
+        flushBatch(0);
+
+        vTaskDelay(pdMS_TO_TICKS(kDrainIntervalMs));
+    }
+}
+} // namespace
+
+LogRecord *webLogReserve(LogLevel level, uint32_t &ticket)
+{
+    if (!levelEnabled(level))
+        return nullptr;
+    LogSlot *slot = reserveSlot(ticket);
+    if (slot == nullptr)
+    {
+        g_droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    return &slot->record;
+}
+
+void webLogCommit(LogRecord *, uint32_t ticket)
+{
+    publishSlot(&g_slots[ticket & kLogSlotMask], ticket);
+}
+
+void webLogBegin()
+{
+    if (g_drainTask != nullptr)
+        return;
+    // loop()와 같은 우선순위: loop가 delay(0)로 양보할 때 돌고, 네트워크 태스크보다는 낮다.
+    // 포맷(vsnprintf 계열)이 이 태스크에서 돌기 때문에 스택을 넉넉히 둔다.
+    xTaskCreate(drainTask, "logDrain", 4096, nullptr, 1, &g_drainTask);
+}
+
+void webLogSetMinLevel(LogLevel level)
+{
+    g_minLevel.store(level, std::memory_order_relaxed);
+}
+
+void webLogRequestReplay(uint32_t clientId)
+{
+    for (size_t i = 0; i < kReplaySlotCount; i++)
+    {
+        uint32_t expected = 0;
+        if (g_replayRequests[i].compare_exchange_strong(expected, clientId, std::memory_order_acq_rel))
+            return;
+    }
+}
+
+uint32_t webLogDroppedCount()
+{
+    return g_droppedCount.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,318 @@
+#include "WifiLink.h"
+#include <WiFi.h>
+#include <WiFiManager.h>
+#include <esp_wifi.h>
+#include <esp_rom_crc.h>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <time.h>
+#include "BootSequence.h"
+#include "WebLogger.h"
+#include "hal/Hal.h"
+
+namespace
+{
+constexpr uint32_t kCacheMagic = 0x57464C31; // "WFL1"
+constexpr const char *kCacheNs = "wifi";
+constexpr const char *kCacheKey = "link";
+constexpr uint32_t kCachedConnectTimeoutMs = 1500; // 캐시 AP가 이 안에 안 붙으면 스캔으로
+constexpr uint32_t kScanConnectTimeoutMs = 10000;
+constexpr uint16_t kPortalTimeoutSec = 180;
+constexpr time_t kValidEpoch = 1600000000;
+// 지난 임대를 DHCP 없이 다시 쓰는 한도. 소프트 리셋은 몇 초라 공유기는 아직 같은 임대로 기억한다.
+constexpr time_t kLeaseReuseSec = 600;
+constexpr uint32_t kBackoffMinMs = 500;
+constexpr uint32_t kBackoffMaxMs = 60000;
+constexpr uint32_t kAttemptTimeoutMs = 8000; // 시도 하나를 포기하고 다음 백오프로
+
+struct LinkCache
+{
+    uint32_t magic;
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint8_t reserved;
+    uint32_t ip;
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns;
+    uint32_t savedAt; // 벽시계 (시각이 없었으면 0: 임대를 다시 쓰지 않는다)
+    uint32_t crc;     // 위 필드들의 CRC32
+};
+
+RTC_NOINIT_ATTR LinkCache g_rtcCache; // 소프트 리셋에는 남고, 전원을 넣은 직후에는 쓰레기 (CRC로 거른다)
+LinkCache g_cache = {};
+bool g_cacheValid = false;
+bool g_leaseReusable = false; // RTC 캐시가 최근 것일 때만 (부팅 첫 시도 한 번)
+
+// 이벤트 태스크가 쓰고 loop/메트릭이 읽는다
+std::atomic<bool> g_connected{false};
+std::atomic<uint32_t> g_connects{0};
+std::atomic<uint32_t> g_cachedConnects{0};
+std::atomic<uint32_t> g_lastConnectMs{0};
+std::atomic<uint32_t> g_outages{0};
+std::atomic<uint32_t> g_outageMsTotal{0};
+std::atomic<uint32_t> g_outageStartMs{0}; // 0이면 끊김 없음
+std::atomic<uint32_t> g_attemptStartMs{0};
+std::atomic<bool> g_attemptCached{false};
+std::atomic<bool> g_cacheDirty{false}; // 새로 붙었다: loop가 캐시를 갱신한다
+std::atomic<bool> g_supervise{false};  // 부팅 연결이 끝났고 저장된 AP가 있다: 끊기면 loop가 다시 붙는다
+
+// loop 태스크 전용
+uint8_t g_backoffStep = 0;
+uint32_t g_nextAttemptMs = 0;
+bool g_retryPending = false;
+bool g_attemptInFlight = false;
+bool g_staticLease = false; // 지난 임대를 고정 IP로 걸고 붙었다: 연결되면 DHCP로 되돌린다
+
+uint32_t cacheCrc(const LinkCache &c)
+{
+    return esp_rom_crc32_le(0, reinterpret_cast<const uint8_t *>(&c), offsetof(LinkCache, crc));
+}
+
+bool cacheOk(const LinkCache &c)
+{
+    return c.magic == kCacheMagic && c.crc == cacheCrc(c) && c.channel != 0;
+}
+
+void loadCache()
+{
+    if (cacheOk(g_rtcCache))
+    {
+        g_cache = g_rtcCache;
+        const time_t now = time(nullptr);
+        g_leaseReusable = g_cache.savedAt != 0 && now >= kValidEpoch && now - (time_t)g_cache.savedAt < kLeaseReuseSec;
+    }
+    else if (hal::storageReadBytes(kCacheNs, kCacheKey, &g_cache, sizeof(g_cache)) != sizeof(g_cache) || !cacheOk(g_cache))
+    {
+        return;
+    }
+    g_cacheValid = true;
+}
+
+void saveCache()
+{
+    if (WiFi.status() != WL_CONNECTED)
+        return;
+    LinkCache c = {};
+    c.magic = kCacheMagic;
+    memcpy(c.bssid, WiFi.BSSID(), sizeof(c.bssid));
+    c.channel = (uint8_t)WiFi.channel();
+    c.ip = (uint32_t)WiFi.localIP();
+    c.gateway = (uint32_t)WiFi.gatewayIP();
+    c.subnet = (uint32_t)WiFi.subnetMask();
+    c.dns = (uint32_t)WiFi.dnsIP();
+    const time_t now = time(nullptr);
+    c.savedAt = now >= kValidEpoch ? (uint32_t)now : 0;
+    c.crc = cacheCrc(c);
+    g_rtcCache = c;
+
+    // NVS는 AP/채널/주소가 바뀔 때만 (재연결마다 플래시를 쓰지 않는다)
+    const bool changed = !g_cacheValid || memcmp(c.bssid, g_cache.bssid, sizeof(c.bssid)) != 0 || c.channel != g_cache.channel ||
+                         c.ip != g_cache.ip || c.gateway != g_cache.gateway || c.subnet != g_cache.subnet || c.dns != g_cache.dns;
+    g_cache = c;
+    g_cacheValid = true;
+    if (changed)
+        hal::storageWriteBytes(kCacheNs, kCacheKey, &c, sizeof(c));
+}
+
+// WiFiManager가 저장해 둔 AP (IDF의 WiFi 설정)
+bool storedCredentials(char ssid[33], char pass[65])
+{
+    wifi_config_t conf;
+    if (esp_wifi_get_config(WIFI_IF_STA, &conf) != ESP_OK || conf.sta.ssid[0] == 0)
+        return false;
+    memcpy(ssid, conf.sta.ssid, 32);
+    ssid[32] = '\0';
+    memcpy(pass, conf.sta.password, 64);
+    pass[64] = '\0';
+    return true;
+}
+
+// 연결을 시작만 한다 (결과는 이벤트로)
+bool beginAttempt(bool useCache)
+{
+    char ssid[33], pass[65];
+    if (!storedCredentials(ssid, pass))
+        return false;
+
+    g_attemptStartMs.store(millis(), std::memory_order_relaxed);
+    g_attemptCached.store(useCache, std::memory_order_relaxed);
+    g_staticLease = useCache && g_leaseReusable;
+    if (g_staticLease)
+        WiFi.config(IPAddress(g_cache.ip), IPAddress(g_cache.gateway), IPAddress(g_cache.subnet), IPAddress(g_cache.dns));
+    else
+        WiFi.config(IPAddress((uint32_t)0), IPAddress((uint32_t)0), IPAddress((uint32_t)0)); // DHCP
+    g_leaseReusable = false;
+
+    if (useCache)
+        WiFi.begin(ssid, pass, g_cache.channel, g_cache.bssid, true);
+    else
+        WiFi.begin(ssid, pass);
+    return true;
+}
+
+bool waitConnected(uint32_t timeoutMs)
+{
+    const uint32_t start = millis();
+    while (millis() - start < timeoutMs)
+    {
+        if (WiFi.status() == WL_CONNECTED)
+            return true;
+        hal::sleepMs(20);
+    }
+    return WiFi.status() == WL_CONNECTED;
+}
+
+void scheduleRetry(uint32_t now)
+{
+    const uint32_t base = min(kBackoffMaxMs, kBackoffMinMs << min<uint8_t>(g_backoffStep, 7));
+    // ±25% 지터: 공유기가 재부팅되면 여러 대가 한꺼번에 몰리지 않게
+    g_nextAttemptMs = now + base - base / 4 + esp_random() % (base / 2 + 1);
+    g_retryPending = true;
+    if (g_backoffStep < 255)
+        g_backoffStep++;
+}
+
+void onWiFiEvent(arduino_event_id_t event, arduino_event_info_t info)
+{
+    const uint32_t now = millis();
+    if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP)
+    {
+        if (g_connected.exchange(true, std::memory_order_relaxed))
+        {
+            // 연결 중에 다시 받은 IP (지난 임대 → DHCP 전환, 임대 갱신으로 주소가 바뀜): 캐시만 고친다
+            g_cacheDirty.store(true, std::memory_order_release);
+            return;
+        }
+        g_connects.fetch_add(1, std::memory_order_relaxed);
+        g_lastConnectMs.store(now - g_attemptStartMs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        if (g_attemptCached.load(std::memory_order_relaxed))
+            g_cachedConnects.fetch_add(1, std::memory_order_relaxed);
+        const uint32_t outageStart = g_outageStartMs.exchange(0, std::memory_order_relaxed);
+        if (outageStart != 0)
+            g_outageMsTotal.fetch_add(now - outageStart, std::memory_order_relaxed);
+        g_cacheDirty.store(true, std::memory_order_release);
+    }
+    else if (event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED)
+    {
+        if (g_connected.exchange(false, std::memory_order_relaxed))
+        {
+            g_outages.fetch_add(1, std::memory_order_relaxed);
+            g_outageStartMs.store(now | 1, std::memory_order_relaxed);
+        }
+    }
+}
+} // namespace
+
+bool wifiLinkConnect()
+{
+    WiFi.onEvent(onWiFiEvent);
+    WiFi.mode(WIFI_STA);
+    WiFi.setAutoReconnect(false); // 재연결은 wifiLinkLoop가 맡는다
+    loadCache();
+
+    char ssid[33], pass[65];
+    bool connected = false;
+    if (g_cacheValid && beginAttempt(true))
+    {
+        connected = waitConnected(kCachedConnectTimeoutMs);
+        if (connected)
+            bootPhaseNote(BOOT_PHASE_WIFI, "cached");
+        else
+            WiFi.disconnect();
+    }
+    if (!connected && beginAttempt(false))
+    {
+        connected = waitConnected(kScanConnectTimeoutMs);
+        if (connected)
+            bootPhaseNote(BOOT_PHASE_WIFI, "scan");
+        else
+            WiFi.disconnect();
+    }
+    if (!connected)
+    {
+        // 저장된 AP가 없거나 안 보인다: 설정 포털
+        WiFiManager wm;
+        wm.setTimeout(kPortalTimeoutSec);
+        g_attemptStartMs.store(millis(), std::memory_order_relaxed);
+        g_attemptCached.store(false, std::memory_order_relaxed);
+        connected = wm.autoConnect("timetape_setup");
+        WiFi.setAutoReconnect(false);
+        bootPhaseNote(BOOT_PHASE_WIFI, connected ? "portal" : "portal_timeout");
+    }
+
+    if (connected)
+    {
+        g_cacheDirty.store(false, std::memory_order_relaxed);
+        saveCache();
+        WEBLOG_INFO("[WiFi] Connected in %u ms (%s)", (unsigned)g_lastConnectMs.load(std::memory_order_relaxed),
+                    g_attemptCached.load(std::memory_order_relaxed) ? "cached BSSID" : "scan");
+    }
+    // 부팅 때 못 붙었어도 저장된 AP가 있으면 loop가 백오프로 계속 시도한다
+    g_supervise.store(connected || storedCredentials(ssid, pass), std::memory_order_release);
+    return connected;
+}
+
+void wifiLinkLoop()
+{
+    if (!g_supervise.load(std::memory_order_acquire))
+        return;
+    if (g_cacheDirty.exchange(false, std::memory_order_acquire))
+        saveCache();
+
+    const uint32_t now = millis();
+    if (g_connected.load(std::memory_order_relaxed))
+    {
+        if (g_staticLease)
+        {
+            // 지난 임대는 빨리 붙기 위한 것이다: 계속 쥐고 있으면 공유기가 임대를 만료시켜도 모른다
+            g_staticLease = false;
+            WiFi.config(IPAddress((uint32_t)0), IPAddress((uint32_t)0), IPAddress((uint32_t)0)); // DHCP 다시 시작
+            WEBLOG_INFO("[WiFi] Reused lease, renewing it over DHCP");
+        }
+        if (g_backoffStep != 0)
+            WEBLOG_INFO("[WiFi] Reconnected in %u ms", (unsigned)g_lastConnectMs.load(std::memory_order_relaxed));
+        g_backoffStep = 0;
+        g_retryPending = false;
+        g_attemptInFlight = false;
+        return;
+    }
+
+    if (g_attemptInFlight)
+    {
+        if (now - g_attemptStartMs.load(std::memory_order_relaxed) < kAttemptTimeoutMs)
+            return; // 아직 붙는 중
+        g_attemptInFlight = false;
+    }
+    if (!g_retryPending)
+    {
+        if (g_backoffStep == 0)
+            WEBLOG_WARN("[WiFi] Link lost, reconnecting in background");
+        scheduleRetry(now);
+        return;
+    }
+    if ((int32_t)(now - g_nextAttemptMs) < 0)
+        return;
+
+    // 처음 두 번은 캐시 AP로 (공유기 재부팅이면 같은 채널로 돌아온다), 그 뒤로는 스캔 (AP가 바뀌었을 수 있다)
+    g_retryPending = false;
+    WiFi.disconnect();
+    g_attemptInFlight = beginAttempt(g_cacheValid && g_backoffStep <= 2);
+}
+
+bool wifiLinkConnected()
+{
+    return g_connected.load(std::memory_order_relaxed);
+}
+
+void wifiLinkGetStats(WifiLinkStats &out)
+{
+    const uint32_t outageStart = g_outageStartMs.load(std::memory_order_relaxed);
+    out.connected = g_connected.load(std::memory_order_relaxed);
+    out.connects = g_connects.load(std::memory_order_relaxed);
+    out.cachedConnects = g_cachedConnects.load(std::memory_order_relaxed);
+    out.lastConnectMs = g_lastConnectMs.load(std::memory_order_relaxed);
+    out.outages = g_outages.load(std::memory_order_relaxed);
+    out.outageMsTotal = g_outageMsTotal.load(std::memory_order_relaxed) + (outageStart != 0 ? millis() - outageStart : 0);
+}
@@ -0,0 +1,100 @@
+#ifdef TIME_TAPE_BENCH
+#include "Bench.h"
+#include "hal/Hal.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+constexpr uint32_t kMinSampleUs = 20000; // 샘플 하나의 최소 길이 (타이머 해상도 대비 충분히 길게)
+constexpr uint32_t kMaxIters = 1u << 24;
+constexpr int kSamples = 5;
+
+volatile uint32_t g_sink = 0;
+
+void benchWrite(const char *line)
+{
+#ifdef ARDUINO
+    Serial.println(line);
+#else
+    puts(line);
+    fflush(stdout);
+#endif
+}
+
+uint32_t cycleNow()
+{
+#ifdef ARDUINO
+    return ESP.getCycleCount();
+#else
+    return 0;
+#endif
+}
+
+uint32_t timeIters(BenchFn fn, void *ctx, uint32_t iters, uint32_t &cycles)
+{
+    const uint32_t startCycles = cycleNow();
+    const uint32_t startUs = hal::nowUs();
+    for (uint32_t i = 0; i < iters; i++)
+        fn(ctx);
+    const uint32_t elapsedUs = hal::nowUs() - startUs;
+    cycles = cycleNow() - startCycles;
+    return elapsedUs;
+}
+}
+
+void benchKeep(uint32_t value)
+{
+    g_sink = g_sink + value;
+}
+
+void benchBegin(const char *target)
+{
+    char line[160];
+    snprintf(line, sizeof(line), "{\"meta\":\"time-tape-bench\",\"target\":\"%s\",\"min_sample_us\":%lu,\"samples\":%d}",
+             target, (unsigned long)kMinSampleUs, kSamples);
+    benchWrite(line);
+}
+
+void benchEnd()
+{
+    char line[64];
+    snprintf(line, sizeof(line), "{\"meta\":\"done\",\"sink\":%lu}", (unsigned long)g_sink);
+    benchWrite(line);
+}
+
+void benchRun(const char *bench, const char *caseName, int n, BenchFn fn, void *ctx, uint32_t bytes)
+{
+    // 보정: 샘플 하나가 kMinSampleUs를 넘을 때까지 반복 횟수를 두 배씩
+    uint32_t iters = 1;
+    uint32_t cycles = 0;
+    fn(ctx); // 워밍업 (캐시/지연 초기화)
+    while (iters < kMaxIters && timeIters(fn, ctx, iters, cycles) < kMinSampleUs)
+        iters *= 2;
+
+    double nsPerOp[kSamples];
+    double cyclesPerOp[kSamples];
+    for (int s = 0; s < kSamples; s++)
+    {
+        const uint32_t us = timeIters(fn, ctx, iters, cycles);
+        nsPerOp[s] = (double)us * 1000.0 / iters;
+        cyclesPerOp[s] = (double)cycles / iters;
+    }
+    std::sort(nsPerOp, nsPerOp + kSamples);
+    std::sort(cyclesPerOp, cyclesPerOp + kSamples);
+
+    char line[320];
+    int len = snprintf(line, sizeof(line), "{\"bench\":\"%s\",\"case\":\"%s\"", bench, caseName);
+    if (n >= 0)
+        len += snprintf(line + len, sizeof(line) - len, ",\"n\":%d", n);
+    len += snprintf(line + len, sizeof(line) - len, ",\"iters\":%lu,\"ns_per_op\":%.1f,\"min_ns_per_op\":%.1f",
+                    (unsigned long)iters, nsPerOp[kSamples / 2], nsPerOp[0]);
+#ifdef ARDUINO
+    len += snprintf(line + len, sizeof(line) - len, ",\"cycles_per_op\":%.0f", cyclesPerOp[kSamples / 2]);
+#endif
+    if (bytes > 0)
+        len += snprintf(line + len, sizeof(line) - len, ",\"bytes\":%lu", (unsigned long)bytes);
+    snprintf(line + len, sizeof(line) - len, "}");
+    benchWrite(line);
+}
+#endif
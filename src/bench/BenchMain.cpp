@@ -0,0 +1,361 @@
+#ifdef TIME_TAPE_BENCH
+// 렌더/시간/설정 핫패스 마이크로벤치마크.
+// 호스트: pio run -e bench-native && .pio/build/bench-native/program > bench.jsonl
+// 기기:   pio run -e bench-esp32 -t upload && pio device monitor (같은 형식이 시리얼로 나온다)
+#include "Bench.h"
+#include "Config.h"
+#include "ConfigCodec.h"
+#include "TimeLogic.h"
+#include "graphics/ColorUtils.h"
+#include "graphics/Effects.h"
+#include "graphics/AnimatedEffects.h"
+#include "graphics/Transition.h"
+#include "drivers/LedDriver.h"
+#include <vector>
+
+namespace
+{
+const int kPresetCounts[] = {1, 10, 100};
+
+// ---- 렌더 ----
+
+struct EffectCase
+{
+    IEffect *effect;
+    Layer *layer;
+    float progress;
+    uint32_t timeMs;
+};
+
+void benchEffectRender(void *ctx)
+{
+    EffectCase &c = *static_cast<EffectCase *>(ctx);
+    c.effect->render(*c.layer, kBuildTopology.offset(RING_OUTER), kBuildTopology.count(RING_OUTER), c.progress, 0xFF4000, 0x0040FF, 0x050505, c.timeMs);
+    benchKeep(c.layer->getPixelColor(kBuildTopology.offset(RING_OUTER)));
+    c.progress += 0.0137f; // 경계 픽셀 위치가 매번 바뀌도록
+    c.timeMs += 20;        // 전환 중 프레임 간격 (애니메이션 효과의 위상도 매번 바뀐다)
+    if (c.progress > 1.0f)
+        c.progress -= 1.0f;
+}
+
+struct BlendCase
+{
+    float ratio;
+};
+
+void benchBlend(void *ctx)
+{
+    BlendCase &c = *static_cast<BlendCase *>(ctx);
+    benchKeep(ColorUtils::blend(0xFF8000, 0x0080FF, c.ratio));
+    c.ratio += 0.01f;
+    if (c.ratio > 1.0f)
+        c.ratio = 0.0f;
+}
+
+struct ComposeCase
+{
+    Compositor compositor;
+    uint32_t nowMs;
+};
+
+void benchCompose(void *ctx)
+{
+    // 바탕 + 반투명 오버레이 + 페이드 중인 시스템 레이어 (모든 경로를 탄다)
+    ComposeCase &c = *static_cast<ComposeCase *>(ctx);
+    uint32_t pixels[Layer::kPixels];
+    uint8_t segments[3];
+    c.compositor.compose(c.nowMs, pixels, segments, kBuildTopology.pixels());
+    benchKeep(pixels[kBuildTopology.offset(RING_OUTER)] ^ segments[0]);
+    c.nowMs = (c.nowMs + 1) % 1000;
+}
+
+struct WipeCase
+{
+    Compositor compositor;
+    Transition transition;
+    uint32_t nowMs;
+};
+
+void benchWipeStep(void *ctx)
+{
+    WipeCase &c = *static_cast<WipeCase *>(ctx);
+    if (!c.transition.step(c.compositor, c.nowMs))
+    {
+        c.nowMs = 0;
+        c.transition.begin(c.compositor, TRANSITION_WIPE, 1000, 0);
+    }
+    benchKeep(c.compositor.layer(LAYER_TRANSITION).alpha(kBuildTopology.offset(RING_OUTER)));
+    c.nowMs += 7;
+}
+
+struct LedFrameCase
+{
+    LedDriver leds;
+    uint32_t pixels[kMaxPixels];
+};
+
+void benchLedWriteFrame(void *ctx)
+{
+    LedFrameCase &c = *static_cast<LedFrameCase *>(ctx);
+    c.leds.writeFrame(c.pixels);
+    benchKeep(c.leds.getPixelColor(1));
+    c.pixels[1]++;
+}
+
+// ---- 시간 ----
+
+struct ProgressCase
+{
+    int mode;
+    struct tm now;
+    String startDate;
+    String targetDate;
+};
+
+void benchProgress(void *ctx)
+{
+    ProgressCase &c = *static_cast<ProgressCase *>(ctx);
+    struct tm t = c.now; // 모드 4는 mktime으로 t를 정규화한다
+    const float p = calculateProgress(c.mode, &t, c.startDate.c_str(), c.targetDate.c_str());
+    benchKeep((uint32_t)(p * 1000000.0f));
+}
+
+void benchParseDate(void *ctx)
+{
+    const String &date = *static_cast<const String *>(ctx);
+    benchKeep((uint32_t)parseDate(date.c_str()));
+}
+
+// ---- 설정 ----
+
+// 실제 설정과 비슷하게 모드/페이로드가 섞인 프리셋 n개
+void makeConfig(AppConfig &config, int presetCount)
+{
+    config = AppConfig();
+    config.ddays.push_back({"새해", "2025-01-01", "2026-01-01"});
+    config.ddays.push_back({"project", "2025-03-01", "2025-09-30"});
+    for (int i = 0; i < presetCount; i++)
+    {
+        Preset p;
+        p.inner.mode = i % 6;
+        p.inner.colorMode = i % 4;
+        p.inner.colorFill = 0xFF0000 + i;
+        p.inner.colorFill2 = 0x00FF00;
+        p.inner.colorEmpty = 0x000010;
+        if (p.inner.mode == 4)
+            payloadSetDDay(p.inner.payload, i % 2);
+        else
+            payloadSetNone(p.inner.payload);
+
+        switch (i % 4)
+        {
+        case 0:
+            p.outer.mode = MODE_TIMER;
+            payloadSetTimer(p.outer.payload, 300 + i, true);
+            break;
+        case 1:
+            p.outer.mode = MODE_POMODORO;
+            payloadSetPomodoro(p.outer.payload, 25, 5, false);
+            break;
+        case 2:
+            p.outer.mode = MODE_COUNTER;
+            payloadSetCounter(p.outer.payload, 100 + i);
+            break;
+        default:
+            p.outer.mode = 3;
+            payloadSetNone(p.outer.payload);
+            break;
+        }
+        p.outer.colorMode = (i + 1) % 4;
+        p.outer.colorFill = 0x0000FF;
+        p.outer.colorFill2 = 0xFFFF00;
+        p.outer.colorEmpty = 0;
+
+        p.segment.mode = 1 + (i % 4);
+        payloadSetNone(p.segment.payload);
+        config.presets.push_back(p);
+    }
+    config.schedules.push_back({SCHEDULE_WEEKDAYS, 9, 0, 0});
+    config.schedules.push_back({SCHEDULE_EVERY_DAY, 22, 30, presetCount - 1});
+}
+
+struct ConfigCase
+{
+    AppConfig config;
+    JsonDocument doc;
+    std::vector<uint8_t> msgpack;
+    String json;
+    std::vector<uint8_t> out;
+};
+
+void benchToJson(void *ctx)
+{
+    ConfigCase &c = *static_cast<ConfigCase *>(ctx);
+    JsonDocument doc;
+    configToJson(doc, c.config);
+    benchKeep(doc.size());
+}
+
+void benchFromJson(void *ctx)
+{
+    ConfigCase &c = *static_cast<ConfigCase *>(ctx);
+    AppConfig parsed;
+    benchKeep(configFromJson(c.doc, parsed) ? parsed.presets.size() : 0);
+}
+
+void benchSerializeJson(void *ctx)
+{
+    ConfigCase &c = *static_cast<ConfigCase *>(ctx);
+    benchKeep(serializeJson(c.doc, (char *)c.out.data(), c.out.size()));
+}
+
+void benchSerializeMsgPack(void *ctx)
+{
+    ConfigCase &c = *static_cast<ConfigCase *>(ctx);
+    benchKeep(serializeMsgPack(c.doc, c.out.data(), c.out.size()));
+}
+
+void benchDeserializeJson(void *ctx)
+{
+    ConfigCase &c = *static_cast<ConfigCase *>(ctx);
+    JsonDocument doc;
+    benchKeep(deserializeJson(doc, c.json) ? 0 : doc.size());
+}
+
+void benchDeserializeMsgPack(void *ctx)
+{
+    ConfigCase &c = *static_cast<ConfigCase *>(ctx);
+    JsonDocument doc;
+    benchKeep(deserializeMsgPack(doc, c.msgpack.data(), c.msgpack.size()) ? 0 : doc.size());
+}
+
+void runRenderSuite()
+{
+    Layer layer;
+    SolidEffect solid;
+    RainbowEffect rainbow;
+    TimeGradientEffect timeGradient;
+    SpaceGradientEffect spaceGradient;
+    BreathingEffect breathing;
+    CometEffect comet;
+    SparkleEffect sparkle;
+    RotatingRainbowEffect rotatingRainbow;
+
+    struct
+    {
+        const char *name;
+        IEffect *effect;
+    } effects[] = {{"solid", &solid}, {"rainbow", &rainbow}, {"time_gradient", &timeGradient}, {"space_gradient", &spaceGradient},
+                   {"breathing", &breathing}, {"comet", &comet}, {"sparkle", &sparkle}, {"rotating_rainbow", &rotatingRainbow}};
+
+    for (auto &e : effects)
+    {
+        EffectCase c = {e.effect, &layer, 0.0f, 0};
+        benchRun("effect.render", e.name, kBuildTopology.count(RING_OUTER), benchEffectRender, &c);
+    }
+
+    BlendCase blend = {0.0f};
+    benchRun("color.blend", "blend", -1, benchBlend, &blend);
+
+    static ComposeCase compose; // 레이어 세 장 (~650B)은 스택에 두지 않는다
+    rainbow.render(compose.compositor.layer(LAYER_BASE), kBuildTopology.offset(RING_INNER), kBuildTopology.count(RING_INNER), 0.7f, 0, 0, 0x050505, 0);
+    rainbow.render(compose.compositor.layer(LAYER_BASE), kBuildTopology.offset(RING_OUTER), kBuildTopology.count(RING_OUTER), 0.3f, 0, 0, 0x050505, 0);
+    for (uint16_t n = 0; n < Layer::kPixels; n += 2)
+    {
+        compose.compositor.layer(LAYER_OVERLAY).setPixel(n, 0xFFFFFF, 96);
+        compose.compositor.layer(LAYER_SYSTEM).setPixelColor(n + 1, 0x2040FF);
+    }
+    compose.compositor.show(LAYER_BASE, 0);
+    compose.compositor.show(LAYER_OVERLAY, 0);
+    compose.compositor.show(LAYER_SYSTEM, 0, 100000, 100000); // 늘 페이드 구간
+    benchRun("compositor.compose", "3_layers", kBuildTopology.pixels(), benchCompose, &compose);
+
+    static WipeCase wipe;
+    wipe.compositor.show(LAYER_BASE, 0);
+    wipe.transition.begin(wipe.compositor, TRANSITION_WIPE, 1000, 0);
+    benchRun("transition.step", "wipe", kBuildTopology.pixels(), benchWipeStep, &wipe);
+
+    // 같은 40픽셀을 컴파일된 경로표로 / begin()에서 만든 경로표로 (안쪽 링을 뒤집고 돌린 변형)
+    static const Topology kVariant = {"custom", {{4, 16, 0, -1, 3}, {3, 24, 0, 1, 0}}};
+    static LedFrameCase fixedFrame;
+    fixedFrame.leds.begin(kBuildTopology);
+    benchRun("led.write_frame", "fixed", kBuildTopology.pixels(), benchLedWriteFrame, &fixedFrame);
+    static LedFrameCase runtimeFrame;
+    runtimeFrame.leds.begin(kVariant);
+    benchRun("led.write_frame", "runtime", kVariant.pixels(), benchLedWriteFrame, &runtimeFrame);
+}
+
+void runTimeSuite()
+{
+    static const char *kModeNames[] = {"year", "month", "week", "day", "dday", "quarter"};
+    struct tm now = {};
+    now.tm_year = 2025 - 1900;
+    now.tm_mon = 4;
+    now.tm_mday = 17;
+    now.tm_hour = 13;
+    now.tm_min = 42;
+    now.tm_sec = 7;
+    mktime(&now); // yday/wday 채우기
+
+    for (int mode = 0; mode <= 5; mode++)
+    {
+        ProgressCase c = {mode, now, "2025-01-01", "2026-01-01"};
+        benchRun("time.progress", kModeNames[mode], -1, benchProgress, &c);
+    }
+
+    String date = "2025-05-17";
+    benchRun("time.parse_date", "parseDate", -1, benchParseDate, &date);
+}
+
+void runConfigSuite()
+{
+    for (int presets : kPresetCounts)
+    {
+        ConfigCase *c = new ConfigCase();
+        makeConfig(c->config, presets);
+        configToJson(c->doc, c->config);
+        serializeJson(c->doc, c->json);
+        c->msgpack.resize(measureMsgPack(c->doc));
+        serializeMsgPack(c->doc, c->msgpack.data(), c->msgpack.size());
+        c->out.resize(c->json.length() + 1);
+
+        benchRun("config.to_json", "configToJson", presets, benchToJson, c);
+        benchRun("config.from_json", "configFromJson", presets, benchFromJson, c);
+        benchRun("config.serialize", "json", presets, benchSerializeJson, c, c->json.length());
+        benchRun("config.serialize", "msgpack", presets, benchSerializeMsgPack, c, c->msgpack.size());
+        benchRun("config.deserialize", "json", presets, benchDeserializeJson, c, c->json.length());
+        benchRun("config.deserialize", "msgpack", presets, benchDeserializeMsgPack, c, c->msgpack.size());
+        delete c;
+    }
+}
+
+void runAll(const char *target)
+{
+    benchBegin(target);
+    runRenderSuite();
+    runTimeSuite();
+    runConfigSuite();
+    benchEnd();
+}
+}
+
+#ifdef ARDUINO
+void setup()
+{
+    Serial.begin(115200);
+    delay(2000); // 시리얼 모니터가 붙을 시간
+    runAll("esp32-c3");
+}
+
+void loop()
+{
+    delay(1000);
+}
+#else
+int main()
+{
+    runAll("native");
+    return 0;
+}
+#endif
+#endif
@@ -1,44 +1,86 @@
 #include "drivers/LedDriver.h"
 
-LedDriver::LedDriver(uint16_t innerCount, int16_t innerPin, uint16_t outerCount, int16_t outerPin, neoPixelType type)
-    : _inner(innerCount, innerPin, type), 
-      _outer(outerCount, outerPin, type),
-      _innerCount(innerCount),
-      _outerCount(outerCount) {}
+// 배치가 상수라 경로표 읽기가 상수로 접히고 루프가 배치마다 따로 만들어진다
+// (dual-16-24는 두 스트립으로 곧장 복사하는 루프가 된다)
+template <const Topology& T>
+void LedDriver::writeFixed(LedDriver& self, const uint32_t* pixels) {
+    constexpr auto& table = FixedRoutes<T>::kTable;
+    for (uint16_t n = 0; n < FixedRoutes<T>::kPixels; n++) {
+        self._strips[table.routes[n].strip].setPixelColor(table.routes[n].index, pixels[n]);
+    }
+}
+
+void LedDriver::writeRuntime(LedDriver& self, const uint32_t* pixels) {
+    for (uint16_t n = 0; n < self._pixels; n++) {
+        self._strips[self._routes[n].strip].setPixelColor(self._routes[n].index, pixels[n]);
+    }
+}
 
-void LedDriver::begin() {
-    _inner.begin();
-    _outer.begin();
+// Topology.cpp의 알려진 배치 목록과 같이 고친다
+LedDriver::FrameKernel LedDriver::kernelFor(const Topology& topology) {
+    if (topologySame(topology, kTopologyDual16x24))
+        return &LedDriver::writeFixed<kTopologyDual16x24>;
+    if (topologySame(topology, kTopologyChain48))
+        return &LedDriver::writeFixed<kTopologyChain48>;
+    return &LedDriver::writeRuntime;
+}
+
+void LedDriver::begin(const Topology& topology) {
+    _stripCount = topologyStripCount(topology);
+    _pixels = topology.pixels();
+    for (uint16_t n = 0; n < _pixels; n++) {
+        _routes[n] = topologyRoute(topology, n);
+    }
+    _kernel = kernelFor(topology);
+
+    for (uint8_t s = 0; s < _stripCount; s++) {
+        const uint8_t ring = (s == 0) ? RING_INNER : RING_OUTER;
+        _strips[s].updateType(NEO_GRB + NEO_KHZ800);
+        _strips[s].updateLength(topologyStripLength(topology, s));
+        _strips[s].setPin(topology.rings[ring].pin);
+        _strips[s].begin();
+    }
 }
 
 void LedDriver::show() {
-    _inner.show();
-    _outer.show();
+    for (uint8_t s = 0; s < _stripCount; s++) {
+        _strips[s].show();
+    }
 }
 
 void LedDriver::clear() {
-    _inner.clear();
-    _outer.clear();
+    for (uint8_t s = 0; s < _stripCount; s++) {
+        _strips[s].clear();
+    }
 }
 
 void LedDriver::setBrightness(uint8_t brightness) {
-    _inner.setBrightness(brightness);
-    _outer.setBrightness(brightness);
+    for (uint8_t s = 0; s < _stripCount; s++) {
+        _strips[s].setBrightness(brightness);
+    }
+}
+
+void LedDriver::writeFrame(const uint32_t* pixels) {
+    _kernel(*this, pixels);
 }
 
-// n이 0 ~ (innerCount-1) 이면 안쪽, 그 이상이면 바깥쪽으로 자동 매핑
 void LedDriver::setPixelColor(uint16_t n, uint32_t c) {
-    if (n < _innerCount) {
-        _inner.setPixelColor(n, c);
-    } else {
-        _outer.setPixelColor(n - _innerCount, c);
+    if (n < _pixels) {
+        _strips[_routes[n].strip].setPixelColor(_routes[n].index, c);
     }
 }
 
+uint32_t LedDriver::getPixelColor(uint16_t n) const {
+    if (n >= _pixels) {
+        return 0;
+    }
+    return _strips[_routes[n].strip].getPixelColor(_routes[n].index);
+}
+
 uint32_t LedDriver::Color(uint8_t r, uint8_t g, uint8_t b) {
-    return _inner.Color(r, g, b); // 어느쪽을 쓰든 동일
+    return _strips[0].Color(r, g, b); // 어느쪽을 쓰든 동일
 }
 
 uint32_t LedDriver::ColorHSV(uint16_t hue, uint8_t sat, uint8_t val) {
-    return _inner.ColorHSV(hue, sat, val);
-}
\ No newline at end of file
+    return _strips[0].ColorHSV(hue, sat, val);
+}
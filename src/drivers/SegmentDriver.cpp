@@ -1,48 +1,66 @@
 #include "drivers/SegmentDriver.h"
 
+namespace {
+constexpr uint32_t kBlank = 0xFFFFFF;
+}
+
 SegmentDriver::SegmentDriver(int sclkPin, int loadPin, int sdiPin)
     : _sclkPin(sclkPin), _loadPin(loadPin), _sdiPin(sdiPin) {}
 
 void SegmentDriver::begin() {
-    pinMode(_sclkPin, OUTPUT);
-    pinMode(_loadPin, OUTPUT);
-    pinMode(_sdiPin, OUTPUT);
+    hal::pinOutput(_sclkPin);
+    hal::pinOutput(_loadPin);
+    hal::pinOutput(_sdiPin);
+    shift(kBlank);
+    _pwm = hal::startPeriodicIsr(kPwmTickHz, onTick, this);
 }
 
-void SegmentDriver::drawRaw(byte h, byte t, byte o) {
-    digitalWrite(_loadPin, LOW);
-    shiftOut(_sdiPin, _sclkPin, MSBFIRST, o);
-    shiftOut(_sdiPin, _sclkPin, MSBFIRST, t);
-    shiftOut(_sdiPin, _sclkPin, MSBFIRST, h);
-    digitalWrite(_loadPin, HIGH);
-}
-
-void SegmentDriver::drawNumber(int num, int dpPos, bool isOff) {
-    if (isOff) {
-        digitalWrite(_loadPin, LOW);
-        shiftOut(_sdiPin, _sclkPin, MSBFIRST, 0xFF);
-        shiftOut(_sdiPin, _sclkPin, MSBFIRST, 0xFF);
-        shiftOut(_sdiPin, _sclkPin, MSBFIRST, 0xFF);
-        digitalWrite(_loadPin, HIGH);
-        return;
+void IRAM_ATTR SegmentDriver::shift(uint32_t pattern) {
+    hal::writePin(_loadPin, false);
+    hal::shiftOutMsb(_sdiPin, _sclkPin, pattern & 0xFF);
+    hal::shiftOutMsb(_sdiPin, _sclkPin, (pattern >> 8) & 0xFF);
+    hal::shiftOutMsb(_sdiPin, _sclkPin, (pattern >> 16) & 0xFF);
+    hal::writePin(_loadPin, true);
+}
+
+void IRAM_ATTR SegmentDriver::onTick(void *self) {
+    SegmentDriver *d = static_cast<SegmentDriver *>(self);
+    const uint8_t phase = d->_phase;
+    d->_phase = (phase + 1) % kPwmSteps;
+
+    const uint32_t want = phase < d->_duty.load(std::memory_order_relaxed)
+                              ? d->_pattern.load(std::memory_order_relaxed)
+                              : kBlank;
+    if (want != d->_latched) {
+        d->shift(want);
+        d->_latched = want;
     }
+}
 
-    int h = (num / 100) % 10;
-    int t = (num / 10) % 10;
-    int o = num % 10;
+void SegmentDriver::latch(byte h, byte t, byte o) {
+    _raw[0] = h;
+    _raw[1] = t;
+    _raw[2] = o;
+    const uint32_t pattern = ((uint32_t)h << 16) | ((uint32_t)t << 8) | o;
+    if (_pwm)
+        _pattern.store(pattern, std::memory_order_relaxed); // 다음 틱에 인터럽트가 래치
+    else
+        shift(pattern);
+}
 
-    byte pH = digitPatterns[h];
-    byte pT = digitPatterns[t];
-    byte pO = digitPatterns[o];
+void SegmentDriver::drawRaw(byte h, byte t, byte o) {
+    latch(h, t, o);
+}
 
-    if (dpPos == 2) pH &= 0x7F;
-    if (dpPos == 1) pT &= 0x7F;
+void SegmentDriver::drawSegments(const uint8_t lit[3]) {
+    // 공통 애노드: 비트가 0이면 점등
+    latch(~lit[0], ~lit[1], ~lit[2]);
+}
 
-    digitalWrite(_loadPin, LOW);
-    shiftOut(_sdiPin, _sclkPin, MSBFIRST, pO);
-    shiftOut(_sdiPin, _sclkPin, MSBFIRST, pT);
-    shiftOut(_sdiPin, _sclkPin, MSBFIRST, pH);
-    digitalWrite(_loadPin, HIGH);
+void SegmentDriver::setBrightness(uint8_t brightness) {
+    // 0이 아니면 최소 한 칸은 켠다 (야간 밝기 1~15도 보이게)
+    const uint8_t duty = (uint8_t)(((uint32_t)brightness * kPwmSteps + 254) / 255);
+    _duty.store(duty, std::memory_order_relaxed);
 }
 
 void SegmentDriver::test() {
@@ -0,0 +1,295 @@
+#ifdef ARDUINO
+#include "hal/Hal.h"
+#include <NTPClient.h>
+#include <Preferences.h>
+#include <WiFi.h>
+#include <WiFiUdp.h>
+#include <sys/time.h>
+#include <esp_heap_caps.h>
+#include <soc/gpio_reg.h>
+#include <soc/soc.h>
+
+namespace
+{
+WiFiUDP g_ntpUdp;
+NTPClient g_timeClient(g_ntpUdp, "pool.ntp.org");
+WiFiUDP g_multicastUdp;
+bool g_multicastOpen = false;
+
+struct TaskStart
+{
+    void (*fn)(void *);
+    void *arg;
+};
+
+// 주기 인터럽트 (하나만)
+hw_timer_t *g_isrTimer = nullptr;
+void (*g_isrFn)(void *) = nullptr;
+void *g_isrArg = nullptr;
+volatile uint32_t g_isrCalls = 0;
+volatile uint32_t g_isrBusyUs = 0;
+uint32_t g_isrBusyCycles = 0; // us로 옮기기 전 나머지
+uint32_t g_cyclesPerUs = 160;
+
+void ARDUINO_ISR_ATTR isrTrampoline()
+{
+    const uint32_t start = ESP.getCycleCount();
+    g_isrFn(g_isrArg);
+    g_isrBusyCycles += ESP.getCycleCount() - start;
+    g_isrCalls = g_isrCalls + 1;
+    if (g_isrBusyCycles >= 1000 * g_cyclesPerUs)
+    {
+        g_isrBusyUs = g_isrBusyUs + g_isrBusyCycles / g_cyclesPerUs;
+        g_isrBusyCycles %= g_cyclesPerUs;
+    }
+}
+
+void taskTrampoline(void *p)
+{
+    TaskStart start = *static_cast<TaskStart *>(p);
+    delete static_cast<TaskStart *>(p);
+    start.fn(start.arg);
+    vTaskDelete(NULL);
+}
+}
+
+namespace hal
+{
+uint32_t nowMs()
+{
+    return millis();
+}
+
+uint32_t nowUs()
+{
+    return micros();
+}
+
+uint64_t uptimeMs()
+{
+    return (uint64_t)esp_timer_get_time() / 1000ULL;
+}
+
+void sleepMs(uint32_t ms)
+{
+    delay(ms);
+}
+
+time_t wallTime()
+{
+    return time(nullptr);
+}
+
+bool localTime(struct tm *out)
+{
+    return getLocalTime(out, 0); // 기본값은 시각이 생길 때까지 5초를 기다린다
+}
+
+void timeZoneBegin(long gmtOffsetSec)
+{
+    // configTime()과 같은 고정 오프셋 TZ (POSIX TZ는 부호가 반대)
+    char tz[24];
+    const long offsetMin = gmtOffsetSec / 60;
+    const long absMin = offsetMin < 0 ? -offsetMin : offsetMin;
+    snprintf(tz, sizeof(tz), "UTC%c%ld:%02ld", offsetMin > 0 ? '-' : '+', absMin / 60, absMin % 60);
+    setenv("TZ", tz, 1);
+    tzset();
+}
+
+void wallClockBegin(long gmtOffsetSec)
+{
+    g_timeClient.begin();
+    g_timeClient.setTimeOffset(gmtOffsetSec);
+    configTime(gmtOffsetSec, 0, "pool.ntp.org", "time.nist.gov");
+}
+
+void setWallClock(time_t epoch)
+{
+    struct timeval tv = {epoch, 0};
+    settimeofday(&tv, nullptr);
+}
+
+void pinOutput(uint8_t pin)
+{
+    pinMode(pin, OUTPUT);
+}
+
+void pinInputPullup(uint8_t pin)
+{
+    pinMode(pin, INPUT_PULLUP);
+}
+
+// ESP32-C3의 GPIO는 0~21이라 OUT 레지스터 하나로 끝난다 (digitalWrite는 IRAM에 없다)
+void IRAM_ATTR writePin(uint8_t pin, bool high)
+{
+    REG_WRITE(high ? GPIO_OUT_W1TS_REG : GPIO_OUT_W1TC_REG, 1UL << pin);
+}
+
+bool readPin(uint8_t pin)
+{
+    return digitalRead(pin) == HIGH;
+}
+
+void IRAM_ATTR shiftOutMsb(uint8_t dataPin, uint8_t clockPin, uint8_t value)
+{
+    for (int bit = 7; bit >= 0; bit--)
+    {
+        writePin(dataPin, (value >> bit) & 1);
+        writePin(clockPin, true);
+        writePin(clockPin, false);
+    }
+}
+
+bool startPeriodicIsr(uint32_t hz, void (*fn)(void *), void *arg)
+{
+    if (g_isrTimer != nullptr || hz == 0)
+        return false;
+    g_isrFn = fn;
+    g_isrArg = arg;
+    g_cyclesPerUs = getCpuFrequencyMhz();
+#if ESP_ARDUINO_VERSION_MAJOR >= 3
+    g_isrTimer = timerBegin(1000000); // 1 MHz
+    if (g_isrTimer == nullptr)
+        return false;
+    timerAttachInterrupt(g_isrTimer, isrTrampoline);
+    timerAlarm(g_isrTimer, 1000000 / hz, true, 0);
+#else
+    g_isrTimer = timerBegin(0, 80, true); // 80 MHz APB / 80 = 1 MHz
+    if (g_isrTimer == nullptr)
+        return false;
+    timerAttachInterrupt(g_isrTimer, isrTrampoline, true);
+    timerAlarmWrite(g_isrTimer, 1000000 / hz, true);
+    timerAlarmEnable(g_isrTimer);
+#endif
+    return true;
+}
+
+void periodicIsrStats(uint32_t &calls, uint32_t &busyUs)
+{
+    calls = g_isrCalls;
+    busyUs = g_isrBusyUs;
+}
+
+bool startTask(void (*fn)(void *), const char *name, uint32_t stackBytes, void *arg)
+{
+    TaskStart *start = new TaskStart{fn, arg};
+    BaseType_t taskResult = pdFAIL;
+#if defined(CONFIG_FREERTOS_NUMBER_OF_CORES) && (CONFIG_FREERTOS_NUMBER_OF_CORES > 1)
+    taskResult = xTaskCreatePinnedToCore(taskTrampoline, name, stackBytes, start, 1, NULL, 1);
+#else
+    taskResult = xTaskCreate(taskTrampoline, name, stackBytes, start, 1, NULL);
+#endif
+    if (taskResult != pdPASS)
+    {
+        delete start;
+        return false;
+    }
+    return true;
+}
+
+bool networkReady()
+{
+    return WiFi.status() == WL_CONNECTED;
+}
+
+bool multicastOpen(const uint8_t group[4], uint16_t port)
+{
+    multicastClose();
+    g_multicastOpen = g_multicastUdp.beginMulticast(IPAddress(group[0], group[1], group[2], group[3]), port);
+    return g_multicastOpen;
+}
+
+void multicastClose()
+{
+    if (g_multicastOpen)
+        g_multicastUdp.stop();
+    g_multicastOpen = false;
+}
+
+bool multicastSend(const void *data, size_t len)
+{
+    if (!g_multicastOpen)
+        return false;
+    g_multicastUdp.beginMulticastPacket();
+    g_multicastUdp.write(static_cast<const uint8_t *>(data), len);
+    return g_multicastUdp.endPacket();
+}
+
+int multicastReceive(void *out, size_t len)
+{
+    if (!g_multicastOpen || g_multicastUdp.parsePacket() <= 0)
+        return -1;
+    return g_multicastUdp.read(static_cast<uint8_t *>(out), len);
+}
+
+size_t storageWriteBytes(const char *ns, const char *key, const void *data, size_t len)
+{
+    Preferences prefs;
+    if (!prefs.begin(ns, false))
+        return 0;
+    const size_t written = prefs.putBytes(key, data, len);
+    prefs.end();
+    return written;
+}
+
+size_t storageWriteString(const char *ns, const char *key, const String &value)
+{
+    Preferences prefs;
+    if (!prefs.begin(ns, false))
+        return 0;
+    const size_t written = prefs.putString(key, value);
+    prefs.end();
+    return written;
+}
+
+size_t storageBytesLength(const char *ns, const char *key)
+{
+    Preferences prefs;
+    if (!prefs.begin(ns, true))
+        return 0;
+    const size_t len = prefs.getBytesLength(key);
+    prefs.end();
+    return len;
+}
+
+size_t storageReadBytes(const char *ns, const char *key, void *out, size_t len)
+{
+    Preferences prefs;
+    if (!prefs.begin(ns, true))
+        return 0;
+    const size_t read = prefs.getBytes(key, out, len);
+    prefs.end();
+    return read;
+}
+
+String storageReadString(const char *ns, const char *key, const char *fallback)
+{
+    Preferences prefs;
+    if (!prefs.begin(ns, true))
+        return String(fallback);
+    String value = prefs.getString(key, fallback);
+    prefs.end();
+    return value;
+}
+
+uintptr_t currentTaskId()
+{
+    return reinterpret_cast<uintptr_t>(xTaskGetCurrentTaskHandle());
+}
+
+size_t heapBlockSize(void *ptr)
+{
+    return heap_caps_get_allocated_size(ptr);
+}
+
+uint32_t heapFreeBytes()
+{
+    return ESP.getFreeHeap();
+}
+
+uint32_t heapLargestFreeBlock()
+{
+    return ESP.getMaxAllocHeap();
+}
+} // namespace hal
+#endif
@@ -0,0 +1,412 @@
+#ifndef ARDUINO
+#include "hal/HalNative.h"
+#include "WebLogger.h"
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <fcntl.h>
+#include <malloc.h>
+#include <map>
+#include <mutex>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+namespace
+{
+constexpr time_t kValidEpoch = 1451606400; // 2016-01-01: getLocalTime()과 같은 기준
+
+std::mutex g_mutex;
+const std::chrono::steady_clock::time_point g_bootAt = std::chrono::steady_clock::now();
+
+// 수동 시계 (g_mutex)
+bool g_manualClock = false;
+uint64_t g_manualMs = 0;
+std::thread::id g_clockThread;
+time_t g_wallBase = 0;
+uint64_t g_wallBaseUptime = 0;
+
+// GPIO (g_mutex)
+std::map<uint8_t, bool> g_pins;
+// shiftOutMsb 기록: 고정 크기 링 (프레임마다 쌓여도 할당하지 않는다)
+constexpr size_t kShiftLogMax = 256;
+uint8_t g_shifted[kShiftLogMax];
+size_t g_shiftedTotal = 0;
+
+// NVS (g_mutex). 키는 "네임스페이스/키"
+std::map<std::string, std::vector<uint8_t>> g_storage;
+
+// 멀티캐스트 소켓 (SyncManager 하나만, loop 스레드에서만 쓴다)
+int g_multicastSocket = -1;
+sockaddr_in g_multicastGroup = {};
+
+std::atomic<int> g_liveTasks{0};
+std::atomic<uint8_t> g_minLevel{LOG_LEVEL_INFO};
+
+uint64_t uptimeLocked()
+{
+    if (g_manualClock)
+        return g_manualMs;
+    return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - g_bootAt).count();
+}
+
+std::string storageKey(const char *ns, const char *key)
+{
+    return std::string(ns) + "/" + key;
+}
+
+void writeLine(const char *msg)
+{
+    fputs(msg, stdout);
+    fputc('\n', stdout);
+}
+
+
+bool levelEnabled(LogLevel level)
+{
+    return (uint8_t)level >= g_minLevel.load(std::memory_order_relaxed);
+}
+}
+
+namespace hal
+{
+uint32_t nowMs()
+{
+    return (uint32_t)uptimeMs();
+}
+
+uint32_t nowUs()
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    if (g_manualClock)
+        return (uint32_t)(g_manualMs * 1000ULL);
+    return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - g_bootAt).count();
+}
+
+uint64_t uptimeMs()
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    return uptimeLocked();
+}
+
+void sleepMs(uint32_t ms)
+{
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        if (g_manualClock && std::this_thread::get_id() == g_clockThread)
+        {
+            g_manualMs += ms;
+            if (g_liveTasks.load() == 0)
+                return;
+            // 백그라운드 태스크가 살아 있으면 실제로도 자서 그쪽이 진행할 틈을 준다
+        }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+time_t wallTime()
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    if (g_wallBase == 0)
+        return time(nullptr);
+    return g_wallBase + (time_t)((uptimeLocked() - g_wallBaseUptime) / 1000ULL);
+}
+
+bool localTime(struct tm *out)
+{
+    const time_t now = wallTime();
+    if (now < kValidEpoch)
+        return false;
+    localtime_r(&now, out);
+    return true;
+}
+
+void wallClockBegin(long gmtOffsetSec)
+{
+    timeZoneBegin(gmtOffsetSec); // 호스트에는 NTP가 없다
+}
+
+void timeZoneBegin(long gmtOffsetSec)
+{
+    // configTime()처럼 고정 오프셋 TZ를 건다 (POSIX TZ는 부호가 반대)
+    char tz[24];
+    const long offsetMin = gmtOffsetSec / 60;
+    const long absMin = offsetMin < 0 ? -offsetMin : offsetMin;
+    snprintf(tz, sizeof(tz), "UTC%c%ld:%02ld", offsetMin > 0 ? '-' : '+', absMin / 60, absMin % 60);
+    setenv("TZ", tz, 1);
+    tzset();
+}
+
+void setWallClock(time_t epoch)
+{
+    native::setWallTime(epoch);
+}
+
+void pinOutput(uint8_t pin)
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_pins.emplace(pin, false);
+}
+
+void pinInputPullup(uint8_t pin)
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_pins.emplace(pin, true);
+}
+
+void writePin(uint8_t pin, bool high)
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_pins[pin] = high;
+}
+
+bool readPin(uint8_t pin)
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    auto it = g_pins.find(pin);
+    return it == g_pins.end() ? true : it->second;
+}
+
+void shiftOutMsb(uint8_t dataPin, uint8_t clockPin, uint8_t value)
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_shifted[g_shiftedTotal++ % kShiftLogMax] = value;
+}
+
+bool startPeriodicIsr(uint32_t hz, void (*fn)(void *), void *arg)
+{
+    return false;
+}
+
+void periodicIsrStats(uint32_t &calls, uint32_t &busyUs)
+{
+    calls = 0;
+    busyUs = 0;
+}
+
+bool startTask(void (*fn)(void *), const char *name, uint32_t stackBytes, void *arg)
+{
+    g_liveTasks++;
+    std::thread([fn, arg]()
+                {
+                    fn(arg);
+                    g_liveTasks--;
+                })
+        .detach();
+    return true;
+}
+
+bool networkReady()
+{
+    return true;
+}
+
+bool multicastOpen(const uint8_t group[4], uint16_t port)
+{
+    multicastClose();
+    const int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock < 0)
+        return false;
+
+    // 한 호스트에서 여러 인스턴스가 같은 포트에 붙는다 (멀티캐스트는 모두에게 한 부씩 간다)
+    const int one = 1;
+    setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    g_multicastGroup = {};
+    g_multicastGroup.sin_family = AF_INET;
+    g_multicastGroup.sin_port = htons(port);
+    memcpy(&g_multicastGroup.sin_addr.s_addr, group, 4);
+
+    in_addr loopback = {};
+    loopback.s_addr = htonl(INADDR_LOOPBACK);
+    ip_mreq membership = {};
+    membership.imr_multiaddr = g_multicastGroup.sin_addr;
+    membership.imr_interface = loopback;
+    const unsigned char loop = 1;
+
+    if (bind(sock, reinterpret_cast<const sockaddr *>(&g_multicastGroup), sizeof(g_multicastGroup)) != 0 ||
+        setsockopt(sock, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) != 0 ||
+        setsockopt(sock, IPPROTO_IP, IP_MULTICAST_IF, &loopback, sizeof(loopback)) != 0 ||
+        setsockopt(sock, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop)) != 0 ||
+        fcntl(sock, F_SETFL, fcntl(sock, F_GETFL) | O_NONBLOCK) != 0)
+    {
+        close(sock);
+        return false;
+    }
+    g_multicastSocket = sock;
+    return true;
+}
+
+void multicastClose()
+{
+    if (g_multicastSocket >= 0)
+        close(g_multicastSocket);
+    g_multicastSocket = -1;
+}
+
+bool multicastSend(const void *data, size_t len)
+{
+    if (g_multicastSocket < 0)
+        return false;
+    return sendto(g_multicastSocket, data, len, 0, reinterpret_cast<const sockaddr *>(&g_multicastGroup),
+                  sizeof(g_multicastGroup)) == (ssize_t)len;
+}
+
+int multicastReceive(void *out, size_t len)
+{
+    if (g_multicastSocket < 0)
+        return -1;
+    const ssize_t n = recv(g_multicastSocket, out, len, 0);
+    return n < 0 ? -1 : (int)n;
+}
+
+size_t storageWriteBytes(const char *ns, const char *key, const void *data, size_t len)
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    g_storage[storageKey(ns, key)].assign(bytes, bytes + len);
+    return len;
+}
+
+size_t storageWriteString(const char *ns, const char *key, const String &value)
+{
+    return storageWriteBytes(ns, key, value.c_str(), value.length());
+}
+
+size_t storageBytesLength(const char *ns, const char *key)
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    auto it = g_storage.find(storageKey(ns, key));
+    return it == g_storage.end() ? 0 : it->second.size();
+}
+
+size_t storageReadBytes(const char *ns, const char *key, void *out, size_t len)
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    auto it = g_storage.find(storageKey(ns, key));
+    if (it == g_storage.end() || it->second.size() > len)
+        return 0;
+    memcpy(out, it->second.data(), it->second.size());
+    return it->second.size();
+}
+
+String storageReadString(const char *ns, const char *key, const char *fallback)
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    auto it = g_storage.find(storageKey(ns, key));
+    if (it == g_storage.end())
+        return String(fallback);
+    return String(std::string(it->second.begin(), it->second.end()));
+}
+
+uintptr_t currentTaskId()
+{
+    return (uintptr_t)pthread_self();
+}
+
+size_t heapBlockSize(void *ptr)
+{
+    return malloc_usable_size(ptr);
+}
+
+uint32_t heapFreeBytes()
+{
+    return 0;
+}
+
+uint32_t heapLargestFreeBlock()
+{
+    return 0;
+}
+
+namespace native
+{
+void useManualClock(uint64_t startMs)
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_manualClock = true;
+    g_manualMs = startMs;
+    g_clockThread = std::this_thread::get_id();
+}
+
+void advanceMs(uint64_t ms)
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_manualMs += ms;
+}
+
+void setWallTime(time_t epoch)
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_wallBase = epoch;
+    g_wallBaseUptime = uptimeLocked();
+}
+
+void setPinLevel(uint8_t pin, bool high)
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_pins[pin] = high;
+}
+
+bool pinLevel(uint8_t pin)
+{
+    return readPin(pin);
+}
+
+std::vector<uint8_t> takeShiftedBytes()
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    const size_t count = g_shiftedTotal < kShiftLogMax ? g_shiftedTotal : kShiftLogMax;
+    std::vector<uint8_t> out(count);
+    for (size_t i = 0; i < count; i++)
+        out[i] = g_shifted[(g_shiftedTotal - count + i) % kShiftLogMax];
+    g_shiftedTotal = 0;
+    return out;
+}
+
+void clearStorage()
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_storage.clear();
+}
+} // namespace native
+} // namespace hal
+
+// ---- 로그: WebLogger.h 인터페이스를 표준 출력으로 ----
+
+// 호스트에는 드레인 태스크가 없다: 커밋하는 자리에서 바로 포맷해서 쓴다.
+LogRecord *webLogReserve(LogLevel level, uint32_t &ticket)
+{
+    static thread_local LogRecord record;
+    ticket = 0;
+    return levelEnabled(level) ? &record : nullptr;
+}
+
+void webLogCommit(LogRecord *record, uint32_t ticket)
+{
+    char line[256];
+    logRecordFormat(*record, line, sizeof(line));
+    writeLine(line);
+}
+
+void webLogBegin()
+{
+}
+
+void webLogSetMinLevel(LogLevel level)
+{
+    g_minLevel.store(level, std::memory_order_relaxed);
+}
+
+void webLogRequestReplay(uint32_t clientId)
+{
+}
+
+uint32_t webLogDroppedCount()
+{
+    return 0;
+}
+#endif
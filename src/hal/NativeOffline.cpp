@@ -0,0 +1,38 @@
+#ifndef ARDUINO
+// 호스트 빌드에는 네트워크/파일시스템 모듈이 없다. 코어 모듈이 부르는 진입점만 오프라인 동작으로 채운다.
+#include "FrameStream.h"
+#include "HistoryLog.h"
+#include "Metrics.h"
+#include "hal/HalNative.h"
+
+namespace
+{
+hal::native::FrameSink g_frameSink = nullptr;
+void *g_frameSinkCtx = nullptr;
+}
+
+void hal::native::setFrameSink(FrameSink sink, void *ctx)
+{
+    g_frameSink = sink;
+    g_frameSinkCtx = ctx;
+}
+
+bool frameStreamActive()
+{
+    return g_frameSink != nullptr;
+}
+
+void frameStreamPublish(const uint32_t *pixels, uint8_t count, uint8_t brightness, const uint8_t seg[3])
+{
+    if (g_frameSink)
+        g_frameSink(pixels, count, brightness, seg, g_frameSinkCtx);
+}
+
+void historyRecord(HistoryEventType type, uint32_t value)
+{
+}
+
+void metricsRecordNvsWrite(size_t bytes)
+{
+}
+#endif
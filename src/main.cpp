@@ -6,6 +6,15 @@
 #include "NetworkManager.h"
 #include "TimeLogic.h"
 #include "WebLogger.h"
+#include "RemoteControl.h"
+#include "StateStream.h"
+#include "SyncManager.h"
+#include "TimerEngine.h"
+#include "Scheduler.h"
+#include "HistoryLog.h"
+#include "AllocTracker.h"
+#include "BootSequence.h"
+#include "WifiLink.h"
 
 // OTA
 #include <ArduinoOTA.h>
@@ -14,12 +23,14 @@
 DisplayManager display;
 ButtonManager buttons;
 
+static bool otaReady = false;
+
 static void setupOTA()
 {
   // WiFi 연결이 되어 있어야 함
   if (WiFi.status() != WL_CONNECTED)
   {
-    webLog("[OTA] WiFi not connected, OTA will not start");
+    WEBLOG_INFO("[OTA] WiFi not connected, OTA will not start");
     return;
   }
 
@@ -27,75 +38,124 @@ static void setupOTA()
       .onStart([]()
                {
                  String type = (ArduinoOTA.getCommand() == U_FLASH) ? "sketch" : "filesystem";
-                 webLogf("[OTA] Start updating %s", type.c_str());
+                 WEBLOG_INFO("[OTA] Start updating %s", type.c_str());
                  // OTA 중에는 타이밍 민감할 수 있으니 필요하면 디스플레이 갱신/애니메이션을 멈추는 것도 방법
                })
       .onEnd([]()
-             { webLog("\n[OTA] End"); })
+             { WEBLOG_INFO("\n[OTA] End"); })
       .onProgress([](unsigned int progress, unsigned int total)
-                  { webLogf("[OTA] Progress: %u%%", (progress * 100U) / total); })
+                  {
+                    // 콜백은 청크마다 불리므로 퍼센트가 바뀔 때만 기록
+                    static unsigned int lastPercent = 101;
+                    const unsigned int percent = (total > 0) ? (progress * 100U) / total : 0;
+                    if (percent != lastPercent)
+                    {
+                      lastPercent = percent;
+                      WEBLOG_INFO("[OTA] Progress: %u%%", percent);
+                    } })
       .onError([](ota_error_t error)
                {
-      webLogf("\n[OTA] Error[%u]: ", error);
-      if (error == OTA_AUTH_ERROR) webLog("Auth Failed");
-      else if (error == OTA_BEGIN_ERROR) webLog("Begin Failed");
-      else if (error == OTA_CONNECT_ERROR) webLog("Connect Failed");
-      else if (error == OTA_RECEIVE_ERROR) webLog("Receive Failed");
-      else if (error == OTA_END_ERROR) webLog("End Failed"); });
+      WEBLOG_INFO("\n[OTA] Error[%u]: ", error);
+      if (error == OTA_AUTH_ERROR) WEBLOG_INFO("Auth Failed");
+      else if (error == OTA_BEGIN_ERROR) WEBLOG_INFO("Begin Failed");
+      else if (error == OTA_CONNECT_ERROR) WEBLOG_INFO("Connect Failed");
+      else if (error == OTA_RECEIVE_ERROR) WEBLOG_INFO("Receive Failed");
+      else if (error == OTA_END_ERROR) WEBLOG_INFO("End Failed"); });
 
   ArduinoOTA.begin();
-  webLogf("[OTA] Ready. IP: %s", WiFi.localIP().toString().c_str());
+  otaReady = true;
+  WEBLOG_INFO("[OTA] Ready. IP: %s", WiFi.localIP().toString().c_str());
 }
 
+// 느린 단계를 태스크로 보낸 뒤 남은 부팅을 loop에서 한 걸음씩 진행한다 (setup은 바로 끝난다).
+static const BootSteps kBootSteps = {
+  timeSourceReady,
+  wifiLinkConnected,
+  []() {
+    schedulerReload(); // 시각이 없을 때 잡은 계획을 다시
+    display.stopBootAnimation();
+  },
+  []() {
+    // 시각이 있으면 오프라인 시계로 돌며 WifiLink가 뒤에서 다시 붙는다. 아무것도 없으면 예전처럼 다시 시작해 포털부터.
+    if (!timeSourceReady())
+      ESP.restart();
+    WEBLOG_WARN("[Boot] WiFi failed, running offline");
+  },
+  []() {
+    networkStartServices();
+    setupTime();
+    setupOTA();
+    syncBegin();
+    // IP 표시 (큐에만 넣고, loop의 프레임마다 흐른다)
+    display.displayIP((uint32_t)WiFi.localIP());
+  },
+};
+
 void setup()
 {
   Serial.begin(115200);
-  webLog("hello");
-  delay(1000);
+  webLogBegin();
+  bootBegin();
+  WEBLOG_INFO("hello");
 
-  // 1. 설정 로드
+  // 1. 설정 로드 (한 번만)
+  bootPhaseBegin(BOOT_PHASE_CONFIG);
   loadConfig();
+  bootPhaseEnd(BOOT_PHASE_CONFIG);
 
-  // 2. 하드웨어 초기화
+  // 2. 하드웨어 초기화 (부트 애니메이션이 여기서 시작된다)
+  bootPhaseBegin(BOOT_PHASE_HARDWARE);
+  setupTimeZone();
   display.begin();
   buttons.begin();
+  timerEngine.begin();
   interactiveManager.begin();
+  schedulerBegin();
+  bootPhaseEnd(BOOT_PHASE_HARDWARE);
 
-  // 3. 네트워크 연결 (WiFi -> mDNS -> WebServer)
-  setupNetwork();
-
-  // 3.5 OTA 시작 (WiFi 연결 이후!)
-  setupOTA();
-
-  // 4. 시간 동기화
-  setupTime();
+  // 3. 서로 기다릴 필요 없는 느린 단계는 동시에: 파일시스템(+기록 로그)과 WiFi (포털이면 최대 180초)
+  bootPhaseBegin(BOOT_PHASE_TIME);
+  bootPhaseBegin(BOOT_PHASE_FIRST_FRAME);
+  bootRunAsync(BOOT_PHASE_STORAGE, []() {
+    const bool ok = networkMountStorage();
+    historyBegin();
+    return ok;
+  }, 4096);
+  bootRunAsync(BOOT_PHASE_WIFI, wifiLinkConnect, 8192);
 
-  // 5. 애니메이션 종료 (네트워크/시간 준비 완료 후)
-  delay(1000);
-  display.stopBootAnimation();
-
-  // 6. IP 표시
-  if (WiFi.status() == WL_CONNECTED) {
-    display.displayIP((uint32_t)WiFi.localIP());
-  }
+  // 4. 소프트 리셋이면 RTC에 시각이 남아 있다: 네트워크를 기다리지 않고 바로 그린다
+  bootStep(kBootSteps);
 }
 
 void loop()
 {
+  if (bootStepsPending())
+    bootStep(kBootSteps);
+
   // OTA 패킷 처리(가장 중요)
-  ArduinoOTA.handle();
+  if (otaReady)
+    ArduinoOTA.handle();
+  wifiLinkLoop(); // 끊기면 뒤에서 다시 붙는다 (막지 않는다)
   networkLoop();
+  syncLoop();
+  schedulerLoop();
 
   // 버튼 상태 업데이트
   buttons.update();
+
+  // 원격 제어 명령 적용 (가상 버튼 입력은 아래 물리 버튼 처리와 같은 경로를 탄다)
+  remoteControlBeginFrame(buttons);
   
-  // 인터랙티브 로직 업데이트
-  interactiveManager.update();
+  // 인터랙티브 로직 업데이트 (프리셋 시간 반영 후 만료된 타이머 이벤트 처리)
+  // 여기부터 show()까지는 정상 상태에서 힙 할당이 없어야 한다 (/alloc의 render, 디버그 빌드는 abort)
+  {
+    AllocScope frameScope(ALLOC_RENDER, ALLOC_POLICY_FORBID);
+    interactiveManager.update();
+    timerEngine.update();
+  }
 
-  static unsigned long lastPresetChangeTime = 0;
-  static unsigned long lastInteractionTime = 0;
-  static int interactionMode = MODE_NONE;
   bool presetChanged = false;
+  bool frameRendered = false;
 
   // 인터랙티브 모드 확인 (Inner 우선, Outer 차선)
   int activeInteractiveMode = MODE_NONE;
@@ -111,20 +171,18 @@ void loop()
   // 카운터 모드에서 버튼 1+2 동시 입력 시 카운터 초기화
   if (activeInteractiveMode == MODE_COUNTER && btn1Pressed && btn2Pressed) {
       interactiveManager.resetCounter();
-      lastInteractionTime = millis();
-      interactionMode = MODE_COUNTER;
+      display.displayTemporaryValue(interactiveManager.getDisplayNumber(MODE_COUNTER));
   } else {
       // 버튼 1 처리 (특수 모드 Reset/Decrease)
       if (btn1Pressed) {
           if (activeInteractiveMode != MODE_NONE) {
               interactiveManager.handleButton1(activeInteractiveMode);
-              // 카운터일 경우 잠시 값 표시 트리거
+              // 카운터일 경우 잠시 값 표시
               if (activeInteractiveMode == MODE_COUNTER) {
-                  lastInteractionTime = millis();
-                  interactionMode = MODE_COUNTER;
+                  display.displayTemporaryValue(interactiveManager.getDisplayNumber(MODE_COUNTER));
               }
           } else {
-              webLog("Btn 1 pressed (No Action)");
+              WEBLOG_INFO("Btn 1 pressed (No Action)");
           }
       }
 
@@ -132,13 +190,12 @@ void loop()
       if (btn2Pressed) {
           if (activeInteractiveMode != MODE_NONE) {
               interactiveManager.handleButton2(activeInteractiveMode);
-              // 카운터일 경우 잠시 값 표시 트리거
+              // 카운터일 경우 잠시 값 표시
               if (activeInteractiveMode == MODE_COUNTER) {
-                  lastInteractionTime = millis();
-                  interactionMode = MODE_COUNTER;
+                  display.displayTemporaryValue(interactiveManager.getDisplayNumber(MODE_COUNTER));
               }
           } else {
-              webLog("Btn 2 pressed (No Action)");
+              WEBLOG_INFO("Btn 2 pressed (No Action)");
           }
       }
   }
@@ -146,12 +203,12 @@ void loop()
   // 버튼 3: 이전 프리셋
   if (buttons.wasPressed(BTN_3)) {
     if (appConfig.presets.size() > 0) {
-      appConfig.currentPresetIndex--;
-      if (appConfig.currentPresetIndex < 0) {
-        appConfig.currentPresetIndex = appConfig.presets.size() - 1;
+      int index = appConfig.currentPresetIndex - 1;
+      if (index < 0) {
+        index = appConfig.presets.size() - 1;
       }
-      webLogf("[Button] Preset Changed: %d", appConfig.currentPresetIndex);
-      saveConfigToFile(); // 변경사항 저장
+      switchPreset(index); // 저장은 잠시 뒤 한 번에 (루프를 막지 않게)
+      WEBLOG_INFO("[Button] Preset Changed: %d", appConfig.currentPresetIndex);
       presetChanged = true;
     }
   }
@@ -159,43 +216,50 @@ void loop()
   // 버튼 4: 다음 프리셋
   if (buttons.wasPressed(BTN_4)) {
     if (appConfig.presets.size() > 0) {
-      appConfig.currentPresetIndex++;
-      if (appConfig.currentPresetIndex >= appConfig.presets.size()) {
-        appConfig.currentPresetIndex = 0;
+      int index = appConfig.currentPresetIndex + 1;
+      if (index >= (int)appConfig.presets.size()) {
+        index = 0;
       }
-      webLogf("[Button] Preset Changed: %d", appConfig.currentPresetIndex);
-      saveConfigToFile(); // 변경사항 저장
+      switchPreset(index); // 저장은 잠시 뒤 한 번에 (루프를 막지 않게)
+      WEBLOG_INFO("[Button] Preset Changed: %d", appConfig.currentPresetIndex);
       presetChanged = true;
     }
   }
 
   if (presetChanged) {
-      lastPresetChangeTime = millis();
-      // 즉시 반영을 위해 강제로 업데이트 로직 실행 유도 가능하나,
-      // 아래 루프에서 자연스럽게 처리됨.
-      // 다만 버튼 반응성을 위해 여기서 즉시 그려주는 것도 좋음.
-      display.update(appConfig);
-      display.displayPreset(appConfig.currentPresetIndex);
+      // 프리셋 번호는 1.5초 오버레이로 (글자 엔진이 시간을 잰다)
+      display.displayPreset(appConfig);
   }
 
-  static unsigned long lastUpdate = 0;
+  static uint32_t lastFrameSlot = 0;
 
-  // 0.1초마다 디스플레이 갱신
-  if (millis() - lastUpdate > 100)
+  // 0.1초마다 디스플레이 갱신 (동기화 중이면 리더 클럭 격자에 맞춰 여러 대가 같은 순간에 그린다).
+  // 프리셋 전환 효과가 도는 동안은 20ms 격자로 촘촘하게 그리고, 끝나면 다시 0.1초로 돌아간다.
+  // 프리셋을 바꾼 루프는 버튼 반응성을 위해 슬롯을 기다리지 않는다 (그래도 루프당 한 프레임).
+  const uint32_t frameInterval = display.transitionActive() ? TRANSITION_FRAME_INTERVAL_MS : FRAME_INTERVAL_MS;
+  const uint32_t frameSlot = syncMillis() / frameInterval;
+  if (presetChanged || frameSlot != lastFrameSlot)
   {
-    lastUpdate = millis();
-    display.update(appConfig);
-    
-    // 프리셋 변경 후 1.5초 동안은 프리셋 번호 표시 (덮어쓰기)
-    if (millis() - lastPresetChangeTime < 1500) {
-        display.displayPreset(appConfig.currentPresetIndex);
-    }
-    // 카운터 값 변경 후 1.5초 동안 값 표시 (덮어쓰기)
-    else if (millis() - lastInteractionTime < 1500 && interactionMode == MODE_COUNTER) {
-        display.displayTemporaryValue(interactiveManager.getDisplayNumber(MODE_COUNTER));
-    }
+    lastFrameSlot = frameSlot;
+    display.update(appConfig); // 프리셋/카운터 오버레이도 여기서 함께 그려진다
+    display.endFrame();
+    frameRendered = true;
+    if (!display.isBooting() && !bootPhaseDone(BOOT_PHASE_FIRST_FRAME))
+      bootPhaseEnd(BOOT_PHASE_FIRST_FRAME, bootPhaseOk(BOOT_PHASE_TIME));
   }
 
+  // 이번 루프에서 처리한 원격 명령에 결과 상태로 응답
+  remoteControlEndFrame();
+
+  // 상태 변경분은 프레임당 한 번만 모아서 푸시
+  if (frameRendered) {
+    stateStreamEndFrame(display);
+  }
+
+  // 미뤄 둔 설정 저장 (프레임을 그린 뒤에 NVS 쓰기)
+  configSaveLoop();
+  allocLoop();
+
   // 타이트 루프에서 WiFi/OTA 작업이 굶지 않게(권장)
   delay(0);
 }
@@ -1,129 +1,166 @@
 #include "managers/DisplayManager.h"
 #include "managers/InteractiveManager.h"
 #include "TimeLogic.h"
+#include "FrameStream.h"
+#include "SyncManager.h"
+#include "hal/Hal.h"
+#include "AllocTracker.h"
+#include <string.h>
 #include <Arduino.h>
 
 DisplayManager::DisplayManager() 
-    : _leds(NUM_LEDS_INNER, PIN_INNER, NUM_LEDS_OUTER, PIN_OUTER, NEO_GRB + NEO_KHZ800),
+    : _topology(&kBuildTopology),
       _seg(SCLK_PIN, LOAD_PIN, SDI_PIN) {}
 void DisplayManager::begin()
 {
-    _leds.begin();
+    // 저장된 배치(/topology)가 있으면 그것으로, 없으면 빌드 배치로 (바꾸면 재부팅해야 적용)
+    _topology = &topologyForBoot();
+    _transition.setTopology(*_topology);
+    _leds.begin(*_topology);
     _leds.clear();
     _leds.show();
     _seg.begin();
-    // 시작 시 비동기로 애니메이션 구동
+    _compositor.show(LAYER_BASE, hal::nowMs());
+    _compositor.show(LAYER_OVERLAY, hal::nowMs());
+    // setup()이 네트워크를 기다리는 동안 부트 태스크가 화면을 맡는다
     startBootAnimation();
 }
 
-static void bootAnimationTask(void *pvParameters)
-{
-    DisplayManager *dm = (DisplayManager *)pvParameters;
-    LedDriver &leds = *(LedDriver *)((uint8_t *)dm + 0); // LedDriver 위치 (구조에 따라 주의)
-    // 안전한 접근을 위해 DisplayManager 내부에 static wrapper나 friend class 고려 가능하나
-    // 여기서는 로직 구현을 위해 멤버 함수를 태스크 내부 루프로 이동하는 방식으로 수정 제안
-}
-
-// 태스크 함수를 멤버 함수 호출 형태로 구현하기 위해 DisplayManager.cpp 수정
 void DisplayManager::startBootAnimation()
 {
-    _isBooting = true;
+    _bootStartMs = hal::nowMs();
+    renderBootLayer(_bootStartMs);
+    _compositor.show(LAYER_SYSTEM, _bootStartMs);
+    _bootPump = true;
+    _pumpRunning = true;
     auto taskFn = [](void *p)
     {
         DisplayManager *self = (DisplayManager *)p;
-        const byte segPatterns[] = {0b11111110, 0b11111101, 0b11111011, 0b11110111, 0b11101111, 0b11011111};
-        int i = 0;
-        self->_seg.drawRaw(0b11011100, 0b11100011, 0b11011100);
-        while (self->_isBooting)
+        while (self->_bootPump)
         {
-            self->_leds.clear();
+            const uint32_t now = hal::nowMs();
+            self->renderBootLayer(now);
+            self->commitFrame(now);
+            hal::sleepMs(kBootFrameMs);
+        }
+        self->_pumpRunning = false;
+    };
 
-            // 무지개 색상 계산 (i값에 따라 변함)
-            uint32_t rainbowColor = self->_leds.ColorHSV((i * 1024) % 65536, 255, 255);
-            uint32_t rainbowColor2 = self->_leds.ColorHSV(((i + 10) * 1024) % 65536, 255, 255);
+    if (!hal::startTask(taskFn, "bootTask", 4096, this))
+    {
+        _bootPump = false;
+        _pumpRunning = false;
+        commitFrame(_bootStartMs); // 태스크 없이 첫 프레임만
+    }
+}
 
-            // Outer Ring (정방향)
-            int outerIdx = NUM_LEDS_INNER + (i % NUM_LEDS_OUTER);
-            self->_leds.setPixelColor(outerIdx, rainbowColor);
-            self->_leds.setPixelColor((i + 1) % NUM_LEDS_OUTER + NUM_LEDS_INNER, rainbowColor);
+void DisplayManager::stopBootAnimation(uint32_t fadeMs)
+{
+    // 커밋 주인 넘기기: 태스크가 그리던 프레임을 마치고 나갈 때까지만 기다린다 (최대 한 프레임)
+    _bootPump = false;
+    while (_pumpRunning)
+        hal::sleepMs(10);
+    // 이제 loop의 update()가 유일한 주인이다. 부트 레이어는 그 프레임들 위에서 흐려지며 사라진다.
+    _compositor.expire(LAYER_SYSTEM, hal::nowMs(), fadeMs);
+}
 
-            // Inner Ring (역방향)
-            int innerIdx = (NUM_LEDS_INNER - 1 - (i % NUM_LEDS_INNER));
-            self->_leds.setPixelColor(innerIdx, rainbowColor2);
+void DisplayManager::renderBootLayer(uint32_t nowMs)
+{
+    // 공통 애노드 원래 패턴 0b11011100, 0b11100011, 0b11011100을 활성 high로
+    static const uint8_t kBootSegments[3] = {0x23, 0x1C, 0x23};
+    Layer &boot = _compositor.layer(LAYER_SYSTEM);
+    const uint32_t i = (nowMs - _bootStartMs) / kBootFrameMs;
+    const uint16_t inner = _topology->count(RING_INNER);
+    const uint16_t outer = _topology->count(RING_OUTER);
 
-            // 7-Segment (무지개 색상과 동기화된 회전)
-            // byte pSeg = segPatterns[i % 6];
-            // self->_seg.drawRaw(pSeg, pSeg, pSeg);
+    // 링 전체를 덮는다 (바탕은 페이드 동안에만 비친다)
+    for (uint16_t n = 0; n < _topology->pixels(); n++)
+        boot.setPixelColor(n, 0);
 
-            self->_leds.show();
-            i++;
-            vTaskDelay(pdMS_TO_TICKS(40));
-        }
-        vTaskDelete(NULL);
-    };
+    // 무지개 색상 계산 (i값에 따라 변함)
+    uint32_t rainbowColor = Layer::ColorHSV((i * 1024) % 65536, 255, 255);
+    uint32_t rainbowColor2 = Layer::ColorHSV(((i + 10) * 1024) % 65536, 255, 255);
 
-    BaseType_t taskResult = pdFAIL;
-#if defined(CONFIG_FREERTOS_NUMBER_OF_CORES) && (CONFIG_FREERTOS_NUMBER_OF_CORES > 1)
-    taskResult = xTaskCreatePinnedToCore(taskFn, "bootTask", 4096, this, 1, &_bootTaskHandle, 1);
-#else
-    taskResult = xTaskCreate(taskFn, "bootTask", 4096, this, 1, &_bootTaskHandle);
-#endif
+    // Outer Ring (정방향)
+    boot.setPixelColor(inner + (i % outer), rainbowColor);
+    boot.setPixelColor((i + 1) % outer + inner, rainbowColor);
 
-    if (taskResult != pdPASS)
-    {
-        _isBooting = false;
-        _bootTaskHandle = NULL;
-    }
+    // Inner Ring (역방향)
+    boot.setPixelColor(inner - 1 - (i % inner), rainbowColor2);
+
+    boot.setSegments(kBootSegments);
 }
 
-void DisplayManager::stopBootAnimation()
+void DisplayManager::commitFrame(uint32_t nowMs)
 {
-    _isBooting = false;
-    // 태스크가 종료될 때까지 잠시 대기
-    delay(100);
-    _leds.clear();
+    uint32_t pixels[Layer::kPixels];
+    uint8_t segments[3];
+    _compositor.compose(nowMs, pixels, segments, _topology->pixels());
+    _leds.writeFrame(pixels);
     _leds.show();
+    _seg.drawSegments(segments);
 }
 
 void DisplayManager::displayIP(uint32_t ipAddress)
 {
-    // IPAddress를 4개의 옥텟으로 분리 (Little Endian 기준)
-    uint8_t octets[4];
-    octets[0] = ipAddress & 0xFF;
-    octets[1] = (ipAddress >> 8) & 0xFF;
-    octets[2] = (ipAddress >> 16) & 0xFF;
-    octets[3] = (ipAddress >> 24) & 0xFF;
-
-    // "IP " 표시 (I: 0b11111001, P: 0b10001100)
-    _seg.drawRaw(0b11111001, 0b10001100, 0xFF);
-    delay(1000);
-
-    for (int i = 0; i < 4; i++)
+    // IPAddress는 Little Endian: 첫 옥텟이 최하위 바이트. 한 바퀴 흐르고 끝난다 (setup을 막지 않는다)
+    char text[24];
+    snprintf(text, sizeof(text), "IP %u.%u.%u.%u", (unsigned)(ipAddress & 0xFF), (unsigned)((ipAddress >> 8) & 0xFF),
+             (unsigned)((ipAddress >> 16) & 0xFF), (unsigned)((ipAddress >> 24) & 0xFF));
+    _text.post(text, SEG_PRIORITY_SYSTEM, 0);
+}
+
+void DisplayManager::displayPreset(const AppConfig &config)
+{
+    // "P 1" 뒤에 D-Day 이름 (세그먼트가 D-Day 모드일 때, 그릴 수 있는 글자만)
+    char text[8];
+    snprintf(text, sizeof(text), "P%2d", config.currentPresetIndex + 1);
+    _text.post(text, SEG_PRIORITY_OVERLAY, kOverlayMs, SEG_TEXT_REPLACE);
+
+    if (config.currentPresetIndex < (int)config.presets.size())
     {
-        _seg.drawNumber(octets[i], 0, false);
-        delay(800);
-        // 마지막 옥텟이 아니면 깜빡임으로 구분
-        if (i < 3) {
-            _seg.drawNumber(0, 0, true);
-            delay(200);
-        }
+        const SegmentConfig &segment = config.presets[config.currentPresetIndex].segment;
+        if (segment.mode == 5 && segment.payload.kind == PAYLOAD_DDAY &&
+            segment.payload.value.ddayIndex < (int)config.ddays.size())
+            _text.post(config.ddays[segment.payload.value.ddayIndex].name.c_str(), SEG_PRIORITY_OVERLAY, kOverlayMs);
     }
-    delay(500);
 }
 
-void DisplayManager::displayPreset(int presetIndex)
+void DisplayManager::displayTemporaryValue(int value)
 {
-    // P (Common Anode: 0x8C)
-    // Space (0xFF)
-    // Number
-    int num = (presetIndex + 1) % 10;
-    byte pNum = _seg.digitPatterns[num];
-    _seg.drawRaw(0x8C, 0xFF, pNum);
+    char text[16];
+    formatNumber(text, sizeof(text), value, 0);
+    _text.post(text, SEG_PRIORITY_OVERLAY, kOverlayMs, SEG_TEXT_REPLACE);
 }
 
-void DisplayManager::displayTemporaryValue(int value)
+// 0~999는 예전처럼 세 자리를 0으로 채운다. 그보다 크거나 음수면 그대로 써서 마퀴로 흐른다.
+// dpPos: 오른쪽에서 몇 자리 앞에 소수점을 찍는지
+void DisplayManager::formatNumber(char *out, size_t size, int value, int dpPos)
+{
+    int len = snprintf(out, size, (value >= 0 && value <= 999) ? "%03d" : "%d", value);
+    if (len <= 0 || dpPos <= 0 || dpPos >= len || (size_t)len + 1 >= size)
+        return;
+    const int at = len - dpPos;
+    memmove(out + at + 1, out + at, (size_t)(len - at + 1));
+    out[at] = '.';
+}
+
+void DisplayManager::endFrame()
 {
-    _seg.drawNumber(min(value, 999), 0, false);
+    _stats.committed.fetch_add(1, std::memory_order_relaxed);
+
+    // 보는 클라이언트가 없으면 여기서 끝 (추가 비용 없음)
+    if (!frameStreamActive())
+        return;
+
+    uint32_t pixels[kMaxPixels];
+    const uint16_t count = _leds.numPixels();
+    for (uint16_t i = 0; i < count; i++)
+    {
+        pixels[i] = _leds.getPixelColor(i);
+    }
+    frameStreamPublish(pixels, (uint8_t)count, _leds.getBrightness(), _seg.raw());
+    _stats.streamed.fetch_add(1, std::memory_order_relaxed);
 }
 
 IEffect *DisplayManager::getEffect(int mode)
@@ -136,18 +173,59 @@ IEffect *DisplayManager::getEffect(int mode)
         return &_timeGradEffect;
     case 3:
         return &_spaceGradEffect;
+    case 4:
+        return &_breathingEffect;
+    case 5:
+        return &_cometEffect;
+    case 6:
+        return &_sparkleEffect;
+    case 7:
+        return &_rotatingRainbowEffect;
     default:
         return &_solidEffect;
     }
 }
 
-void DisplayManager::renderRing(int startIdx, int count, float progress, int colorMode, uint32_t c1, uint32_t c2, uint32_t cEmpty)
+void DisplayManager::renderRing(int startIdx, int count, float progress, int colorMode, uint32_t c1, uint32_t c2, uint32_t cEmpty, uint32_t timeMs)
 {
     IEffect *effect = getEffect(colorMode);
-    effect->render(_leds, startIdx, count, progress, c1, c2, cEmpty);
+    effect->render(_compositor.layer(LAYER_BASE), startIdx, count, progress, c1, c2, cEmpty, timeMs);
 }
 
 void DisplayManager::update(const AppConfig &config)
+{
+    if (_bootPump)
+        return; // 부트 태스크가 커밋 주인이다 (stopBootAnimation 전)
+
+    const uint32_t startUs = hal::nowUs();
+    AllocScope scope(ALLOC_RENDER, ALLOC_POLICY_FORBID);
+    render(config);
+
+    // 시각을 못 읽어 render가 일찍 끝나도 오버레이(IP 등)는 흐른다
+    const uint32_t nowMs = hal::nowMs();
+    uint8_t segments[3];
+    if (_text.tick(nowMs, segments))
+    {
+        _compositor.layer(LAYER_OVERLAY).setSegments(segments);
+    }
+    else
+    {
+        _compositor.layer(LAYER_OVERLAY).clearSegments();
+        _compositor.layer(LAYER_BASE).setSegments(segments);
+    }
+    _transition.step(_compositor, nowMs);
+    if (_compositor.visible(LAYER_SYSTEM))
+        renderBootLayer(nowMs); // 부트 레이어가 흐려지는 동안에도 애니메이션은 계속 돈다
+    commitFrame(nowMs);
+    const uint32_t elapsedUs = hal::nowUs() - startUs;
+
+    _stats.updates.fetch_add(1, std::memory_order_relaxed);
+    _stats.updateUsTotal.fetch_add(elapsedUs, std::memory_order_relaxed);
+    if (elapsedUs > _stats.updateUsMax.load(std::memory_order_relaxed))
+        _stats.updateUsMax.store(elapsedUs, std::memory_order_relaxed);
+}
+
+void DisplayManager::render(const AppConfig &config)
 {
     struct tm t;
     if (!getLocalTimeInfo(&t))
@@ -160,8 +238,17 @@ void DisplayManager::update(const AppConfig &config)
         idx = 0;
     const Preset &p = config.presets[idx];
 
+    // 나가는 프리셋의 마지막 프레임을 바탕 레이어에서 떼어 두고, 들어오는 프리셋은 그 아래에 그린다
+    if (idx != _lastPresetIndex)
+    {
+        if (_lastPresetIndex >= 0)
+            _transition.begin(_compositor, config.transitionStyle, config.transitionMs, hal::nowMs());
+        _lastPresetIndex = idx;
+    }
+
     // 1. 밝기 설정
     int finalBrightness = config.brightness;
+    _nightActive = false;
     if (config.nightModeEnabled)
     {
         int h = t.tm_hour;
@@ -169,10 +256,13 @@ void DisplayManager::update(const AppConfig &config)
                            ? (h >= config.nightStartHour || h < config.nightEndHour)
                            : (h >= config.nightStartHour && h < config.nightEndHour);
         if (isNight)
+        {
             finalBrightness = config.nightBrightness;
+            _nightActive = true;
+        }
     }
     _leds.setBrightness(finalBrightness);
-    _leds.clear();
+    _seg.setBrightness(finalBrightness);
 
     // Blink Logic for Pomodoro (Global check if any ring is Pomodoro)
     bool blink = false;
@@ -180,8 +270,13 @@ void DisplayManager::update(const AppConfig &config)
     else if (p.outer.mode == MODE_POMODORO && interactiveManager.shouldBlink(MODE_POMODORO)) blink = true;
 
     // 뽀모도로 대기 상태에서는 LED만 깜빡이고 7-Seg는 계속 표시한다.
-    bool skipLedRender = blink && ((millis() / 500) % 2 == 0);
-    if (!skipLedRender)
+    const uint32_t renderMs = syncMillis(); // 애니메이션 효과와 깜빡임도 여러 대가 같은 박자로
+    bool skipLedRender = blink && ((renderMs / 500) % 2 == 0);
+    if (skipLedRender)
+    {
+        _compositor.layer(LAYER_BASE).clear(); // 링은 꺼지고 7세그먼트 값은 아래에서 다시 채운다
+    }
+    else
     {
         // 2. Inner Ring
         {
@@ -189,19 +284,19 @@ void DisplayManager::update(const AppConfig &config)
             if (isInteractiveMode(p.inner.mode)) {
                 prog = interactiveManager.getProgress(p.inner);
             } else {
-                String sDate = "", tDate = "";
+                const char *sDate = nullptr, *tDate = nullptr;
                 if (p.inner.mode == 4 &&
                     p.inner.payload.kind == PAYLOAD_DDAY &&
                     p.inner.payload.value.ddayIndex < (int)config.ddays.size())
                 {
                     int ddayIndex = p.inner.payload.value.ddayIndex;
-                    sDate = config.ddays[ddayIndex].startDate;
-                    tDate = config.ddays[ddayIndex].targetDate;
+                    sDate = config.ddays[ddayIndex].startDate.c_str();
+                    tDate = config.ddays[ddayIndex].targetDate.c_str();
                 }
                 prog = calculateProgress(p.inner.mode, &t, sDate, tDate);
             }
-            renderRing(0, NUM_LEDS_INNER, prog,
-                    p.inner.colorMode, p.inner.colorFill, p.inner.colorFill2, p.inner.colorEmpty);
+            renderRing(_topology->offset(RING_INNER), _topology->count(RING_INNER), prog,
+                    p.inner.colorMode, p.inner.colorFill, p.inner.colorFill2, p.inner.colorEmpty, renderMs);
         }
 
         // 3. Outer Ring
@@ -210,22 +305,21 @@ void DisplayManager::update(const AppConfig &config)
             if (isInteractiveMode(p.outer.mode)) {
                 prog = interactiveManager.getProgress(p.outer);
             } else {
-                String sDate = "", tDate = "";
+                const char *sDate = nullptr, *tDate = nullptr;
                 if (p.outer.mode == 4 &&
                     p.outer.payload.kind == PAYLOAD_DDAY &&
                     p.outer.payload.value.ddayIndex < (int)config.ddays.size())
                 {
                     int ddayIndex = p.outer.payload.value.ddayIndex;
-                    sDate = config.ddays[ddayIndex].startDate;
-                    tDate = config.ddays[ddayIndex].targetDate;
+                    sDate = config.ddays[ddayIndex].startDate.c_str();
+                    tDate = config.ddays[ddayIndex].targetDate.c_str();
                 }
                 prog = calculateProgress(p.outer.mode, &t, sDate, tDate);
             }
-            renderRing(NUM_LEDS_INNER, NUM_LEDS_OUTER, prog,
-                    p.outer.colorMode, p.outer.colorFill, p.outer.colorFill2, p.outer.colorEmpty);
+            renderRing(_topology->offset(RING_OUTER), _topology->count(RING_OUTER), prog,
+                    p.outer.colorMode, p.outer.colorFill, p.outer.colorFill2, p.outer.colorEmpty, renderMs);
         }
     }
-    _leds.show();
 
     // 4. 7-Segment (기존 로직 유지하며 드라이버 호출)
     int displayNum = 0;
@@ -276,7 +370,7 @@ void DisplayManager::update(const AppConfig &config)
              p.segment.payload.value.ddayIndex < (int)config.ddays.size())
     {
         int ddayIndex = p.segment.payload.value.ddayIndex;
-        time_t target = parseDate(config.ddays[ddayIndex].targetDate);
+        time_t target = parseDate(config.ddays[ddayIndex].targetDate.c_str());
         displayNum = (int)(difftime(target, mktime(&t)) / 86400.0);
         if (displayNum < 0)
             displayNum = 0;
@@ -290,5 +384,7 @@ void DisplayManager::update(const AppConfig &config)
         dpPos = 1;
     }
 
-    _seg.drawNumber(min(displayNum, 999), dpPos, false);
+    char text[16];
+    formatNumber(text, sizeof(text), displayNum, dpPos);
+    _text.setBase(text);
 }
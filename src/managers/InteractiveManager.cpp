@@ -1,4 +1,5 @@
 #include "managers/InteractiveManager.h"
+#include "HistoryLog.h"
 
 InteractiveManager interactiveManager;
 
@@ -89,56 +90,68 @@ static bool getPomodoroDisplaySeconds(const Preset &p)
     return displaySeconds;
 }
 
+static_assert((int)InteractiveManager::POMO_REST == (int)POMODORO_REST &&
+                  (int)InteractiveManager::POMO_WAIT_WORK == (int)POMODORO_WAIT_WORK,
+              "PomoState mirrors PomodoroPhase");
+
 InteractiveManager::InteractiveManager() {}
 
 void InteractiveManager::begin()
 {
     // Init values
     _counterValue = 0;
+    _timer = timerEngine.create("timer", TIMER_COUNTDOWN);
+    _pomodoro = timerEngine.create("pomodoro", TIMER_POMODORO);
+    timerEngine.addListener(onTimerEvent, this);
+    applyPresetDurations();
 }
 
-unsigned long InteractiveManager::getElapsed(unsigned long start, unsigned long accumulated, bool running)
-{
-    if (running)
-    {
-        return (millis() - start) + accumulated;
-    }
-    return accumulated;
-}
-
-void InteractiveManager::update()
+void InteractiveManager::applyPresetDurations()
 {
     if (appConfig.presets.empty())
         return;
-    const Preset &p = appConfig.presets[appConfig.currentPresetIndex];
+    _appliedPreset = appConfig.currentPresetIndex;
+    const Preset &p = appConfig.presets[_appliedPreset];
 
-    // Pomodoro logic
     long workMin = 25;
     long restMin = 5;
     getPomodoroMinutes(p, workMin, restMin);
-    unsigned long workDur = workMin * 60UL * 1000UL;
-    unsigned long restDur = restMin * 60UL * 1000UL;
+    timerEngine.setDuration(_timer, (uint64_t)getTimerSeconds(p) * 1000ULL);
+    timerEngine.setPomodoro(_pomodoro, (uint64_t)workMin * 60000ULL, (uint64_t)restMin * 60000ULL);
+}
+
+void InteractiveManager::reloadPresets()
+{
+    _reloadRequested.store(true);
+}
+
+void InteractiveManager::update()
+{
+    // Expiry is pushed by the engine; only a preset switch or a config edit needs new durations here.
+    if (_reloadRequested.exchange(false) || appConfig.currentPresetIndex != _appliedPreset)
+        applyPresetDurations();
+}
 
-    if (_pomoState == POMO_WORK && _pomoRunning)
+void InteractiveManager::onTimerEvent(const TimerEvent &event, void *ctx)
+{
+    InteractiveManager *self = static_cast<InteractiveManager *>(ctx);
+    if (event.timer == self->_timer && event.type == TIMER_EVENT_EXPIRED)
     {
-        unsigned long elapsed = getElapsed(_pomoStartTime, _pomoAccumulated, true);
-        if (elapsed >= workDur)
-        {
-            _pomoRunning = false;
-            _pomoState = POMO_WAIT_REST;
-            _pomoAccumulated = 0; // Reset for next phase
-            webLog("[POMO] Work finished. Waiting for Rest.");
-        }
+        WEBLOG_INFO("[Timer] Finished");
+        historyRecord(HISTORY_TIMER, (uint32_t)(event.durationMs / 1000));
     }
-    else if (_pomoState == POMO_REST && _pomoRunning)
+    else if (event.timer == self->_pomodoro && event.type == TIMER_EVENT_PHASE_END)
     {
-        unsigned long elapsed = getElapsed(_pomoStartTime, _pomoAccumulated, true);
-        if (elapsed >= restDur)
+        const uint32_t minutes = (uint32_t)((event.durationMs + 30000) / 60000);
+        if (event.phase == POMODORO_WORK)
         {
-            _pomoRunning = false;
-            _pomoState = POMO_WAIT_WORK;
-            _pomoAccumulated = 0;
-            webLog("[POMO] Rest finished. Waiting for Work.");
+            WEBLOG_INFO("[POMO] Work finished. Waiting for Rest.");
+            historyRecord(HISTORY_POMO_WORK, minutes);
+        }
+        else
+        {
+            WEBLOG_INFO("[POMO] Rest finished. Waiting for Work.");
+            historyRecord(HISTORY_POMO_REST, minutes);
         }
     }
 }
@@ -151,23 +164,17 @@ void InteractiveManager::handleButton1(int mode)
         _counterValue--;
         if (_counterValue < 0)
             _counterValue = 0;
-        webLogf("[Counter] Value: %ld", _counterValue);
+        WEBLOG_INFO("[Counter] Value: %ld", _counterValue);
     }
     else if (mode == MODE_TIMER)
     {
-        // Reset
-        _timerRunning = false;
-        _accumulatedTime = 0;
-        _timerFinished = false;
-        webLog("[Timer] Reset");
+        resetTimer();
     }
     else if (mode == MODE_POMODORO)
     {
         // Reset Logic: Reset current session
-        _pomoRunning = false;
-        _pomoAccumulated = 0;
-        _pomoStartTime = millis();
-        webLog("[Pomodoro] Reset current session");
+        timerEngine.reset(_pomodoro);
+        WEBLOG_INFO("[Pomodoro] Reset current session");
     }
 }
 
@@ -177,58 +184,38 @@ void InteractiveManager::handleButton2(int mode)
     {
         // Increase
         _counterValue++;
-        webLogf("[Counter] Value: %ld", _counterValue);
+        WEBLOG_INFO("[Counter] Value: %ld", _counterValue);
     }
     else if (mode == MODE_TIMER)
     {
         // Start / Pause
-        if (_timerRunning)
-        {
-            // Pause
-            _timerRunning = false;
-            _accumulatedTime += (millis() - _timerStartTime);
-            webLog("[Timer] Paused");
-        }
+        if (timerEngine.running(_timer))
+            pauseTimer();
         else
-        {
-            // Resume/Start
-            _timerRunning = true;
-            _timerStartTime = millis();
-            webLog("[Timer] Started");
-        }
+            startTimer();
     }
     else if (mode == MODE_POMODORO)
     {
-        if (_pomoState == POMO_WAIT_REST)
+        const uint8_t phase = timerEngine.phase(_pomodoro);
+        if (phase == POMO_WAIT_REST || phase == POMO_WAIT_WORK)
         {
-            _pomoState = POMO_REST;
-            _pomoRunning = true;
-            _pomoStartTime = millis();
-            _pomoAccumulated = 0;
-            webLog("[Pomodoro] Starting Rest");
-        }
-        else if (_pomoState == POMO_WAIT_WORK)
-        {
-            _pomoState = POMO_WORK;
-            _pomoRunning = true;
-            _pomoStartTime = millis();
-            _pomoAccumulated = 0;
-            webLog("[Pomodoro] Starting Work");
+            applyPresetDurations();
+            timerEngine.advancePhase(_pomodoro);
+            WEBLOG_INFO("%s", phase == POMO_WAIT_REST ? "[Pomodoro] Starting Rest" : "[Pomodoro] Starting Work");
         }
         else
         {
             // Work or Rest
-            if (_pomoRunning)
+            if (timerEngine.running(_pomodoro))
             {
-                _pomoRunning = false;
-                _pomoAccumulated += (millis() - _pomoStartTime);
-                webLog("[Pomodoro] Paused");
+                timerEngine.pause(_pomodoro);
+                WEBLOG_INFO("[Pomodoro] Paused");
             }
             else
             {
-                _pomoRunning = true;
-                _pomoStartTime = millis();
-                webLog("[Pomodoro] Resumed");
+                applyPresetDurations();
+                timerEngine.start(_pomodoro);
+                WEBLOG_INFO("[Pomodoro] Resumed");
             }
         }
     }
@@ -236,8 +223,57 @@ void InteractiveManager::handleButton2(int mode)
 
 void InteractiveManager::resetCounter()
 {
+    if (_counterValue > 0)
+        historyRecord(HISTORY_COUNTER, (uint32_t)_counterValue);
     _counterValue = 0;
-    webLog("[Counter] Reset");
+    WEBLOG_INFO("[Counter] Reset");
+}
+
+void InteractiveManager::setCounter(long value)
+{
+    _counterValue = (value < 0) ? 0 : value;
+    WEBLOG_INFO("[Counter] Value: %ld", _counterValue);
+}
+
+void InteractiveManager::startTimer()
+{
+    if (timerEngine.running(_timer))
+        return;
+    applyPresetDurations();
+    timerEngine.start(_timer);
+    WEBLOG_INFO("[Timer] Started");
+}
+
+void InteractiveManager::pauseTimer()
+{
+    if (!timerEngine.running(_timer))
+        return;
+    timerEngine.pause(_timer);
+    WEBLOG_INFO("[Timer] Paused");
+}
+
+void InteractiveManager::resetTimer()
+{
+    timerEngine.reset(_timer);
+    WEBLOG_INFO("[Timer] Reset");
+}
+
+void InteractiveManager::getSnapshot(InteractiveSnapshot &out)
+{
+    out.counter = _counterValue;
+    out.timerRunning = timerEngine.running(_timer);
+    out.timerElapsedMs = (unsigned long)timerEngine.elapsedMs(_timer);
+    out.pomoState = timerEngine.phase(_pomodoro);
+    out.pomoRunning = timerEngine.running(_pomodoro);
+    out.pomoElapsedMs = (unsigned long)timerEngine.elapsedMs(_pomodoro);
+}
+
+void InteractiveManager::applySnapshot(const InteractiveSnapshot &in)
+{
+    // 비콘마다 불리므로 로그는 남기지 않는다. 경과 시간은 지금 시점 기준으로 다시 잡는다.
+    _counterValue = in.counter;
+    timerEngine.restore(_timer, in.timerRunning, in.timerElapsedMs, POMO_WORK);
+    timerEngine.restore(_pomodoro, in.pomoRunning, in.pomoElapsedMs, in.pomoState);
 }
 
 float InteractiveManager::getProgress(const RingConfig &ring)
@@ -251,29 +287,22 @@ float InteractiveManager::getProgress(const RingConfig &ring)
     }
     else if (ring.mode == MODE_TIMER)
     {
-        long targetBox = getTimerSecondsFromPayload(&ring.payload) * 1000L;
-        unsigned long elapsed = getElapsed(_timerStartTime, _accumulatedTime, _timerRunning);
-        if (elapsed >= (unsigned long)targetBox)
+        uint64_t duration = timerEngine.durationMs(_timer);
+        uint64_t elapsed = timerEngine.elapsedMs(_timer);
+        if (duration == 0 || elapsed >= duration)
             return 1.0f;
-        return (float)elapsed / (float)targetBox;
+        return (float)elapsed / (float)duration;
     }
     else if (ring.mode == MODE_POMODORO)
     {
-        long workMin = 25;
-        long restMin = 5;
-        bool ignoredDisplaySeconds = false;
-        getPomodoroConfigFromPayload(&ring.payload, workMin, restMin, ignoredDisplaySeconds);
-        unsigned long workDur = workMin * 60UL * 1000UL;
-        unsigned long restDur = restMin * 60UL * 1000UL;
-
-        unsigned long duration = (_pomoState == POMO_WORK) ? workDur : restDur;
-        if (_pomoState == POMO_WAIT_REST || _pomoState == POMO_WAIT_WORK)
+        uint8_t phase = timerEngine.phase(_pomodoro);
+        if (phase == POMO_WAIT_REST || phase == POMO_WAIT_WORK)
             return 1.0f;
 
-        unsigned long elapsed = getElapsed(_pomoStartTime, _pomoAccumulated, _pomoRunning);
+        uint64_t duration = timerEngine.durationMs(_pomodoro);
         if (duration == 0)
             return 0.0f;
-        return (float)elapsed / (float)duration;
+        return (float)timerEngine.elapsedMs(_pomodoro) / (float)duration;
     }
     return 0.0f;
 }
@@ -290,12 +319,10 @@ int InteractiveManager::getDisplayNumber(int mode)
     }
     else if (mode == MODE_TIMER)
     {
-        long target = getTimerSeconds(p);
         bool displaySeconds = getTimerDisplaySecondsFromPayload(findPayloadForMode(p, MODE_TIMER));
-        unsigned long elapsed = getElapsed(_timerStartTime, _accumulatedTime, _timerRunning);
-        long remainingSeconds = target - (elapsed / 1000);
-        if (remainingSeconds < 0)
-            remainingSeconds = 0;
+        uint64_t duration = timerEngine.durationMs(_timer);
+        uint64_t elapsed = timerEngine.elapsedMs(_timer);
+        long remainingSeconds = (elapsed < duration) ? (long)(duration / 1000 - elapsed / 1000) : 0;
         if (displaySeconds)
         {
             return (int)remainingSeconds;
@@ -304,21 +331,14 @@ int InteractiveManager::getDisplayNumber(int mode)
     }
     else if (mode == MODE_POMODORO)
     {
-        long workMin = 25;
-        long restMin = 5;
-        getPomodoroMinutes(p, workMin, restMin);
         bool displaySeconds = getPomodoroDisplaySeconds(p);
-        unsigned long workDur = workMin * 60UL * 1000UL;
-        unsigned long restDur = restMin * 60UL * 1000UL;
-
-        unsigned long duration = (_pomoState == POMO_WORK) ? workDur : restDur;
-        if (_pomoState == POMO_WAIT_REST || _pomoState == POMO_WAIT_WORK)
+        uint8_t phase = timerEngine.phase(_pomodoro);
+        if (phase == POMO_WAIT_REST || phase == POMO_WAIT_WORK)
             return 0;
 
-        unsigned long elapsed = getElapsed(_pomoStartTime, _pomoAccumulated, _pomoRunning);
-        long remainingMS = duration - elapsed;
-        if (remainingMS < 0)
-            remainingMS = 0;
+        uint64_t duration = timerEngine.durationMs(_pomodoro);
+        uint64_t elapsed = timerEngine.elapsedMs(_pomodoro);
+        uint64_t remainingMS = (elapsed < duration) ? duration - elapsed : 0;
         if (displaySeconds)
         {
             return (int)((remainingMS + 999) / 1000); // Seconds ceil
@@ -332,7 +352,8 @@ bool InteractiveManager::shouldBlink(int mode)
 {
     if (mode == MODE_POMODORO)
     {
-        return (_pomoState == POMO_WAIT_REST || _pomoState == POMO_WAIT_WORK);
+        uint8_t phase = timerEngine.phase(_pomodoro);
+        return (phase == POMO_WAIT_REST || phase == POMO_WAIT_WORK);
     }
     return false;
 }
@@ -0,0 +1,146 @@
+#include "managers/SegmentText.h"
+#include "graphics/SegmentFont.h"
+#include <string.h>
+
+namespace
+{
+constexpr uint32_t kBlinkHalfPeriodMs = 250;
+constexpr uint8_t kVisibleCells = 3;
+}
+
+void SegmentText::layout(const char *text, Cells &out)
+{
+    out.count = 0;
+    for (const char *p = text; p && *p; p++)
+    {
+        const char c = *p;
+        if ((uint8_t)c >= 0x80)
+            continue; // UTF-8 (한글 이름 등): 7세그먼트로 그릴 수 없다
+        if (SegmentFont::attachesToPrevious(c) && out.count > 0 && !(out.glyphs[out.count - 1] & SegmentFont::DP))
+        {
+            out.glyphs[out.count - 1] |= SegmentFont::DP;
+            continue;
+        }
+        if (out.count < kMaxCells)
+            out.glyphs[out.count++] = SegmentFont::glyph(c);
+    }
+}
+
+uint32_t SegmentText::passMs(const Cells &cells)
+{
+    if (cells.count <= kVisibleCells)
+        return 0;
+    return 2 * kMarqueeHoldMs + (uint32_t)(cells.count - kVisibleCells) * kMarqueeStepMs;
+}
+
+void SegmentText::window(const Cells &cells, uint32_t elapsedMs, bool loop, uint8_t out[3])
+{
+    out[0] = out[1] = out[2] = 0;
+    if (cells.count <= kVisibleCells)
+    {
+        // 짧은 글은 오른쪽 정렬 (숫자 자리 맞춤)
+        const uint8_t pad = kVisibleCells - cells.count;
+        for (uint8_t i = 0; i < cells.count; i++)
+            out[pad + i] = cells.glyphs[i];
+        return;
+    }
+
+    const uint32_t pass = passMs(cells);
+    uint32_t t = loop ? elapsedMs % pass : min(elapsedMs, pass);
+    uint32_t offset = 0;
+    if (t >= kMarqueeHoldMs)
+        offset = min<uint32_t>((t - kMarqueeHoldMs) / kMarqueeStepMs, cells.count - kVisibleCells);
+    for (uint8_t i = 0; i < kVisibleCells; i++)
+        out[i] = cells.glyphs[offset + i];
+}
+
+void SegmentText::setBase(const char *text)
+{
+    if (strncmp(text, _baseText, kMaxCells) == 0)
+        return;
+    strncpy(_baseText, text, kMaxCells);
+    _baseText[kMaxCells] = '\0';
+
+    const uint8_t previousCount = _base.count;
+    layout(_baseText, _base);
+    if (_base.count != previousCount)
+        _baseElapsedMs = 0;
+}
+
+bool SegmentText::post(const char *text, uint8_t priority, uint32_t durationMs, uint8_t flags)
+{
+    if (flags & SEG_TEXT_REPLACE)
+        cancel(priority);
+    if (_jobCount >= kMaxJobs)
+        return false;
+
+    Job &job = _jobs[_jobCount];
+    layout(text, job.cells);
+    if (job.cells.count == 0)
+        return false;
+    job.priority = priority;
+    job.flags = flags;
+    job.durationMs = durationMs;
+    job.elapsedMs = 0;
+    job.seq = _nextSeq++;
+    _jobCount++;
+    return true;
+}
+
+void SegmentText::cancel(uint8_t priority)
+{
+    for (int i = (int)_jobCount - 1; i >= 0; i--)
+    {
+        if (_jobs[i].priority == priority)
+            removeJob(i);
+    }
+}
+
+int SegmentText::activeJob() const
+{
+    int best = -1;
+    for (int i = 0; i < (int)_jobCount; i++)
+    {
+        if (best < 0 || _jobs[i].priority > _jobs[best].priority ||
+            (_jobs[i].priority == _jobs[best].priority && _jobs[i].seq < _jobs[best].seq))
+            best = i;
+    }
+    return best;
+}
+
+void SegmentText::removeJob(int index)
+{
+    for (int i = index; i + 1 < (int)_jobCount; i++)
+        _jobs[i] = _jobs[i + 1];
+    _jobCount--;
+}
+
+bool SegmentText::tick(uint32_t nowMs, uint8_t out[3])
+{
+    uint32_t dt = _ticked ? nowMs - _lastTickMs : 0;
+    _lastTickMs = nowMs;
+    _ticked = true;
+    _baseElapsedMs += dt;
+
+    for (int index = activeJob(); index >= 0; index = activeJob())
+    {
+        // 지난 시간은 지금 보이던 작업만 먹는다. 이어서 올라온 작업은 0부터 시작한다.
+        Job &job = _jobs[index];
+        job.elapsedMs += dt;
+        dt = 0;
+
+        if (job.elapsedMs >= max(job.durationMs, passMs(job.cells)))
+        {
+            removeJob(index);
+            continue;
+        }
+
+        window(job.cells, job.elapsedMs, false, out);
+        if ((job.flags & SEG_TEXT_BLINK) && (job.elapsedMs / kBlinkHalfPeriodMs) % 2 == 1)
+            out[0] = out[1] = out[2] = 0;
+        return true;
+    }
+
+    window(_base, _baseElapsedMs, true, out);
+    return false;
+}
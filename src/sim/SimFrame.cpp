@@ -0,0 +1,137 @@
+#ifndef ARDUINO
+#include "sim/SimFrame.h"
+#include <cmath>
+#include <cstring>
+#include <string>
+
+namespace
+{
+constexpr int kGridCols = 41;
+constexpr int kGridRows = 21;
+constexpr uint32_t kNoColor = 0xFFFFFFFF;
+constexpr uint32_t kSegmentOn = 0xFF3030;
+constexpr uint32_t kLedOff = 0x303030;
+
+struct Cell
+{
+    const char *glyph = " ";
+    uint32_t color = kNoColor;
+};
+
+void fnv(uint32_t &h, uint8_t b)
+{
+    h ^= b;
+    h *= 16777619u;
+}
+
+bool segmentOn(uint8_t bits, int segment)
+{
+    return (bits & (1 << segment)) == 0;
+}
+
+// 인덱스 0이 12시 방향, 시계 방향 (웹 미리보기와 같다)
+void placeRing(Cell grid[kGridRows][kGridCols], const uint32_t *pixels, int count, float radiusCols, float radiusRows)
+{
+    for (int i = 0; i < count; i++)
+    {
+        const float angle = (float)i / count * 2.0f * (float)M_PI - (float)M_PI / 2.0f;
+        const int col = (int)lroundf(kGridCols / 2 + cosf(angle) * radiusCols);
+        const int row = (int)lroundf(kGridRows / 2 + sinf(angle) * radiusRows);
+        Cell &cell = grid[row][col];
+        cell.glyph = pixels[i] ? "●" : "·";
+        cell.color = pixels[i] ? pixels[i] : kLedOff;
+    }
+}
+
+void placeSegments(Cell grid[kGridRows][kGridCols], const uint8_t seg[3])
+{
+    //  _
+    // |_|
+    // |_|.
+    const int top = kGridRows / 2 - 1;
+    const int left = kGridCols / 2 - 6;
+    for (int d = 0; d < 3; d++)
+    {
+        const uint8_t bits = seg[d];
+        const int x = left + d * 4;
+        const struct
+        {
+            int row, col, segment;
+            const char *glyph;
+        } parts[] = {
+            {0, 1, 0, "_"}, {1, 2, 1, "|"}, {2, 2, 2, "|"}, {2, 1, 3, "_"},
+            {2, 0, 4, "|"}, {1, 0, 5, "|"}, {1, 1, 6, "_"}, {2, 3, 7, "."}};
+        for (const auto &part : parts)
+        {
+            if (!segmentOn(bits, part.segment))
+                continue;
+            Cell &cell = grid[top + part.row][x + part.col];
+            cell.glyph = part.glyph;
+            cell.color = kSegmentOn;
+        }
+    }
+}
+}
+
+void simCaptureFrame(const uint32_t *pixels, uint8_t count, uint8_t brightness, const uint8_t seg[3], void *ctx)
+{
+    SimFrame &frame = *static_cast<SimFrame *>(ctx);
+    frame.count = count < kMaxPixels ? count : kMaxPixels;
+    memcpy(frame.pixels, pixels, frame.count * sizeof(uint32_t));
+    frame.brightness = brightness;
+    memcpy(frame.seg, seg, sizeof(frame.seg));
+}
+
+uint32_t simFrameHash(const SimFrame &frame, uint32_t seed)
+{
+    uint32_t h = seed;
+    fnv(h, frame.count);
+    for (uint8_t i = 0; i < frame.count; i++)
+    {
+        for (int shift = 0; shift < 32; shift += 8)
+            fnv(h, (uint8_t)(frame.pixels[i] >> shift));
+    }
+    fnv(h, frame.brightness);
+    for (int d = 0; d < 3; d++)
+        fnv(h, frame.seg[d]);
+    return h;
+}
+
+void simDrawAnsi(const SimFrame &frame, FILE *out)
+{
+    static Cell grid[kGridRows][kGridCols];
+    for (auto &row : grid)
+        for (auto &cell : row)
+            cell = Cell();
+
+    const int inner = frame.count < kBuildTopology.count(RING_INNER) ? frame.count : kBuildTopology.count(RING_INNER);
+    placeRing(grid, frame.pixels, inner, 12.0f, 6.0f);
+    placeRing(grid, frame.pixels + inner, frame.count - inner, 19.0f, 9.5f);
+    placeSegments(grid, frame.seg);
+
+    std::string text;
+    text.reserve(kGridRows * kGridCols * 24);
+    char esc[32];
+    for (int r = 0; r < kGridRows; r++)
+    {
+        uint32_t current = kNoColor;
+        for (int c = 0; c < kGridCols; c++)
+        {
+            const Cell &cell = grid[r][c];
+            if (cell.color != current)
+            {
+                if (cell.color == kNoColor)
+                    snprintf(esc, sizeof(esc), "\x1b[0m");
+                else
+                    snprintf(esc, sizeof(esc), "\x1b[38;2;%u;%u;%um", (unsigned)(cell.color >> 16) & 0xFF,
+                             (unsigned)(cell.color >> 8) & 0xFF, (unsigned)cell.color & 0xFF);
+                text += esc;
+                current = cell.color;
+            }
+            text += cell.glyph;
+        }
+        text += "\x1b[0m\n";
+    }
+    fputs(text.c_str(), out);
+}
+#endif
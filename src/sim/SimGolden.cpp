@@ -0,0 +1,176 @@
+#ifndef ARDUINO
+#include "sim/SimGolden.h"
+#include "TimerEngine.h"
+#include "WebLogger.h"
+#include "hal/HalNative.h"
+#include "managers/InteractiveManager.h"
+#include <map>
+#include <string>
+
+namespace
+{
+const int kRingModes[] = {0, 1, 2, 3, 4, 5, MODE_COUNTER, MODE_TIMER, MODE_POMODORO};
+const int kColorModes[] = {0, 1, 2, 3, 4, 5, 6, 7};
+const int kSegmentModes[] = {0, 1, 2, 3, 4, 5, 6, MODE_COUNTER, MODE_TIMER, MODE_POMODORO};
+
+// 월말/분기 경계/하루 끝처럼 반올림이 갈리는 시각을 일부러 섞는다 (KST)
+const time_t kInstants[] = {
+    1773448013, // 2026-03-14 09:26:53
+    1782831600, // 2026-07-01 00:00:00
+    1796050770, // 2026-11-30 23:59:30
+};
+
+void setRingPayload(RingConfig &ring)
+{
+    switch (ring.mode)
+    {
+    case 4:
+        payloadSetDDay(ring.payload, 0);
+        break;
+    case MODE_COUNTER:
+        payloadSetCounter(ring.payload, 100);
+        break;
+    case MODE_TIMER:
+        payloadSetTimer(ring.payload, 300, false);
+        break;
+    case MODE_POMODORO:
+        payloadSetPomodoro(ring.payload, 25, 5, false);
+        break;
+    default:
+        payloadSetNone(ring.payload);
+        break;
+    }
+}
+
+Preset makePreset(int ringMode, int colorMode, int segmentMode)
+{
+    Preset p;
+    p.inner.mode = ringMode;
+    p.inner.colorMode = colorMode;
+    p.inner.colorFill = 0xFF2000;
+    p.inner.colorFill2 = 0x20FF40;
+    p.inner.colorEmpty = 0x000008;
+    setRingPayload(p.inner);
+
+    p.outer = p.inner;
+    p.outer.colorFill = 0x0040FF;
+    p.outer.colorFill2 = 0xFFC000;
+    p.outer.colorEmpty = 0;
+
+    p.segment.mode = segmentMode;
+    if (segmentMode == 5)
+        payloadSetDDay(p.segment.payload, 0);
+    else
+        payloadSetNone(p.segment.payload);
+    return p;
+}
+
+std::string caseKey(int ringMode, int colorMode, int segmentMode)
+{
+    char key[32];
+    snprintf(key, sizeof(key), "ring%d/color%d/seg%d", ringMode, colorMode, segmentMode);
+    return key;
+}
+
+bool readGolden(const char *path, std::map<std::string, uint32_t> &out)
+{
+    FILE *f = fopen(path, "r");
+    if (!f)
+        return false;
+    char line[128];
+    while (fgets(line, sizeof(line), f))
+    {
+        char key[64];
+        unsigned int hash = 0;
+        if (line[0] == '#' || sscanf(line, "%63s %x", key, &hash) != 2)
+            continue;
+        out[key] = hash;
+    }
+    fclose(f);
+    return true;
+}
+}
+
+int simGoldenRun(DisplayManager &display, const SimFrame &captured, const char *path, bool update)
+{
+    std::map<std::string, uint32_t> golden;
+    if (!update && !readGolden(path, golden))
+    {
+        WEBLOG_INFO("[golden] cannot read %s", path);
+        return -1;
+    }
+
+    FILE *out = nullptr;
+    if (update)
+    {
+        out = fopen(path, "w");
+        if (!out)
+        {
+            WEBLOG_INFO("[golden] cannot write %s", path);
+            return -1;
+        }
+        fprintf(out, "# time-tape golden frames: <ring mode>/<color mode>/<segment mode> <fnv1a of frames at %u instants>\n",
+                (unsigned)(sizeof(kInstants) / sizeof(kInstants[0])));
+        fprintf(out, "# regenerate: .pio/build/native/program --update-golden sim/golden_frames.txt\n");
+    }
+
+    // 애니메이션 효과(색상 모드 4~7)는 렌더 클럭을 본다: 부트 종료를 기다린 시간과 상관없이 0ms에서 찍는다
+    hal::native::useManualClock(0);
+
+    AppConfig config;
+    config.ddays.push_back({"새해", "2026-01-01", "2027-01-01"});
+    config.brightness = 50;
+    config.transitionStyle = TRANSITION_CUT; // 조합마다 프리셋이 바뀐다: 정지 화면만 비교한다
+
+    int cases = 0;
+    int mismatches = 0;
+    for (int ringMode : kRingModes)
+    {
+        for (int colorMode : kColorModes)
+        {
+            for (int segmentMode : kSegmentModes)
+            {
+                // 같은 프리셋을 두 칸에 두고 조합마다 다른 칸을 고른다:
+                // 인터랙티브 매니저는 프리셋 인덱스가 바뀔 때만 타이머 길이를 다시 읽는다
+                const Preset p = makePreset(ringMode, colorMode, segmentMode);
+                config.presets.assign(2, p);
+                config.currentPresetIndex = (appConfig.currentPresetIndex == 0) ? 1 : 0;
+                appConfig = config;
+
+                uint32_t hash = 2166136261u;
+                for (time_t instant : kInstants)
+                {
+                    hal::native::setWallTime(instant);
+                    interactiveManager.update();
+                    timerEngine.update();
+                    display.update(appConfig);
+                    display.endFrame();
+                    hash = simFrameHash(captured, hash);
+                }
+
+                const std::string key = caseKey(ringMode, colorMode, segmentMode);
+                cases++;
+                if (update)
+                {
+                    fprintf(out, "%s %08x\n", key.c_str(), (unsigned)hash);
+                    continue;
+                }
+                auto it = golden.find(key);
+                if (it == golden.end() || it->second != hash)
+                {
+                    mismatches++;
+                    char want[16] = "(missing)";
+                    if (it != golden.end())
+                        snprintf(want, sizeof(want), "%08x", (unsigned)it->second);
+                    WEBLOG_INFO("[golden] MISMATCH %s: got %08x, want %s", key.c_str(), (unsigned)hash, want);
+                }
+            }
+        }
+    }
+
+    if (out)
+        fclose(out);
+    WEBLOG_INFO("[golden] %s: %d cases, %d mismatches", update ? "updated" : "checked", cases, mismatches);
+    return mismatches;
+}
+#endif
@@ -0,0 +1,190 @@
+#ifndef ARDUINO
+#include "sim/SimFrame.h"
+#include <cmath>
+
+namespace
+{
+constexpr uint32_t kBackground = 0x111111;
+constexpr uint32_t kLedOff = 0x222222;
+constexpr uint32_t kSegmentOn = 0xFF3030;
+constexpr uint32_t kSegmentOff = 0x2A0000;
+constexpr int kLedRadius = 6;
+
+void fillRect(std::vector<uint8_t> &rgb, int x, int y, int w, int h, uint32_t color)
+{
+    for (int py = y; py < y + h; py++)
+    {
+        for (int px = x; px < x + w; px++)
+        {
+            if (px < 0 || py < 0 || px >= kSimImageSize || py >= kSimImageSize)
+                continue;
+            uint8_t *p = &rgb[(py * kSimImageSize + px) * 3];
+            p[0] = (uint8_t)(color >> 16);
+            p[1] = (uint8_t)(color >> 8);
+            p[2] = (uint8_t)color;
+        }
+    }
+}
+
+void fillCircle(std::vector<uint8_t> &rgb, float cx, float cy, int radius, uint32_t color)
+{
+    const int x0 = (int)floorf(cx - radius);
+    const int y0 = (int)floorf(cy - radius);
+    for (int py = y0; py <= y0 + radius * 2 + 1; py++)
+    {
+        for (int px = x0; px <= x0 + radius * 2 + 1; px++)
+        {
+            const float dx = px + 0.5f - cx;
+            const float dy = py + 0.5f - cy;
+            if (dx * dx + dy * dy <= (float)(radius * radius))
+                fillRect(rgb, px, py, 1, 1, color);
+        }
+    }
+}
+
+void drawRing(std::vector<uint8_t> &rgb, float radius, const uint32_t *pixels, int count)
+{
+    const float c = kSimImageSize / 2.0f;
+    for (int i = 0; i < count; i++)
+    {
+        const float angle = (float)i / count * 2.0f * (float)M_PI - (float)M_PI / 2.0f;
+        fillCircle(rgb, c + cosf(angle) * radius, c + sinf(angle) * radius, kLedRadius, pixels[i] ? pixels[i] : kLedOff);
+    }
+}
+
+void drawSegments(std::vector<uint8_t> &rgb, const uint8_t seg[3])
+{
+    static const int bars[7][4] = {
+        {2, 0, 14, 3}, {16, 2, 3, 12}, {16, 16, 3, 12}, {2, 28, 14, 3},
+        {-1, 16, 3, 12}, {-1, 2, 3, 12}, {2, 14, 14, 3}};
+    const int x = kSimImageSize / 2 - 33;
+    const int y = kSimImageSize / 2 - 14;
+    for (int d = 0; d < 3; d++)
+    {
+        const int ox = x + d * 24;
+        for (int s = 0; s < 7; s++)
+        {
+            fillRect(rgb, ox + bars[s][0], y + bars[s][1], bars[s][2], bars[s][3],
+                     (seg[d] & (1 << s)) ? kSegmentOff : kSegmentOn);
+        }
+        fillRect(rgb, ox + 20, y + 28, 3, 3, (seg[d] & 0x80) ? kSegmentOff : kSegmentOn);
+    }
+}
+
+uint32_t crc32(const uint8_t *data, size_t len, uint32_t crc = 0)
+{
+    static uint32_t table[256];
+    if (table[1] == 0)
+    {
+        for (uint32_t n = 0; n < 256; n++)
+        {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[n] = c;
+        }
+    }
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++)
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+void putBe32(std::vector<uint8_t> &out, uint32_t v)
+{
+    out.push_back((uint8_t)(v >> 24));
+    out.push_back((uint8_t)(v >> 16));
+    out.push_back((uint8_t)(v >> 8));
+    out.push_back((uint8_t)v);
+}
+
+void putChunk(std::vector<uint8_t> &out, const char *type, const std::vector<uint8_t> &data)
+{
+    putBe32(out, (uint32_t)data.size());
+    const size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    putBe32(out, crc32(&out[start], out.size() - start));
+}
+
+bool writeFile(const char *path, const std::vector<uint8_t> &bytes)
+{
+    FILE *f = fopen(path, "wb");
+    if (!f)
+        return false;
+    const bool ok = fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+    return fclose(f) == 0 && ok;
+}
+}
+
+void simRasterize(const SimFrame &frame, std::vector<uint8_t> &rgb)
+{
+    rgb.assign(kSimImageSize * kSimImageSize * 3, 0);
+    fillRect(rgb, 0, 0, kSimImageSize, kSimImageSize, kBackground);
+    const int inner = frame.count < kBuildTopology.count(RING_INNER) ? frame.count : kBuildTopology.count(RING_INNER);
+    drawRing(rgb, 60.0f, frame.pixels, inner);
+    drawRing(rgb, 100.0f, frame.pixels + inner, frame.count - inner);
+    drawSegments(rgb, frame.seg);
+}
+
+bool simWritePpm(const SimFrame &frame, const char *path)
+{
+    std::vector<uint8_t> rgb;
+    simRasterize(frame, rgb);
+    char header[32];
+    const int len = snprintf(header, sizeof(header), "P6\n%d %d\n255\n", kSimImageSize, kSimImageSize);
+    std::vector<uint8_t> bytes(header, header + len);
+    bytes.insert(bytes.end(), rgb.begin(), rgb.end());
+    return writeFile(path, bytes);
+}
+
+// 압축 없는 deflate(stored 블록)로 쓰는 PNG. zlib 없이도 어디서나 열린다.
+bool simWritePng(const SimFrame &frame, const char *path)
+{
+    std::vector<uint8_t> rgb;
+    simRasterize(frame, rgb);
+
+    const size_t stride = kSimImageSize * 3;
+    std::vector<uint8_t> raw;
+    raw.reserve((stride + 1) * kSimImageSize);
+    for (int y = 0; y < kSimImageSize; y++)
+    {
+        raw.push_back(0); // 필터 없음
+        raw.insert(raw.end(), rgb.begin() + y * stride, rgb.begin() + (y + 1) * stride);
+    }
+
+    std::vector<uint8_t> z = {0x78, 0x01};
+    uint32_t a = 1, b = 0;
+    for (uint8_t byte : raw)
+    {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    for (size_t pos = 0; pos < raw.size() || pos == 0;)
+    {
+        const size_t len = raw.size() - pos > 65535 ? 65535 : raw.size() - pos;
+        const bool last = pos + len == raw.size();
+        z.push_back(last ? 1 : 0);
+        z.push_back((uint8_t)len);
+        z.push_back((uint8_t)(len >> 8));
+        z.push_back((uint8_t)~len);
+        z.push_back((uint8_t)(~len >> 8));
+        z.insert(z.end(), raw.begin() + pos, raw.begin() + pos + len);
+        pos += len;
+        if (last)
+            break;
+    }
+    putBe32(z, (b << 16) | a);
+
+    std::vector<uint8_t> ihdr;
+    putBe32(ihdr, kSimImageSize);
+    putBe32(ihdr, kSimImageSize);
+    ihdr.insert(ihdr.end(), {8, 2, 0, 0, 0}); // 8비트 RGB
+
+    std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    putChunk(png, "IHDR", ihdr);
+    putChunk(png, "IDAT", z);
+    putChunk(png, "IEND", {});
+    return writeFile(path, png);
+}
+#endif
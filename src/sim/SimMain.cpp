@@ -0,0 +1,281 @@
+#if !defined(ARDUINO) && !defined(PIO_UNIT_TESTING) && !defined(TIME_TAPE_BENCH)
+// env:native 실행 파일: 헤드리스 시뮬레이터.
+// 수동 시계와 주입한 설정으로 DisplayManager를 돌려 터미널(ANSI)/이미지(PPM, PNG)로 그리고,
+// 골든 프레임 파일과 비교한다. 단위 테스트 빌드(pio test -e native)에서는 테스트 러너가 main을 가진다.
+//
+//   program --ansi                                   지금 설정을 한 프레임 그리기
+//   program --start 2026-03-14T09:00 --duration 365d --step 1m --every 1440 --png out/
+//   program --config my.json --ansi --frames 50 --sleep 100
+//   program --golden sim/golden_frames.txt           (--update-golden으로 다시 쓰기)
+//   program --strict-alloc ...                       할당 금지 범위에서 할당하면 abort
+#include "AllocTracker.h"
+#include "Config.h"
+#include "ConfigCodec.h"
+#include "TimerEngine.h"
+#include "WebLogger.h"
+#include "hal/HalNative.h"
+#include "managers/DisplayManager.h"
+#include "managers/InteractiveManager.h"
+#include "sim/SimFrame.h"
+#include "sim/SimGolden.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+namespace
+{
+constexpr time_t kDefaultStart = 1767193200; // 2026-01-01 00:00 KST
+
+struct SimOptions
+{
+    const char *configPath = nullptr;
+    time_t start = kDefaultStart;
+    uint64_t stepMs = FRAME_INTERVAL_MS;
+    uint64_t frames = 1;
+    uint64_t durationMs = 0; // 주면 frames = durationMs / stepMs
+    uint64_t every = 1;
+    bool ansi = false;
+    const char *ppmDir = nullptr;
+    const char *pngDir = nullptr;
+    uint32_t sleepMs = 0;
+    const char *goldenPath = nullptr;
+    bool updateGolden = false;
+    bool strictAlloc = false;
+};
+
+void usage()
+{
+    fputs("usage: program [--config FILE] [--start YYYY-MM-DD[THH:MM[:SS]]] [--step DUR] [--frames N | --duration DUR]\n"
+          "               [--every N] [--ansi] [--sleep MS] [--ppm DIR] [--png DIR]\n"
+          "               [--golden FILE | --update-golden FILE] [--strict-alloc]\n"
+          "  DUR: 숫자 + ms/s/m/h/d (예: 100ms, 1m, 365d)\n",
+          stderr);
+}
+
+bool parseDuration(const char *text, uint64_t &outMs)
+{
+    char *end = nullptr;
+    const double value = strtod(text, &end);
+    if (end == text || value < 0)
+        return false;
+    double scale = 1;
+    if (strcmp(end, "") == 0 || strcmp(end, "ms") == 0)
+        scale = 1;
+    else if (strcmp(end, "s") == 0)
+        scale = 1000;
+    else if (strcmp(end, "m") == 0)
+        scale = 60000;
+    else if (strcmp(end, "h") == 0)
+        scale = 3600000;
+    else if (strcmp(end, "d") == 0)
+        scale = 86400000;
+    else
+        return false;
+    outMs = (uint64_t)(value * scale);
+    return true;
+}
+
+// 로컬 시각(KST)으로 해석한다
+bool parseStart(const char *text, time_t &out)
+{
+    struct tm t = {};
+    int y, mo, d, h = 0, mi = 0, s = 0;
+    const int n = sscanf(text, "%d-%d-%dT%d:%d:%d", &y, &mo, &d, &h, &mi, &s);
+    if (n < 3)
+        return false;
+    t.tm_year = y - 1900;
+    t.tm_mon = mo - 1;
+    t.tm_mday = d;
+    t.tm_hour = h;
+    t.tm_min = mi;
+    t.tm_sec = s;
+    t.tm_isdst = -1;
+    out = mktime(&t);
+    return out != (time_t)-1;
+}
+
+bool parseArgs(int argc, char **argv, SimOptions &opt)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        auto takes = [&](const char *name)
+        {
+            if (strcmp(arg, name) != 0)
+                return false;
+            if (!value)
+            {
+                fprintf(stderr, "%s: missing value\n", name);
+                exit(2);
+            }
+            i++;
+            return true;
+        };
+
+        if (strcmp(arg, "--ansi") == 0)
+            opt.ansi = true;
+        else if (strcmp(arg, "--strict-alloc") == 0)
+            opt.strictAlloc = true;
+        else if (takes("--config"))
+            opt.configPath = value;
+        else if (takes("--start"))
+        {
+            if (!parseStart(value, opt.start))
+                return false;
+        }
+        else if (takes("--step"))
+        {
+            if (!parseDuration(value, opt.stepMs) || opt.stepMs == 0)
+                return false;
+        }
+        else if (takes("--frames"))
+            opt.frames = strtoull(value, nullptr, 10);
+        else if (takes("--duration"))
+        {
+            if (!parseDuration(value, opt.durationMs))
+                return false;
+        }
+        else if (takes("--every"))
+        {
+            opt.every = strtoull(value, nullptr, 10);
+            if (opt.every == 0)
+                opt.every = 1;
+        }
+        else if (takes("--sleep"))
+            opt.sleepMs = (uint32_t)strtoul(value, nullptr, 10);
+        else if (takes("--ppm"))
+            opt.ppmDir = value;
+        else if (takes("--png"))
+            opt.pngDir = value;
+        else if (takes("--golden"))
+            opt.goldenPath = value;
+        else if (takes("--update-golden"))
+        {
+            opt.goldenPath = value;
+            opt.updateGolden = true;
+        }
+        else
+            return false;
+    }
+    if (opt.durationMs > 0)
+        opt.frames = opt.durationMs / opt.stepMs;
+    return true;
+}
+
+bool loadConfigFile(const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return false;
+    std::string text;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+        text.append(buf, n);
+    fclose(f);
+
+    JsonDocument doc;
+    if (deserializeJson(doc, text.c_str(), text.size()))
+        return false;
+    AppConfig parsed;
+    if (!configFromJson(doc, parsed))
+        return false;
+    appConfig = parsed;
+    return true;
+}
+
+void emitFrame(const SimOptions &opt, const SimFrame &frame, uint64_t index)
+{
+    if (opt.ansi)
+    {
+        const time_t now = hal::wallTime();
+        struct tm t;
+        localtime_r(&now, &t);
+        char stamp[32];
+        strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &t);
+        if (opt.frames > 1)
+            fputs("\x1b[H\x1b[2J", stdout);
+        simDrawAnsi(frame, stdout);
+        printf("%s  frame %llu  brightness %u\n", stamp, (unsigned long long)index, (unsigned)frame.brightness);
+        fflush(stdout);
+    }
+
+    char path[512];
+    if (opt.ppmDir)
+    {
+        snprintf(path, sizeof(path), "%s/frame_%06llu.ppm", opt.ppmDir, (unsigned long long)index);
+        if (!simWritePpm(frame, path))
+            WEBLOG_INFO("[sim] cannot write %s", path);
+    }
+    if (opt.pngDir)
+    {
+        snprintf(path, sizeof(path), "%s/frame_%06llu.png", opt.pngDir, (unsigned long long)index);
+        if (!simWritePng(frame, path))
+            WEBLOG_INFO("[sim] cannot write %s", path);
+    }
+    if (opt.sleepMs)
+        std::this_thread::sleep_for(std::chrono::milliseconds(opt.sleepMs));
+}
+}
+
+int main(int argc, char **argv)
+{
+    hal::wallClockBegin(3600 * 9);
+
+    SimOptions opt;
+    if (!parseArgs(argc, argv, opt))
+    {
+        usage();
+        return 2;
+    }
+
+    if (opt.strictAlloc)
+        allocSetStrict(true);
+    hal::native::useManualClock(0);
+    hal::native::setWallTime(opt.start);
+
+    loadConfig();
+    if (opt.configPath && !loadConfigFile(opt.configPath))
+    {
+        WEBLOG_INFO("[sim] cannot load config %s", opt.configPath);
+        return 1;
+    }
+
+    SimFrame frame;
+    hal::native::setFrameSink(simCaptureFrame, &frame);
+
+    DisplayManager display;
+    display.begin();
+    timerEngine.begin();
+    interactiveManager.begin();
+    display.stopBootAnimation(0); // 골든/프레임 출력은 부트 페이드 없이 바로 시작한다
+
+    if (opt.goldenPath)
+        return simGoldenRun(display, frame, opt.goldenPath, opt.updateGolden) == 0 ? 0 : 1;
+
+    for (uint64_t i = 0; i < opt.frames; i++)
+    {
+        {
+            AllocScope frameScope(ALLOC_RENDER, ALLOC_POLICY_FORBID);
+            interactiveManager.update();
+            timerEngine.update();
+        }
+        display.update(appConfig);
+        display.endFrame();
+        configSaveLoop();
+        if (i % opt.every == 0 || i + 1 == opt.frames)
+            emitFrame(opt, frame, i);
+        hal::native::advanceMs(opt.stepMs);
+    }
+
+    if (!opt.ansi)
+    {
+        WEBLOG_INFO("[sim] frames=%llu simulated_ms=%llu", (unsigned long long)opt.frames,
+                    (unsigned long long)(opt.frames * opt.stepMs));
+    }
+    return 0;
+}
+#endif
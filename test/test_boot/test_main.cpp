@@ -0,0 +1,210 @@
+// env:native 부팅 순서 검사 (pio test -e native -f test_boot).
+// main.cpp의 loop처럼 bootStep()을 부르며 WiFi/NTP가 붙는 시점만 바꿔 본다. 부트 애니메이션은 진짜 DisplayManager다.
+// 부팅 단계는 프로세스에 한 번뿐이라 시나리오마다 fork해서 새 프로세스로 돈다.
+#include <unity.h>
+#include "BootSequence.h"
+#include "Config.h"
+#include "TimeLogic.h"
+#include "hal/HalNative.h"
+#include "managers/DisplayManager.h"
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+constexpr uint32_t kNever = 0;
+constexpr uint32_t kStepMs = 10;
+constexpr uint32_t kRunMs = 20000;
+constexpr time_t kNtpEpoch = 1773448013; // 2026-03-14 09:26:53 KST
+constexpr time_t kNoClock = 1000;        // RTC에 남은 시각이 없는 콜드 부트
+
+struct Scenario
+{
+    time_t rtcEpoch;      // 부팅할 때 벽시계
+    uint32_t storageAtMs; // LittleFS 마운트가 끝나는 시각
+    uint32_t wifiAtMs;    // 부팅 연결이 끝나는 시각
+    bool wifiOk;
+    uint32_t ntpAtMs;  // NTP 응답 시각 (kNever면 끝내 안 온다)
+};
+
+struct Outcome
+{
+    bool animationStopped;
+    bool stepsDone;
+    bool timeOk;
+    uint32_t settledAtMs;
+    uint32_t servicesAtMs;
+    int settledCalls;
+    int servicesCalls;
+    int wifiFailedCalls;
+};
+
+DisplayManager g_display;
+bool g_linkUp = false;
+Outcome g_out;
+
+const BootSteps kSteps = {
+    timeSourceReady,
+    []() { return g_linkUp; },
+    []()
+    {
+        g_out.settledCalls++;
+        g_out.settledAtMs = hal::nowMs();
+        g_display.stopBootAnimation(0);
+    },
+    []() { g_out.wifiFailedCalls++; },
+    []()
+    {
+        g_out.servicesCalls++;
+        g_out.servicesAtMs = hal::nowMs();
+    },
+};
+
+// 자식 프로세스 하나 = 부팅 한 번. setup()의 앞부분을 흉내 낸 뒤 loop를 kStepMs 간격으로 돈다.
+// stopBootAnimation()이 부트 태스크를 기다리는 동안에도 수동 시계가 흐르므로 시각은 hal::nowMs()로 본다.
+void runBoot(const Scenario &s, int fd)
+{
+    hal::native::useManualClock(0);
+    hal::native::setWallTime(s.rtcEpoch);
+    initDefaultConfig();
+    g_display.begin();
+
+    bootPhaseBegin(BOOT_PHASE_TIME);
+    bootPhaseBegin(BOOT_PHASE_STORAGE);
+    bootPhaseBegin(BOOT_PHASE_WIFI);
+    bootStep(kSteps);
+    bool storageDone = false;
+    bool wifiDone = false;
+    bool ntpDone = s.ntpAtMs == kNever;
+    while (hal::nowMs() < kRunMs)
+    {
+        hal::native::advanceMs(kStepMs);
+        const uint32_t now = hal::nowMs();
+        if (!storageDone && now >= s.storageAtMs)
+        {
+            storageDone = true;
+            bootPhaseEnd(BOOT_PHASE_STORAGE);
+        }
+        if (!wifiDone && now >= s.wifiAtMs)
+        {
+            wifiDone = true;
+            g_linkUp = s.wifiOk;
+            bootPhaseEnd(BOOT_PHASE_WIFI, s.wifiOk);
+        }
+        if (!ntpDone && now >= s.ntpAtMs)
+        {
+            ntpDone = true;
+            hal::native::setWallTime(kNtpEpoch);
+        }
+        if (bootStepsPending())
+            bootStep(kSteps);
+    }
+    g_out.animationStopped = !g_display.isBooting();
+    g_out.stepsDone = !bootStepsPending();
+    g_out.timeOk = bootPhaseOk(BOOT_PHASE_TIME);
+    write(fd, &g_out, sizeof(g_out));
+}
+
+bool boot(const Scenario &s, Outcome &out)
+{
+    int fds[2];
+    if (pipe(fds) != 0)
+        return false;
+    fflush(stdout);
+    const pid_t pid = fork();
+    if (pid == 0)
+    {
+        close(fds[0]);
+        runBoot(s, fds[1]);
+        _exit(0);
+    }
+    close(fds[1]);
+    const bool ok = read(fds[0], &out, sizeof(out)) == (ssize_t)sizeof(out);
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+// WiFi가 먼저 붙고 NTP는 서비스(NTP 시작)를 띄운 뒤에 온다
+void test_cold_boot_waits_for_late_ntp()
+{
+    Outcome out;
+    TEST_ASSERT_TRUE(boot({kNoClock, 300, 1500, true, 4000}, out));
+    TEST_ASSERT_EQUAL_INT(1, out.servicesCalls);
+    TEST_ASSERT_UINT32_WITHIN(kStepMs, 1500, out.servicesAtMs);
+    TEST_ASSERT_EQUAL_INT(1, out.settledCalls);
+    TEST_ASSERT_UINT32_WITHIN(kStepMs, 4000, out.settledAtMs);
+    TEST_ASSERT_TRUE(out.timeOk);
+    TEST_ASSERT_TRUE(out.animationStopped);
+    TEST_ASSERT_TRUE(out.stepsDone);
+}
+
+// NTP가 끝내 안 오면 WiFi 뒤 10초에서 포기하고 시각 없이 그린다
+void test_cold_boot_gives_up_without_ntp()
+{
+    Outcome out;
+    TEST_ASSERT_TRUE(boot({kNoClock, 300, 1500, true, kNever}, out));
+    TEST_ASSERT_EQUAL_INT(1, out.servicesCalls);
+    TEST_ASSERT_EQUAL_INT(1, out.settledCalls);
+    TEST_ASSERT_UINT32_WITHIN(2 * kStepMs, 1500 + 10000, out.settledAtMs);
+    TEST_ASSERT_FALSE(out.timeOk);
+    TEST_ASSERT_TRUE(out.animationStopped);
+    TEST_ASSERT_TRUE(out.stepsDone);
+}
+
+// 소프트 리셋: RTC 시각으로 바로 그리고, 서비스는 WiFi가 붙을 때 띄운다
+void test_soft_reset_draws_before_wifi()
+{
+    Outcome out;
+    TEST_ASSERT_TRUE(boot({kNtpEpoch, 300, 1500, true, kNever}, out));
+    TEST_ASSERT_EQUAL_UINT32(0, out.settledAtMs);
+    TEST_ASSERT_EQUAL_INT(1, out.settledCalls);
+    TEST_ASSERT_EQUAL_INT(1, out.servicesCalls);
+    TEST_ASSERT_UINT32_WITHIN(kStepMs, 1500, out.servicesAtMs);
+    TEST_ASSERT_TRUE(out.timeOk);
+    TEST_ASSERT_TRUE(out.animationStopped);
+}
+
+// 캐시된 BSSID로 마운트보다 먼저 붙으면 서비스는 마운트가 끝날 때까지 기다린다
+void test_services_wait_for_storage()
+{
+    Outcome out;
+    TEST_ASSERT_TRUE(boot({kNoClock, 2500, 800, true, 4000}, out));
+    TEST_ASSERT_EQUAL_INT(1, out.servicesCalls);
+    TEST_ASSERT_UINT32_WITHIN(kStepMs, 2500, out.servicesAtMs);
+    TEST_ASSERT_TRUE(out.animationStopped);
+    TEST_ASSERT_TRUE(out.stepsDone);
+}
+
+// 부팅 연결이 실패해도 시각이 생기면 애니메이션은 걷히고, 서비스는 다음 연결까지 미룬다
+void test_wifi_failure_keeps_waiting_for_services()
+{
+    Outcome out;
+    TEST_ASSERT_TRUE(boot({kNtpEpoch, 300, 1500, false, kNever}, out));
+    TEST_ASSERT_EQUAL_INT(1, out.wifiFailedCalls);
+    TEST_ASSERT_EQUAL_INT(0, out.servicesCalls);
+    TEST_ASSERT_TRUE(out.animationStopped);
+    TEST_ASSERT_FALSE(out.stepsDone);
+}
+} // namespace
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+int main(int argc, char **argv)
+{
+    setupTimeZone();
+    UNITY_BEGIN();
+    RUN_TEST(test_cold_boot_waits_for_late_ntp);
+    RUN_TEST(test_cold_boot_gives_up_without_ntp);
+    RUN_TEST(test_soft_reset_draws_before_wifi);
+    RUN_TEST(test_services_wait_for_storage);
+    RUN_TEST(test_wifi_failure_keeps_waiting_for_services);
+    return UNITY_END();
+}
@@ -0,0 +1,61 @@
+// env:native 골든 프레임 검사 (pio test -e native -f test_golden).
+// 시뮬레이터의 --golden과 같은 경로로 링 모드 × 색 모드 × 세그먼트 모드 전체를 그려 sim/golden_frames.txt와 비교한다.
+// 의도한 화면 변경이면 파일을 --update-golden으로 다시 만들고 함께 커밋한다.
+#include <unity.h>
+#include "Config.h"
+#include "TimerEngine.h"
+#include "hal/HalNative.h"
+#include "managers/InteractiveManager.h"
+#include "sim/SimGolden.h"
+#include <string>
+#include <unistd.h>
+
+namespace
+{
+// 테스트 러너의 작업 디렉터리가 프로젝트 루트가 아니어도 찾도록 이 파일 위치에서도 더듬는다
+std::string goldenPath()
+{
+    const char *relative = "sim/golden_frames.txt";
+    if (access(relative, R_OK) == 0)
+        return relative;
+    std::string path = __FILE__;
+    const size_t cut = path.rfind("test/test_golden/");
+    return cut == std::string::npos ? relative : path.substr(0, cut) + relative;
+}
+
+void test_frames_match_golden_file()
+{
+    SimFrame frame;
+    hal::native::setFrameSink(simCaptureFrame, &frame);
+    DisplayManager display;
+    display.begin();
+    display.stopBootAnimation(0);
+
+    const std::string path = goldenPath();
+    const int mismatches = simGoldenRun(display, frame, path.c_str(), false);
+    hal::native::setFrameSink(nullptr, nullptr);
+    TEST_ASSERT_NOT_EQUAL_MESSAGE(-1, mismatches, "cannot read sim/golden_frames.txt");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, mismatches, "rendered frames differ from sim/golden_frames.txt (see [golden] MISMATCH lines)");
+}
+} // namespace
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+int main(int argc, char **argv)
+{
+    hal::wallClockBegin(3600 * 9);
+    hal::native::useManualClock(0);
+    initDefaultConfig();
+    timerEngine.begin();
+    interactiveManager.begin();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_frames_match_golden_file);
+    return UNITY_END();
+}
@@ -0,0 +1,15 @@
+#pragma once
+// env:native 단위 테스트 (pio test -e native). 파일마다 RUN_TEST 묶음 하나를 내놓고 test_main.cpp가 차례로 돌린다.
+// 시계는 main()이 켠 수동 시계(KST)이고 테스트끼리 이어서 흐른다. 설정은 setUp()이 기본값으로 되돌린다.
+#include <unity.h>
+#include <ctime>
+
+void runTimeLogicTests();
+void runConfigCodecTests();
+void runTimerTests();
+void runSchedulerTests();
+void runInteractiveTests();
+void runDisplayTests();
+
+// 로컬(KST) 날짜/시각 → struct tm (요일/연중 날짜는 mktime이 채운다)
+struct tm testLocalTime(int year, int month, int day, int hour = 0, int minute = 0, int second = 0);
@@ -0,0 +1,253 @@
+#include "NativeTests.h"
+#include "ConfigCodec.h"
+#include "hal/Hal.h"
+#include <vector>
+
+namespace
+{
+AppConfig sampleConfig()
+{
+    AppConfig c;
+    c.currentPresetIndex = 1;
+    c.brightness = 77;
+    c.nightModeEnabled = true;
+    c.nightStartHour = 23;
+    c.nightEndHour = 6;
+    c.nightBrightness = 3;
+    c.syncRole = 2;
+    c.transitionStyle = 2;
+    c.transitionMs = 900;
+
+    Preset dday;
+    dday.inner.mode = 4;
+    dday.inner.colorMode = 3;
+    dday.inner.colorFill = 0xFF2000;
+    dday.inner.colorFill2 = 0x20FF40;
+    dday.inner.colorEmpty = 0x000008;
+    payloadSetDDay(dday.inner.payload, 1);
+    dday.outer.mode = 5;
+    dday.outer.colorMode = 7;
+    dday.outer.colorFill = 0x0040FF;
+    payloadSetNone(dday.outer.payload);
+    dday.segment.mode = 5;
+    payloadSetDDay(dday.segment.payload, 1);
+    c.presets.push_back(dday);
+
+    Preset pomodoro;
+    pomodoro.inner.mode = MODE_POMODORO;
+    payloadSetPomodoro(pomodoro.inner.payload, 50, 10, true);
+    pomodoro.outer.mode = 3;
+    payloadSetNone(pomodoro.outer.payload);
+    pomodoro.segment.mode = MODE_POMODORO;
+    payloadSetNone(pomodoro.segment.payload);
+    c.presets.push_back(pomodoro);
+
+    Preset timer;
+    timer.inner.mode = 0;
+    payloadSetNone(timer.inner.payload);
+    timer.outer.mode = MODE_TIMER;
+    payloadSetTimer(timer.outer.payload, 300, true);
+    timer.segment.mode = MODE_TIMER;
+    payloadSetNone(timer.segment.payload);
+    c.presets.push_back(timer);
+
+    c.ddays.push_back({"새해", "2026-01-01", "2027-01-01"});
+    c.ddays.push_back({"launch", "2026-03-01", "2026-09-30"});
+
+    ScheduleRule weekday;
+    weekday.days = SCHEDULE_WEEKDAYS;
+    weekday.hour = 9;
+    weekday.minute = 30;
+    weekday.preset = 1;
+    c.schedules.push_back(weekday);
+    return c;
+}
+
+void assertPayloadEqual(const ModePayload &want, const ModePayload &got)
+{
+    TEST_ASSERT_EQUAL_INT(want.kind, got.kind);
+    switch (want.kind)
+    {
+    case PAYLOAD_DDAY:
+        TEST_ASSERT_EQUAL_INT(want.value.ddayIndex, got.value.ddayIndex);
+        break;
+    case PAYLOAD_COUNTER:
+        TEST_ASSERT_EQUAL_INT(want.value.counterTarget, got.value.counterTarget);
+        break;
+    case PAYLOAD_TIMER:
+        TEST_ASSERT_EQUAL_INT(want.value.timer.totalSeconds, got.value.timer.totalSeconds);
+        TEST_ASSERT_EQUAL(want.value.timer.displaySeconds, got.value.timer.displaySeconds);
+        break;
+    case PAYLOAD_POMODORO:
+        TEST_ASSERT_EQUAL_INT(want.value.pomodoro.workMinutes, got.value.pomodoro.workMinutes);
+        TEST_ASSERT_EQUAL_INT(want.value.pomodoro.restMinutes, got.value.pomodoro.restMinutes);
+        TEST_ASSERT_EQUAL(want.value.pomodoro.displaySeconds, got.value.pomodoro.displaySeconds);
+        break;
+    default:
+        break;
+    }
+}
+
+void assertRingEqual(const RingConfig &want, const RingConfig &got)
+{
+    TEST_ASSERT_EQUAL_INT(want.mode, got.mode);
+    TEST_ASSERT_EQUAL_INT(want.colorMode, got.colorMode);
+    TEST_ASSERT_EQUAL_HEX32(want.colorFill, got.colorFill);
+    TEST_ASSERT_EQUAL_HEX32(want.colorFill2, got.colorFill2);
+    TEST_ASSERT_EQUAL_HEX32(want.colorEmpty, got.colorEmpty);
+    assertPayloadEqual(want.payload, got.payload);
+}
+
+void assertConfigEqual(const AppConfig &want, const AppConfig &got)
+{
+    TEST_ASSERT_EQUAL_INT(want.currentPresetIndex, got.currentPresetIndex);
+    TEST_ASSERT_EQUAL_INT(want.brightness, got.brightness);
+    TEST_ASSERT_EQUAL(want.nightModeEnabled, got.nightModeEnabled);
+    TEST_ASSERT_EQUAL_INT(want.nightStartHour, got.nightStartHour);
+    TEST_ASSERT_EQUAL_INT(want.nightEndHour, got.nightEndHour);
+    TEST_ASSERT_EQUAL_INT(want.nightBrightness, got.nightBrightness);
+    TEST_ASSERT_EQUAL_INT(want.syncRole, got.syncRole);
+    TEST_ASSERT_EQUAL_INT(want.transitionStyle, got.transitionStyle);
+    TEST_ASSERT_EQUAL_INT(want.transitionMs, got.transitionMs);
+
+    TEST_ASSERT_EQUAL_UINT32(want.presets.size(), got.presets.size());
+    for (size_t i = 0; i < want.presets.size(); i++)
+    {
+        assertRingEqual(want.presets[i].inner, got.presets[i].inner);
+        assertRingEqual(want.presets[i].outer, got.presets[i].outer);
+        TEST_ASSERT_EQUAL_INT(want.presets[i].segment.mode, got.presets[i].segment.mode);
+        assertPayloadEqual(want.presets[i].segment.payload, got.presets[i].segment.payload);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(want.ddays.size(), got.ddays.size());
+    for (size_t i = 0; i < want.ddays.size(); i++)
+    {
+        TEST_ASSERT_EQUAL_STRING(want.ddays[i].name.c_str(), got.ddays[i].name.c_str());
+        TEST_ASSERT_EQUAL_STRING(want.ddays[i].startDate.c_str(), got.ddays[i].startDate.c_str());
+        TEST_ASSERT_EQUAL_STRING(want.ddays[i].targetDate.c_str(), got.ddays[i].targetDate.c_str());
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(want.schedules.size(), got.schedules.size());
+    for (size_t i = 0; i < want.schedules.size(); i++)
+    {
+        TEST_ASSERT_EQUAL_UINT8(want.schedules[i].days, got.schedules[i].days);
+        TEST_ASSERT_EQUAL_UINT8(want.schedules[i].hour, got.schedules[i].hour);
+        TEST_ASSERT_EQUAL_UINT8(want.schedules[i].minute, got.schedules[i].minute);
+        TEST_ASSERT_EQUAL_INT(want.schedules[i].preset, got.schedules[i].preset);
+    }
+}
+
+// ConfigManager가 NVS에 저장하는 경로와 같다: JSON 문서 → MsgPack → JSON 문서
+void test_json_msgpack_round_trip()
+{
+    const AppConfig original = sampleConfig();
+    JsonDocument doc;
+    configToJson(doc, original);
+
+    std::vector<uint8_t> msgpack(measureMsgPack(doc));
+    TEST_ASSERT_EQUAL_UINT32(msgpack.size(), serializeMsgPack(doc, msgpack.data(), msgpack.size()));
+
+    JsonDocument decoded;
+    TEST_ASSERT_FALSE(deserializeMsgPack(decoded, msgpack.data(), msgpack.size()));
+    AppConfig parsed;
+    TEST_ASSERT_TRUE(configFromJson(decoded, parsed));
+    assertConfigEqual(original, parsed);
+}
+
+// /get-config, /set-config와 NVS 백업이 쓰는 JSON 문자열
+void test_json_text_round_trip()
+{
+    const AppConfig original = sampleConfig();
+    JsonDocument doc;
+    configToJson(doc, original);
+    String text;
+    serializeJson(doc, text);
+
+    JsonDocument decoded;
+    TEST_ASSERT_FALSE(deserializeJson(decoded, text));
+    AppConfig parsed;
+    TEST_ASSERT_TRUE(configFromJson(decoded, parsed));
+    assertConfigEqual(original, parsed);
+}
+
+// ConfigManager의 NVS 경로 (저장소는 setUp이 비운다)
+void test_nvs_save_load_round_trip()
+{
+    const AppConfig original = sampleConfig();
+    appConfig = original;
+    saveConfigToFile();
+    appConfig = AppConfig();
+    loadConfig();
+    assertConfigEqual(original, appConfig);
+}
+
+// MsgPack이 깨져 있으면 함께 저장한 JSON 백업에서 읽는다
+void test_nvs_load_falls_back_to_json()
+{
+    const AppConfig original = sampleConfig();
+    appConfig = original;
+    saveConfigToFile();
+    const uint8_t garbage[4] = {0xC1, 0xC1, 0xC1, 0xC1}; // MsgPack에서 쓰지 않는 타입 바이트
+    hal::storageWriteBytes("time-tape", "config_bin", garbage, sizeof(garbage));
+    appConfig = AppConfig();
+    loadConfig();
+    assertConfigEqual(original, appConfig);
+}
+
+void test_nvs_load_without_saved_config_uses_defaults()
+{
+    appConfig = sampleConfig();
+    loadConfig();
+    TEST_ASSERT_EQUAL_UINT32(1, appConfig.presets.size());
+    TEST_ASSERT_EQUAL_INT(0, appConfig.presets[0].inner.mode);
+    TEST_ASSERT_EQUAL_UINT32(0, appConfig.schedules.size());
+}
+
+void test_decode_enforces_preset_rules()
+{
+    AppConfig config = sampleConfig();
+    // 두 링이 모두 인터랙티브면 바깥 링이 꺼지고, 맞지 않는 세그먼트 모드는 자동(0)으로
+    config.presets[0].inner.mode = MODE_COUNTER;
+    payloadSetCounter(config.presets[0].inner.payload, 20);
+    config.presets[0].outer.mode = MODE_TIMER;
+    payloadSetTimer(config.presets[0].outer.payload, 60);
+    config.presets[0].segment.mode = MODE_TIMER;
+    config.currentPresetIndex = 9;
+    ScheduleRule bad;
+    bad.hour = 24;
+    config.schedules.push_back(bad);
+
+    JsonDocument doc;
+    configToJson(doc, config);
+    AppConfig parsed;
+    TEST_ASSERT_TRUE(configFromJson(doc, parsed));
+    TEST_ASSERT_EQUAL_INT(MODE_COUNTER, parsed.presets[0].inner.mode);
+    TEST_ASSERT_EQUAL_INT(20, parsed.presets[0].inner.payload.value.counterTarget);
+    TEST_ASSERT_EQUAL_INT(0, parsed.presets[0].outer.mode);
+    TEST_ASSERT_EQUAL_INT(PAYLOAD_NONE, parsed.presets[0].outer.payload.kind);
+    TEST_ASSERT_EQUAL_INT(0, parsed.presets[0].segment.mode);
+    TEST_ASSERT_EQUAL_INT(0, parsed.currentPresetIndex);
+    TEST_ASSERT_EQUAL_UINT32(1, parsed.schedules.size());
+}
+
+void test_decode_rejects_config_without_presets()
+{
+    AppConfig config = sampleConfig();
+    config.presets.clear();
+    JsonDocument doc;
+    configToJson(doc, config);
+    AppConfig parsed;
+    TEST_ASSERT_FALSE(configFromJson(doc, parsed));
+}
+} // namespace
+
+void runConfigCodecTests()
+{
+    RUN_TEST(test_json_msgpack_round_trip);
+    RUN_TEST(test_json_text_round_trip);
+    RUN_TEST(test_nvs_save_load_round_trip);
+    RUN_TEST(test_nvs_load_falls_back_to_json);
+    RUN_TEST(test_nvs_load_without_saved_config_uses_defaults);
+    RUN_TEST(test_decode_enforces_preset_rules);
+    RUN_TEST(test_decode_rejects_config_without_presets);
+}
@@ -0,0 +1,130 @@
+#include "NativeTests.h"
+#include "Config.h"
+#include "hal/HalNative.h"
+#include "managers/DisplayManager.h"
+#include "managers/InteractiveManager.h"
+#include "sim/SimFrame.h"
+
+namespace
+{
+constexpr time_t kNoonKst = 1773457200; // 2026-03-14 12:00:00 KST (토요일)
+constexpr uint32_t kFill = 0xFF0000;
+constexpr uint32_t kEmpty = 0x000010;
+
+DisplayManager g_display;
+SimFrame g_frame;
+bool g_started = false;
+
+void beginDisplay()
+{
+    if (g_started)
+        return;
+    hal::native::setFrameSink(simCaptureFrame, &g_frame);
+    g_display.begin();
+    g_display.stopBootAnimation(0);
+    g_started = true;
+}
+
+Preset ringPreset(int innerMode, int outerMode, int segmentMode)
+{
+    Preset p;
+    p.inner.mode = innerMode;
+    p.inner.colorMode = 0;
+    p.inner.colorFill = kFill;
+    p.inner.colorEmpty = kEmpty;
+    payloadSetNone(p.inner.payload);
+    p.outer = p.inner;
+    p.outer.mode = outerMode;
+    p.segment.mode = segmentMode;
+    payloadSetNone(p.segment.payload);
+    return p;
+}
+
+void drawFrame()
+{
+    g_display.update(appConfig);
+    g_display.endFrame();
+}
+
+int countPixels(uint16_t start, uint16_t count, uint32_t color)
+{
+    int n = 0;
+    for (uint16_t i = start; i < start + count; i++)
+    {
+        if (g_frame.pixels[i] == color)
+            n++;
+    }
+    return n;
+}
+
+// 픽셀 하나당 몫은 fill과 empty 사이로 섞인다: 완전히 찬 픽셀만 센다
+void test_day_ring_at_noon_fills_half()
+{
+    beginDisplay();
+    appConfig.presets.assign(1, ringPreset(3, 3, 4));
+    appConfig.brightness = 40;
+    appConfig.transitionStyle = TRANSITION_CUT;
+    hal::native::setWallTime(kNoonKst);
+    drawFrame();
+
+    const Topology &topo = g_display.topology();
+    const uint16_t inner = topo.count(RING_INNER);
+    const uint16_t outer = topo.count(RING_OUTER);
+    TEST_ASSERT_EQUAL_UINT8(topo.pixels(), g_frame.count);
+    TEST_ASSERT_EQUAL_UINT8(40, g_frame.brightness);
+    TEST_ASSERT_EQUAL_INT(inner / 2, countPixels(topo.offset(RING_INNER), inner, kFill));
+    TEST_ASSERT_EQUAL_INT(inner / 2, countPixels(topo.offset(RING_INNER), inner, kEmpty));
+    TEST_ASSERT_EQUAL_INT(outer / 2, countPixels(topo.offset(RING_OUTER), outer, kFill));
+
+    // 세그먼트 모드 4(오늘 남은 시간): "12.0" (공통 애노드라 켜진 획이 0)
+    const uint8_t expected[3] = {0xF9, 0x24, 0xC0};
+    TEST_ASSERT_EQUAL_MEMORY(expected, g_frame.seg, 3);
+}
+
+void test_frame_follows_manual_clock()
+{
+    beginDisplay();
+    appConfig.presets.assign(1, ringPreset(3, 3, 4));
+    appConfig.transitionStyle = TRANSITION_CUT;
+    hal::native::setWallTime(kNoonKst + 6 * 3600); // 18:00
+    drawFrame();
+    const Topology &topo = g_display.topology();
+    TEST_ASSERT_EQUAL_INT(topo.count(RING_INNER) * 3 / 4, countPixels(topo.offset(RING_INNER), topo.count(RING_INNER), kFill));
+
+    // 수동 시계만 흘려도 벽시계가 따라간다
+    hal::native::advanceMs(3 * 3600 * 1000ULL); // 21:00
+    drawFrame();
+    TEST_ASSERT_EQUAL_INT(topo.count(RING_INNER) * 7 / 8, countPixels(topo.offset(RING_INNER), topo.count(RING_INNER), kFill));
+}
+
+void test_running_timer_takes_over_segment()
+{
+    beginDisplay();
+    Preset p = ringPreset(MODE_TIMER, 3, 4);
+    payloadSetTimer(p.inner.payload, 120, true);
+    appConfig.presets.assign(2, p); // 인덱스를 바꿔 타이머 길이를 다시 읽힌다
+    appConfig.currentPresetIndex = 1;
+    appConfig.transitionStyle = TRANSITION_CUT;
+    hal::native::setWallTime(kNoonKst);
+    const InteractiveSnapshot idle = {0, false, 0, InteractiveManager::POMO_WORK, false, 0};
+    interactiveManager.applySnapshot(idle);
+    interactiveManager.update();
+    interactiveManager.startTimer();
+    hal::native::advanceMs(60000);
+    drawFrame();
+    interactiveManager.pauseTimer();
+
+    const Topology &topo = g_display.topology();
+    TEST_ASSERT_EQUAL_INT(topo.count(RING_INNER) / 2, countPixels(topo.offset(RING_INNER), topo.count(RING_INNER), kFill));
+    // 동작 중인 타이머가 세그먼트 모드 4보다 앞선다: 남은 60초를 "060"으로
+    const uint8_t expected[3] = {0xC0, 0x82, 0xC0};
+    TEST_ASSERT_EQUAL_MEMORY(expected, g_frame.seg, 3);
+}
+} // namespace
+
+void runDisplayTests()
+{
+    RUN_TEST(test_day_ring_at_noon_fills_half);
+    RUN_TEST(test_frame_follows_manual_clock);
+    RUN_TEST(test_running_timer_takes_over_segment);
+}
@@ -0,0 +1,222 @@
+#include "NativeTests.h"
+#include "Config.h"
+#include "TimerEngine.h"
+#include "TimerWheel.h"
+#include "hal/HalNative.h"
+#include "managers/InteractiveManager.h"
+
+namespace
+{
+enum
+{
+    kPresetCounter,
+    kPresetTimer,
+    kPresetPomodoro
+};
+
+Preset interactivePreset(int mode)
+{
+    Preset p;
+    p.inner.mode = mode;
+    p.outer.mode = 0;
+    payloadSetNone(p.outer.payload);
+    p.segment.mode = mode;
+    payloadSetNone(p.segment.payload);
+    return p;
+}
+
+// 카운터(목표 20), 타이머(90초, 초 표시), 뽀모도로(2분/1분, 초 표시) 프리셋 세 개
+void useInteractivePresets(int index)
+{
+    appConfig.presets.clear();
+    Preset counter = interactivePreset(MODE_COUNTER);
+    payloadSetCounter(counter.inner.payload, 20);
+    appConfig.presets.push_back(counter);
+    Preset timer = interactivePreset(MODE_TIMER);
+    payloadSetTimer(timer.inner.payload, 90, true);
+    appConfig.presets.push_back(timer);
+    Preset pomodoro = interactivePreset(MODE_POMODORO);
+    payloadSetPomodoro(pomodoro.inner.payload, 2, 1, true);
+    appConfig.presets.push_back(pomodoro);
+
+    appConfig.currentPresetIndex = index;
+    // 전역 매니저는 테스트 사이에 이어진다: 멈춘 처음 상태로 되돌리고 프리셋 길이를 다시 읽힌다
+    const InteractiveSnapshot idle = {0, false, 0, InteractiveManager::POMO_WORK, false, 0};
+    interactiveManager.applySnapshot(idle);
+    interactiveManager.update();
+}
+
+void step(uint64_t ms)
+{
+    for (uint64_t t = 0; t < ms; t += TimerWheel::kTickMs)
+    {
+        hal::native::advanceMs(TimerWheel::kTickMs);
+        timerEngine.update();
+        interactiveManager.update();
+    }
+}
+
+void test_counter_buttons_clamp_and_reset()
+{
+    useInteractivePresets(kPresetCounter);
+    const RingConfig &ring = appConfig.presets[kPresetCounter].inner;
+
+    for (int i = 0; i < 5; i++)
+        interactiveManager.handleButton2(MODE_COUNTER);
+    TEST_ASSERT_EQUAL_INT(5, interactiveManager.getDisplayNumber(MODE_COUNTER));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.25f, interactiveManager.getProgress(ring));
+
+    for (int i = 0; i < 7; i++)
+        interactiveManager.handleButton1(MODE_COUNTER);
+    TEST_ASSERT_EQUAL_INT(0, interactiveManager.getDisplayNumber(MODE_COUNTER)); // 0 아래로 내려가지 않는다
+
+    interactiveManager.setCounter(30);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.5f, interactiveManager.getProgress(ring)); // 목표를 넘으면 그대로 넘는다
+    interactiveManager.setCounter(-4);
+    TEST_ASSERT_EQUAL_INT(0, interactiveManager.getDisplayNumber(MODE_COUNTER));
+
+    interactiveManager.setCounter(12);
+    interactiveManager.resetCounter();
+    TEST_ASSERT_EQUAL_INT(0, interactiveManager.getDisplayNumber(MODE_COUNTER));
+}
+
+void test_timer_start_pause_finish()
+{
+    useInteractivePresets(kPresetTimer);
+    const RingConfig &ring = appConfig.presets[kPresetTimer].inner;
+
+    TEST_ASSERT_EQUAL_INT(90, interactiveManager.getDisplayNumber(MODE_TIMER));
+    interactiveManager.handleButton2(MODE_TIMER); // 시작
+    TEST_ASSERT_TRUE(interactiveManager.isTimerRunning());
+    step(30000);
+    TEST_ASSERT_EQUAL_INT(60, interactiveManager.getDisplayNumber(MODE_TIMER));
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 1.0f / 3.0f, interactiveManager.getProgress(ring));
+
+    interactiveManager.handleButton2(MODE_TIMER); // 일시정지
+    TEST_ASSERT_FALSE(interactiveManager.isTimerRunning());
+    step(100000);
+    TEST_ASSERT_EQUAL_INT(60, interactiveManager.getDisplayNumber(MODE_TIMER));
+
+    interactiveManager.handleButton2(MODE_TIMER); // 이어서
+    step(60010);
+    TEST_ASSERT_FALSE(interactiveManager.isTimerRunning());
+    TEST_ASSERT_EQUAL_INT(0, interactiveManager.getDisplayNumber(MODE_TIMER));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f, interactiveManager.getProgress(ring));
+
+    interactiveManager.handleButton1(MODE_TIMER); // 리셋
+    TEST_ASSERT_EQUAL_INT(90, interactiveManager.getDisplayNumber(MODE_TIMER));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.0f, interactiveManager.getProgress(ring));
+}
+
+void test_timer_minutes_display_rounds_up()
+{
+    useInteractivePresets(kPresetTimer);
+    payloadSetTimer(appConfig.presets[kPresetTimer].inner.payload, 90, false);
+    interactiveManager.startTimer();
+    TEST_ASSERT_EQUAL_INT(2, interactiveManager.getDisplayNumber(MODE_TIMER)); // 90초 → 2분
+    step(31000);
+    TEST_ASSERT_EQUAL_INT(1, interactiveManager.getDisplayNumber(MODE_TIMER));
+    interactiveManager.pauseTimer();
+}
+
+void test_pomodoro_work_wait_rest_cycle()
+{
+    useInteractivePresets(kPresetPomodoro);
+    const RingConfig &ring = appConfig.presets[kPresetPomodoro].inner;
+
+    TEST_ASSERT_FALSE(interactiveManager.shouldBlink(MODE_POMODORO));
+    interactiveManager.handleButton2(MODE_POMODORO); // 작업 시작
+    TEST_ASSERT_TRUE(interactiveManager.isPomoRunning());
+    step(60000);
+    TEST_ASSERT_EQUAL_INT(60, interactiveManager.getDisplayNumber(MODE_POMODORO));
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 0.5f, interactiveManager.getProgress(ring));
+
+    interactiveManager.handleButton2(MODE_POMODORO); // 일시정지
+    TEST_ASSERT_FALSE(interactiveManager.isPomoRunning());
+    step(30000);
+    interactiveManager.handleButton2(MODE_POMODORO); // 이어서
+    step(60010);
+
+    // 작업이 끝나면 휴식을 누르기 전까지 깜빡이며 기다린다
+    InteractiveSnapshot snap;
+    interactiveManager.getSnapshot(snap);
+    TEST_ASSERT_EQUAL_INT(InteractiveManager::POMO_WAIT_REST, snap.pomoState);
+    TEST_ASSERT_FALSE(snap.pomoRunning);
+    TEST_ASSERT_TRUE(interactiveManager.shouldBlink(MODE_POMODORO));
+    TEST_ASSERT_EQUAL_INT(0, interactiveManager.getDisplayNumber(MODE_POMODORO));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f, interactiveManager.getProgress(ring));
+
+    interactiveManager.handleButton2(MODE_POMODORO); // 휴식 시작
+    interactiveManager.getSnapshot(snap);
+    TEST_ASSERT_EQUAL_INT(InteractiveManager::POMO_REST, snap.pomoState);
+    TEST_ASSERT_TRUE(snap.pomoRunning);
+    TEST_ASSERT_EQUAL_INT(60, interactiveManager.getDisplayNumber(MODE_POMODORO));
+    step(60010);
+    interactiveManager.getSnapshot(snap);
+    TEST_ASSERT_EQUAL_INT(InteractiveManager::POMO_WAIT_WORK, snap.pomoState);
+
+    interactiveManager.handleButton2(MODE_POMODORO); // 다음 작업
+    interactiveManager.getSnapshot(snap);
+    TEST_ASSERT_EQUAL_INT(InteractiveManager::POMO_WORK, snap.pomoState);
+    TEST_ASSERT_EQUAL_INT(120, interactiveManager.getDisplayNumber(MODE_POMODORO));
+
+    // 버튼 1은 현재 단계만 처음으로 되돌린다
+    step(5000);
+    interactiveManager.handleButton1(MODE_POMODORO);
+    interactiveManager.getSnapshot(snap);
+    TEST_ASSERT_EQUAL_INT(InteractiveManager::POMO_WORK, snap.pomoState);
+    TEST_ASSERT_EQUAL_UINT32(0, snap.pomoElapsedMs);
+}
+
+// /set-config가 지금 프리셋의 길이만 바꿔도 멈춘 타이머의 표시와 진행률이 새 길이를 따른다
+void test_config_edit_reloads_current_preset()
+{
+    useInteractivePresets(kPresetTimer);
+    TEST_ASSERT_EQUAL_INT(90, interactiveManager.getDisplayNumber(MODE_TIMER));
+
+    payloadSetTimer(appConfig.presets[kPresetTimer].inner.payload, 30, true);
+    payloadSetPomodoro(appConfig.presets[kPresetPomodoro].inner.payload, 5, 1, true);
+    interactiveManager.reloadPresets();
+    interactiveManager.update();
+    TEST_ASSERT_EQUAL_INT(30, interactiveManager.getDisplayNumber(MODE_TIMER));
+    interactiveManager.startTimer();
+    step(15000);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 0.5f, interactiveManager.getProgress(appConfig.presets[kPresetTimer].inner));
+    interactiveManager.pauseTimer();
+
+    appConfig.currentPresetIndex = kPresetPomodoro;
+    interactiveManager.update();
+    TEST_ASSERT_EQUAL_INT(300, interactiveManager.getDisplayNumber(MODE_POMODORO));
+    payloadSetPomodoro(appConfig.presets[kPresetPomodoro].inner.payload, 3, 1, true);
+    interactiveManager.reloadPresets();
+    interactiveManager.update();
+    TEST_ASSERT_EQUAL_INT(180, interactiveManager.getDisplayNumber(MODE_POMODORO));
+}
+
+void test_snapshot_round_trip_follows_leader()
+{
+    useInteractivePresets(kPresetTimer);
+    const InteractiveSnapshot leader = {7, true, 45000, InteractiveManager::POMO_REST, false, 20000};
+    interactiveManager.applySnapshot(leader);
+
+    InteractiveSnapshot snap;
+    interactiveManager.getSnapshot(snap);
+    TEST_ASSERT_EQUAL_INT(7, snap.counter);
+    TEST_ASSERT_TRUE(snap.timerRunning);
+    TEST_ASSERT_EQUAL_UINT32(45000, snap.timerElapsedMs);
+    TEST_ASSERT_EQUAL_INT(InteractiveManager::POMO_REST, snap.pomoState);
+    TEST_ASSERT_EQUAL_UINT32(20000, snap.pomoElapsedMs);
+    TEST_ASSERT_EQUAL_INT(45, interactiveManager.getDisplayNumber(MODE_TIMER));
+    interactiveManager.pauseTimer();
+}
+} // namespace
+
+void runInteractiveTests()
+{
+    RUN_TEST(test_counter_buttons_clamp_and_reset);
+    RUN_TEST(test_timer_start_pause_finish);
+    RUN_TEST(test_timer_minutes_display_rounds_up);
+    RUN_TEST(test_pomodoro_work_wait_rest_cycle);
+    RUN_TEST(test_config_edit_reloads_current_preset);
+    RUN_TEST(test_snapshot_round_trip_follows_leader);
+}
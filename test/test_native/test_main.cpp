@@ -0,0 +1,54 @@
+#include "NativeTests.h"
+#include "Config.h"
+#include "Scheduler.h"
+#include "TimeLogic.h"
+#include "TimerEngine.h"
+#include "hal/HalNative.h"
+#include "managers/InteractiveManager.h"
+
+struct tm testLocalTime(int year, int month, int day, int hour, int minute, int second)
+{
+    struct tm t = {};
+    t.tm_year = year - 1900;
+    t.tm_mon = month - 1;
+    t.tm_mday = day;
+    t.tm_hour = hour;
+    t.tm_min = minute;
+    t.tm_sec = second;
+    t.tm_isdst = -1;
+    mktime(&t);
+    return t;
+}
+
+void setUp(void)
+{
+    // 수동 시계는 되감지 않는다: 전역 타이머 휠이 지나간 칸으로 돌아가지 않게
+    hal::native::setWallTime(0);
+    hal::native::clearStorage();
+    initDefaultConfig();
+    appConfig.currentPresetIndex = 0;
+}
+
+void tearDown(void)
+{
+}
+
+int main(int argc, char **argv)
+{
+    setupTimeZone();
+    hal::native::useManualClock(0);
+    initDefaultConfig();
+    // 전역 엔진/매니저는 프로세스에 하나뿐이다: 한 번만 시작하고 테스트마다 상태를 되돌린다
+    timerEngine.begin();
+    interactiveManager.begin();
+    schedulerBegin();
+
+    UNITY_BEGIN();
+    runTimeLogicTests();
+    runConfigCodecTests();
+    runTimerTests();
+    runSchedulerTests();
+    runInteractiveTests();
+    runDisplayTests();
+    return UNITY_END();
+}
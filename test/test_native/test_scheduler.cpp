@@ -0,0 +1,95 @@
+#include "NativeTests.h"
+#include "Config.h"
+#include "Scheduler.h"
+#include "TimerEngine.h"
+#include "TimerWheel.h"
+#include "hal/HalNative.h"
+
+namespace
+{
+ScheduleRule rule(uint8_t days, uint8_t hour, uint8_t minute, int preset = 0)
+{
+    ScheduleRule r;
+    r.days = days;
+    r.hour = hour;
+    r.minute = minute;
+    r.preset = preset;
+    return r;
+}
+
+time_t localEpoch(int year, int month, int day, int hour, int minute, int second = 0)
+{
+    struct tm t = testLocalTime(year, month, day, hour, minute, second);
+    return mktime(&t);
+}
+
+void step(uint64_t ms)
+{
+    for (uint64_t t = 0; t < ms; t += TimerWheel::kTickMs)
+    {
+        hal::native::advanceMs(TimerWheel::kTickMs);
+        timerEngine.update();
+    }
+}
+
+// 2026-03-14는 토요일이다
+void test_next_occurrence_crosses_midnight()
+{
+    const ScheduleRule morning = rule(SCHEDULE_EVERY_DAY, 7, 0);
+    TEST_ASSERT_EQUAL_INT64(localEpoch(2026, 3, 15, 7, 0), scheduleNextOccurrence(morning, localEpoch(2026, 3, 14, 23, 30)));
+    TEST_ASSERT_EQUAL_INT64(localEpoch(2026, 3, 14, 7, 0), scheduleNextOccurrence(morning, localEpoch(2026, 3, 14, 6, 59, 59)));
+    // 정각은 "이후"가 아니다: 다음 날로
+    TEST_ASSERT_EQUAL_INT64(localEpoch(2026, 3, 15, 7, 0), scheduleNextOccurrence(morning, localEpoch(2026, 3, 14, 7, 0)));
+
+    const ScheduleRule midnight = rule(SCHEDULE_EVERY_DAY, 0, 0);
+    TEST_ASSERT_EQUAL_INT64(localEpoch(2026, 4, 1, 0, 0), scheduleNextOccurrence(midnight, localEpoch(2026, 3, 31, 23, 59, 59)));
+    TEST_ASSERT_EQUAL_INT64(localEpoch(2027, 1, 1, 0, 0), scheduleNextOccurrence(midnight, localEpoch(2026, 12, 31, 12, 0)));
+}
+
+void test_next_occurrence_follows_day_mask()
+{
+    // 평일 규칙은 토요일 아침에서 월요일로 건너뛴다
+    TEST_ASSERT_EQUAL_INT64(localEpoch(2026, 3, 16, 7, 0),
+                            scheduleNextOccurrence(rule(SCHEDULE_WEEKDAYS, 7, 0), localEpoch(2026, 3, 14, 8, 0)));
+    // 금요일 밤의 주말 규칙은 자정을 넘겨 토요일로
+    TEST_ASSERT_EQUAL_INT64(localEpoch(2026, 3, 14, 0, 30),
+                            scheduleNextOccurrence(rule(SCHEDULE_WEEKEND, 0, 30), localEpoch(2026, 3, 13, 23, 0)));
+    // 일요일(비트 0)만: 일요일 시각을 지나면 꼭 일주일 뒤
+    TEST_ASSERT_EQUAL_INT64(localEpoch(2026, 3, 22, 9, 0), scheduleNextOccurrence(rule(0x01, 9, 0), localEpoch(2026, 3, 15, 9, 0)));
+    // 수요일(비트 3)만
+    TEST_ASSERT_EQUAL_INT64(localEpoch(2026, 3, 18, 21, 15), scheduleNextOccurrence(rule(0x08, 21, 15), localEpoch(2026, 3, 14, 12, 0)));
+    TEST_ASSERT_EQUAL_INT64(0, scheduleNextOccurrence(rule(0, 7, 0), localEpoch(2026, 3, 14, 12, 0)));
+}
+
+// 규칙 시각에 타이머 엔진이 깨워 프리셋을 바꾸고 다음 날로 다시 건다 (벽시계는 hal::wallTime)
+void test_scheduler_switches_preset_at_wall_time()
+{
+    appConfig.presets.resize(3);
+    appConfig.currentPresetIndex = 0;
+    appConfig.schedules = {rule(SCHEDULE_EVERY_DAY, 9, 30, 2), rule(SCHEDULE_WEEKDAYS, 18, 0, 1)};
+    hal::native::setWallTime(localEpoch(2026, 3, 14, 9, 29));
+    schedulerReload();
+    schedulerLoop();
+    TEST_ASSERT_EQUAL_INT64(localEpoch(2026, 3, 14, 9, 30), schedulerNextFireAt());
+    TEST_ASSERT_EQUAL_INT(2, schedulerNextPreset());
+
+    step(59990);
+    TEST_ASSERT_EQUAL_INT(0, appConfig.currentPresetIndex);
+    step(20);
+    TEST_ASSERT_EQUAL_INT(2, appConfig.currentPresetIndex);
+    // 토요일이라 평일 18:00은 건너뛰고 일요일 9:30
+    TEST_ASSERT_EQUAL_INT64(localEpoch(2026, 3, 15, 9, 30), schedulerNextFireAt());
+
+    appConfig.schedules.clear();
+    schedulerReload();
+    schedulerLoop();
+    TEST_ASSERT_EQUAL_INT64(0, schedulerNextFireAt());
+}
+} // namespace
+
+void runSchedulerTests()
+{
+    RUN_TEST(test_next_occurrence_crosses_midnight);
+    RUN_TEST(test_next_occurrence_follows_day_mask);
+    RUN_TEST(test_scheduler_switches_preset_at_wall_time);
+}
@@ -0,0 +1,110 @@
+#include "NativeTests.h"
+#include "TimeLogic.h"
+
+namespace
+{
+constexpr time_t k2026Start = 1767193200; // 2026-01-01 00:00 KST
+constexpr float kEpsilon = 1e-5f;
+
+void test_parse_date_is_local_midnight()
+{
+    TEST_ASSERT_EQUAL_INT64(k2026Start, parseDate("2026-01-01"));
+    TEST_ASSERT_EQUAL_INT64(k2026Start + 365LL * 86400, parseDate("2027-01-01"));
+    // 윤일
+    TEST_ASSERT_EQUAL_INT64(parseDate("2024-03-01") - 86400, parseDate("2024-02-29"));
+}
+
+void test_leap_years_and_month_lengths()
+{
+    TEST_ASSERT_TRUE(isLeap(2024));
+    TEST_ASSERT_TRUE(isLeap(2000));
+    TEST_ASSERT_FALSE(isLeap(2100));
+    TEST_ASSERT_FALSE(isLeap(2026));
+    TEST_ASSERT_EQUAL_INT(29, getDaysInMonth(1, 2024));
+    TEST_ASSERT_EQUAL_INT(28, getDaysInMonth(1, 2026));
+    TEST_ASSERT_EQUAL_INT(30, getDaysInMonth(3, 2026));
+    TEST_ASSERT_EQUAL_INT(31, getDaysInMonth(11, 2026));
+}
+
+void test_progress_year()
+{
+    struct tm t = testLocalTime(2026, 1, 1);
+    TEST_ASSERT_FLOAT_WITHIN(kEpsilon, 0.0f, calculateProgress(0, &t, nullptr, nullptr));
+    t = testLocalTime(2026, 7, 2); // 182일째 (0부터)
+    TEST_ASSERT_FLOAT_WITHIN(kEpsilon, 182.0f / 365.0f, calculateProgress(0, &t, nullptr, nullptr));
+    t = testLocalTime(2024, 12, 31); // 윤년은 366일
+    TEST_ASSERT_FLOAT_WITHIN(kEpsilon, 365.0f / 366.0f, calculateProgress(0, &t, nullptr, nullptr));
+}
+
+void test_progress_month()
+{
+    struct tm t = testLocalTime(2026, 4, 16);
+    TEST_ASSERT_FLOAT_WITHIN(kEpsilon, 0.5f, calculateProgress(1, &t, nullptr, nullptr));
+    t = testLocalTime(2024, 2, 15);
+    TEST_ASSERT_FLOAT_WITHIN(kEpsilon, 14.0f / 29.0f, calculateProgress(1, &t, nullptr, nullptr));
+    t = testLocalTime(2026, 2, 1);
+    TEST_ASSERT_FLOAT_WITHIN(kEpsilon, 0.0f, calculateProgress(1, &t, nullptr, nullptr));
+}
+
+void test_progress_week_starts_monday()
+{
+    struct tm t = testLocalTime(2026, 3, 16); // 월요일 00:00
+    TEST_ASSERT_FLOAT_WITHIN(kEpsilon, 0.0f, calculateProgress(2, &t, nullptr, nullptr));
+    t = testLocalTime(2026, 3, 18, 12); // 수요일 정오
+    TEST_ASSERT_FLOAT_WITHIN(kEpsilon, 2.5f / 7.0f, calculateProgress(2, &t, nullptr, nullptr));
+    t = testLocalTime(2026, 3, 22, 18); // 일요일 18:00
+    TEST_ASSERT_FLOAT_WITHIN(kEpsilon, 6.75f / 7.0f, calculateProgress(2, &t, nullptr, nullptr));
+}
+
+void test_progress_day()
+{
+    struct tm t = testLocalTime(2026, 3, 14, 6);
+    TEST_ASSERT_FLOAT_WITHIN(kEpsilon, 0.25f, calculateProgress(3, &t, nullptr, nullptr));
+    t = testLocalTime(2026, 3, 14, 23, 59, 59);
+    TEST_ASSERT_FLOAT_WITHIN(kEpsilon, 86399.0f / 86400.0f, calculateProgress(3, &t, nullptr, nullptr));
+}
+
+void test_progress_dday_clamps_to_range()
+{
+    struct tm t = testLocalTime(2026, 7, 2, 12); // 2026년의 정확히 절반
+    TEST_ASSERT_FLOAT_WITHIN(kEpsilon, 0.5f, calculateProgress(4, &t, "2026-01-01", "2027-01-01"));
+    t = testLocalTime(2025, 12, 31, 23);
+    TEST_ASSERT_FLOAT_WITHIN(kEpsilon, 0.0f, calculateProgress(4, &t, "2026-01-01", "2027-01-01"));
+    t = testLocalTime(2027, 1, 1, 0, 0, 1);
+    TEST_ASSERT_FLOAT_WITHIN(kEpsilon, 1.0f, calculateProgress(4, &t, "2026-01-01", "2027-01-01"));
+}
+
+void test_progress_quarter()
+{
+    struct tm t = testLocalTime(2026, 5, 16, 12); // 2분기(91일)의 45.5일째
+    TEST_ASSERT_FLOAT_WITHIN(kEpsilon, 45.5f / 91.0f, calculateProgress(5, &t, nullptr, nullptr));
+    t = testLocalTime(2026, 10, 1);
+    TEST_ASSERT_FLOAT_WITHIN(kEpsilon, 0.0f, calculateProgress(5, &t, nullptr, nullptr));
+
+    int totalDays = 0;
+    float passedDays = 0;
+    t = testLocalTime(2024, 3, 31, 18);
+    getQuarterInfo(&t, totalDays, passedDays);
+    TEST_ASSERT_EQUAL_INT(91, totalDays); // 윤년 1분기
+    TEST_ASSERT_FLOAT_WITHIN(kEpsilon, 90.75f, passedDays);
+}
+
+void test_progress_unknown_mode_is_zero()
+{
+    struct tm t = testLocalTime(2026, 5, 16, 12);
+    TEST_ASSERT_FLOAT_WITHIN(kEpsilon, 0.0f, calculateProgress(6, &t, nullptr, nullptr));
+}
+} // namespace
+
+void runTimeLogicTests()
+{
+    RUN_TEST(test_parse_date_is_local_midnight);
+    RUN_TEST(test_leap_years_and_month_lengths);
+    RUN_TEST(test_progress_year);
+    RUN_TEST(test_progress_month);
+    RUN_TEST(test_progress_week_starts_monday);
+    RUN_TEST(test_progress_day);
+    RUN_TEST(test_progress_dday_clamps_to_range);
+    RUN_TEST(test_progress_quarter);
+    RUN_TEST(test_progress_unknown_mode_is_zero);
+}
@@ -0,0 +1,252 @@
+#include "NativeTests.h"
+#include "TimerEngine.h"
+#include "TimerWheel.h"
+#include "hal/HalNative.h"
+#include <vector>
+
+namespace
+{
+struct Expired
+{
+    uint32_t owner;
+    uint64_t atMs;
+};
+
+struct WheelLog
+{
+    std::vector<Expired> expired;
+    uint64_t nowMs = 0;
+};
+
+void recordExpire(TimerWheel::NodeId node, uint32_t owner, void *ctx)
+{
+    WheelLog *log = static_cast<WheelLog *>(ctx);
+    log->expired.push_back({owner, log->nowMs});
+}
+
+// 10ms 단위로 돌리며 만료 시각을 기록한다
+void runWheel(TimerWheel &wheel, WheelLog &log, uint64_t untilMs)
+{
+    while (log.nowMs < untilMs)
+    {
+        log.nowMs += TimerWheel::kTickMs;
+        wheel.advance(log.nowMs, recordExpire, &log);
+    }
+}
+
+void test_wheel_fires_each_deadline_once_within_a_tick()
+{
+    TimerWheel wheel;
+    WheelLog log;
+    log.nowMs = 1000;
+    wheel.begin(log.nowMs);
+
+    // 1단(640ms 안), 2단, 3단에 걸치는 기한
+    const uint64_t deadlines[] = {1050, 1700, 45000, 3 * 3600 * 1000ULL};
+    for (uint32_t i = 0; i < 4; i++)
+        wheel.arm(wheel.allocate(i), deadlines[i]);
+
+    runWheel(wheel, log, deadlines[3] + 100);
+    TEST_ASSERT_EQUAL_UINT32(4, log.expired.size());
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        TEST_ASSERT_EQUAL_UINT32(i, log.expired[i].owner);
+        TEST_ASSERT_GREATER_OR_EQUAL(deadlines[i], log.expired[i].atMs);
+        TEST_ASSERT_LESS_THAN(deadlines[i] + TimerWheel::kTickMs, log.expired[i].atMs);
+    }
+}
+
+void test_wheel_disarm_and_rearm()
+{
+    TimerWheel wheel;
+    WheelLog log;
+    wheel.begin(0);
+    const TimerWheel::NodeId a = wheel.allocate(1);
+    const TimerWheel::NodeId b = wheel.allocate(2);
+    wheel.arm(a, 500);
+    wheel.arm(b, 800);
+    wheel.disarm(a);
+    wheel.arm(b, 300); // 옮기기
+    TEST_ASSERT_FALSE(wheel.armed(a));
+    TEST_ASSERT_TRUE(wheel.armed(b));
+    TEST_ASSERT_EQUAL_UINT64(300, wheel.deadline(b));
+
+    runWheel(wheel, log, 1000);
+    TEST_ASSERT_EQUAL_UINT32(1, log.expired.size());
+    TEST_ASSERT_EQUAL_UINT32(2, log.expired[0].owner);
+    TEST_ASSERT_EQUAL_UINT64(300, log.expired[0].atMs);
+    TEST_ASSERT_FALSE(wheel.armed(b));
+}
+
+void test_wheel_jump_past_many_slots()
+{
+    TimerWheel wheel;
+    WheelLog log;
+    wheel.begin(0);
+    wheel.arm(wheel.allocate(7), 90000);
+    // loop가 오래 막혔다가 한 번에 따라잡는 경우
+    log.nowMs = 120000;
+    wheel.advance(log.nowMs, recordExpire, &log);
+    TEST_ASSERT_EQUAL_UINT32(1, log.expired.size());
+    TEST_ASSERT_EQUAL_UINT32(7, log.expired[0].owner);
+}
+
+std::vector<TimerEvent> g_events;
+
+void recordEvent(const TimerEvent &event, void *ctx)
+{
+    g_events.push_back(event);
+}
+
+// 전역 엔진에 테스트용 타이머를 만들고 끝나면 지운다
+struct ScopedTimer
+{
+    TimerHandle h;
+    ScopedTimer(const char *name, TimerKind kind) : h(timerEngine.create(name, kind)) {}
+    ~ScopedTimer() { timerEngine.destroy(h); }
+};
+
+void step(uint64_t ms)
+{
+    // 엔진은 loop처럼 10ms마다 돈다
+    for (uint64_t t = 0; t < ms; t += TimerWheel::kTickMs)
+    {
+        hal::native::advanceMs(TimerWheel::kTickMs);
+        timerEngine.update();
+    }
+}
+
+void test_countdown_expires_once_and_restarts()
+{
+    static bool listening = false;
+    if (!listening)
+        listening = timerEngine.addListener(recordEvent, nullptr);
+    ScopedTimer timer("t-countdown", TIMER_COUNTDOWN);
+    g_events.clear();
+
+    timerEngine.setDuration(timer.h, 5000);
+    timerEngine.start(timer.h);
+    step(4990);
+    TEST_ASSERT_TRUE(g_events.empty());
+    TEST_ASSERT_TRUE(timerEngine.running(timer.h));
+    step(20);
+    TEST_ASSERT_EQUAL_UINT32(1, g_events.size());
+    TEST_ASSERT_EQUAL_INT(TIMER_EVENT_EXPIRED, g_events[0].type);
+    TEST_ASSERT_EQUAL_UINT64(5000, g_events[0].durationMs);
+    TEST_ASSERT_TRUE(timerEngine.finished(timer.h));
+    TEST_ASSERT_FALSE(timerEngine.running(timer.h));
+    TEST_ASSERT_EQUAL_UINT64(5000, timerEngine.elapsedMs(timer.h));
+
+    step(10000);
+    TEST_ASSERT_EQUAL_UINT32(1, g_events.size());
+
+    // 끝난 카운트다운은 처음부터 다시
+    timerEngine.start(timer.h);
+    TEST_ASSERT_EQUAL_UINT64(0, timerEngine.elapsedMs(timer.h));
+    step(5000);
+    TEST_ASSERT_EQUAL_UINT32(2, g_events.size());
+}
+
+void test_pause_resume_keeps_elapsed_and_moves_deadline()
+{
+    ScopedTimer timer("t-pause", TIMER_COUNTDOWN);
+    g_events.clear();
+
+    timerEngine.setDuration(timer.h, 3000);
+    timerEngine.start(timer.h);
+    step(1000);
+    timerEngine.pause(timer.h);
+    TEST_ASSERT_FALSE(timerEngine.running(timer.h));
+    TEST_ASSERT_EQUAL_UINT64(1000, timerEngine.elapsedMs(timer.h));
+
+    step(60000); // 멈춘 동안에는 만료되지 않는다
+    TEST_ASSERT_TRUE(g_events.empty());
+    TEST_ASSERT_EQUAL_UINT64(1000, timerEngine.elapsedMs(timer.h));
+
+    timerEngine.start(timer.h);
+    step(1990);
+    TEST_ASSERT_TRUE(g_events.empty());
+    step(20);
+    TEST_ASSERT_EQUAL_UINT32(1, g_events.size());
+
+    timerEngine.reset(timer.h);
+    TEST_ASSERT_FALSE(timerEngine.finished(timer.h));
+    TEST_ASSERT_EQUAL_UINT64(0, timerEngine.elapsedMs(timer.h));
+}
+
+void test_duration_change_while_running_rearms()
+{
+    ScopedTimer timer("t-rearm", TIMER_COUNTDOWN);
+    g_events.clear();
+
+    timerEngine.setDuration(timer.h, 10000);
+    timerEngine.start(timer.h);
+    step(2000);
+    timerEngine.setDuration(timer.h, 3000);
+    step(990);
+    TEST_ASSERT_TRUE(g_events.empty());
+    step(20);
+    TEST_ASSERT_EQUAL_UINT32(1, g_events.size());
+}
+
+void test_pomodoro_phases_wait_for_advance()
+{
+    ScopedTimer timer("t-pomo", TIMER_POMODORO);
+    g_events.clear();
+
+    timerEngine.setPomodoro(timer.h, 2000, 1000);
+    timerEngine.start(timer.h);
+    TEST_ASSERT_EQUAL_UINT64(2000, timerEngine.durationMs(timer.h));
+    step(2010);
+    TEST_ASSERT_EQUAL_UINT32(1, g_events.size());
+    TEST_ASSERT_EQUAL_INT(TIMER_EVENT_PHASE_END, g_events[0].type);
+    TEST_ASSERT_EQUAL_INT(POMODORO_WORK, g_events[0].phase);
+    TEST_ASSERT_EQUAL_INT(POMODORO_WAIT_REST, timerEngine.phase(timer.h));
+    TEST_ASSERT_FALSE(timerEngine.running(timer.h));
+
+    step(5000); // 대기 단계는 스스로 넘어가지 않는다
+    TEST_ASSERT_EQUAL_UINT32(1, g_events.size());
+
+    timerEngine.advancePhase(timer.h);
+    TEST_ASSERT_EQUAL_INT(POMODORO_REST, timerEngine.phase(timer.h));
+    step(1010);
+    TEST_ASSERT_EQUAL_UINT32(2, g_events.size());
+    TEST_ASSERT_EQUAL_INT(POMODORO_REST, g_events[1].phase);
+    TEST_ASSERT_EQUAL_UINT64(1000, g_events[1].durationMs);
+    TEST_ASSERT_EQUAL_INT(POMODORO_WAIT_WORK, timerEngine.phase(timer.h));
+
+    // 대기 단계에서 start()는 다음 단계를 시작한다
+    timerEngine.start(timer.h);
+    TEST_ASSERT_EQUAL_INT(POMODORO_WORK, timerEngine.phase(timer.h));
+    TEST_ASSERT_TRUE(timerEngine.running(timer.h));
+}
+
+void test_alarm_fires_at_local_wall_time()
+{
+    ScopedTimer timer("t-alarm", TIMER_ALARM);
+    g_events.clear();
+
+    hal::native::setWallTime(1773448013 - 53 - 26 * 60 + 29 * 60); // 2026-03-14 09:29:00 KST
+    timerEngine.setAlarm(timer.h, 9, 30);
+    timerEngine.start(timer.h);
+    step(59990);
+    TEST_ASSERT_TRUE(g_events.empty());
+    step(20);
+    TEST_ASSERT_EQUAL_UINT32(1, g_events.size());
+    TEST_ASSERT_EQUAL_INT(TIMER_EVENT_ALARM, g_events[0].type);
+    TEST_ASSERT_TRUE(timerEngine.running(timer.h)); // 다음 날로 다시 걸린다
+    timerEngine.pause(timer.h);
+}
+} // namespace
+
+void runTimerTests()
+{
+    RUN_TEST(test_wheel_fires_each_deadline_once_within_a_tick);
+    RUN_TEST(test_wheel_disarm_and_rearm);
+    RUN_TEST(test_wheel_jump_past_many_slots);
+    RUN_TEST(test_countdown_expires_once_and_restarts);
+    RUN_TEST(test_pause_resume_keeps_elapsed_and_moves_deadline);
+    RUN_TEST(test_duration_change_while_running_rearms);
+    RUN_TEST(test_pomodoro_phases_wait_for_advance);
+    RUN_TEST(test_alarm_fires_at_local_wall_time);
+}
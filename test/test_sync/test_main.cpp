@@ -0,0 +1,196 @@
+// env:native 동기화 하네스 (pio test -e native -f test_sync).
+// 리더 하나와 팔로워 여럿을 fork해 루프백 멀티캐스트로 묶고, 모두가 같이 보는 CLOCK_MONOTONIC에 대해
+// 각자의 syncMillis()가 얼마나 어긋나는지 잰다. 인스턴스마다 렌더 클럭의 출발점이 다르고(하나는 32비트 롤오버를 지난다)
+// 팔로워는 loop마다 무작위로 늦게 받는다: 오프셋 필터(최근 8개 중 최댓값, 비콘당 2ms 당기기)가 이 지터를 걸러야 한다.
+#include <unity.h>
+#include "Config.h"
+#include "SyncManager.h"
+#include "TimerEngine.h"
+#include "hal/HalNative.h"
+#include "managers/InteractiveManager.h"
+#include <random>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+constexpr int kFollowers = 3;
+constexpr uint64_t kWarmupMs = 2000;  // 잠금 + 필터 창 채우기 (비콘 20개)
+constexpr uint64_t kMeasureMs = 2000;
+constexpr uint64_t kLeaderGoneMs = 2500; // 리더가 끝난 뒤 팔로워가 더 도는 시간 (kLockTimeoutMs보다 길게)
+constexpr uint32_t kMaxJitterMs = 4;
+constexpr time_t kLeaderEpoch = 1773448013; // 2026-03-14 09:26:53 KST
+constexpr long kLeaderCounter = 42;
+
+// 렌더 클럭 출발점: 리더, 팔로워 1~3 (두 번째 팔로워는 측정 중에 32비트를 넘긴다)
+const uint64_t kClockStartMs[1 + kFollowers] = {5000, 123456789, 0xFFFFFFFFULL - 2500, 42};
+
+struct Report
+{
+    int32_t minOffset; // syncMillis() - CLOCK_MONOTONIC (ms, 32비트에서 뺀 값)
+    int32_t maxOffset;
+    uint32_t samples;
+    bool lockedWhileLeading;
+    bool lockedAfterLeaderGone;
+    uint32_t beaconsReceived;
+    int preset;
+    long counter;
+    time_t wallTime;
+};
+
+uint64_t monotonicMs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000ULL + (uint64_t)ts.tv_nsec / 1000000ULL;
+}
+
+// 자식 프로세스 하나 = 장치 하나. 수동 시계를 실제 시간에 맞춰 흘리며 loop를 흉내 낸다.
+void runInstance(SyncRole role, uint64_t clockStartMs, uint64_t startAt, unsigned seed, int fd)
+{
+    hal::native::useManualClock(clockStartMs);
+    initDefaultConfig();
+    appConfig.presets.push_back(appConfig.presets[0]);
+    appConfig.syncRole = role;
+    timerEngine.begin();
+    interactiveManager.begin();
+    if (role == SYNC_LEADER)
+    {
+        hal::native::setWallTime(kLeaderEpoch);
+        appConfig.currentPresetIndex = 1;
+        interactiveManager.setCounter(kLeaderCounter);
+    }
+    else
+    {
+        hal::native::setWallTime(1000); // NTP를 못 받은 팔로워
+    }
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<uint32_t> jitter(0, kMaxJitterMs);
+    const uint64_t measureFrom = startAt + kWarmupMs;
+    const uint64_t leaderEnd = measureFrom + kMeasureMs;
+    const uint64_t end = (role == SYNC_LEADER) ? leaderEnd : leaderEnd + kLeaderGoneMs;
+
+    Report r = {INT32_MAX, INT32_MIN, 0, true, false, 0, 0, 0, 0};
+    uint64_t last = monotonicMs();
+    syncBegin();
+    for (uint64_t now = last; now < end; now = monotonicMs())
+    {
+        hal::native::advanceMs(now - last);
+        last = now;
+        syncLoop();
+
+        SyncStats stats;
+        syncGetStats(stats);
+        if (now >= measureFrom && now < leaderEnd)
+        {
+            const int32_t offset = (int32_t)(syncMillis() - (uint32_t)now);
+            r.minOffset = min(r.minOffset, offset);
+            r.maxOffset = max(r.maxOffset, offset);
+            r.samples++;
+            if (role == SYNC_FOLLOWER && !stats.locked)
+                r.lockedWhileLeading = false;
+        }
+        r.lockedAfterLeaderGone = stats.locked;
+        r.beaconsReceived = stats.beaconsReceived;
+
+        // 리더는 거의 쉬지 않고 돌고, 팔로워는 0~4ms 늦게 받는다
+        usleep(role == SYNC_LEADER ? 200 : 200 + jitter(rng) * 1000);
+    }
+    r.preset = appConfig.currentPresetIndex;
+    r.counter = interactiveManager.getDisplayNumber(MODE_COUNTER);
+    r.wallTime = hal::wallTime();
+    write(fd, &r, sizeof(r));
+}
+
+pid_t spawn(SyncRole role, uint64_t clockStartMs, uint64_t startAt, unsigned seed, int &readFd)
+{
+    int fds[2];
+    if (pipe(fds) != 0)
+        return -1;
+    fflush(stdout);
+    const pid_t pid = fork();
+    if (pid == 0)
+    {
+        close(fds[0]);
+        runInstance(role, clockStartMs, startAt, seed, fds[1]);
+        _exit(0);
+    }
+    close(fds[1]);
+    readFd = fds[0];
+    return pid;
+}
+
+bool collect(pid_t pid, int fd, Report &out)
+{
+    const bool ok = read(fd, &out, sizeof(out)) == (ssize_t)sizeof(out);
+    close(fd);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+void test_followers_track_leader_within_a_frame()
+{
+    // 샌드박스에 따라 루프백 멀티캐스트가 막혀 있을 수 있다
+    const uint8_t probeGroup[4] = {239, 255, 84, 84};
+    if (!hal::multicastOpen(probeGroup, 4284))
+        TEST_IGNORE_MESSAGE("loopback multicast unavailable");
+    hal::multicastClose();
+
+    const uint64_t startAt = monotonicMs();
+    pid_t pids[1 + kFollowers];
+    int fds[1 + kFollowers];
+    pids[0] = spawn(SYNC_LEADER, kClockStartMs[0], startAt, 1, fds[0]);
+    for (int i = 1; i <= kFollowers; i++)
+        pids[i] = spawn(SYNC_FOLLOWER, kClockStartMs[i], startAt, 100 + i, fds[i]);
+
+    Report reports[1 + kFollowers];
+    bool collected = true;
+    for (int i = 0; i <= kFollowers; i++)
+        collected = collect(pids[i], fds[i], reports[i]) && collected;
+    TEST_ASSERT_TRUE_MESSAGE(collected, "an instance crashed or did not report");
+
+    const Report &leader = reports[0];
+    TEST_ASSERT_GREATER_THAN(0, leader.samples);
+    // 리더 렌더 클럭은 단조 시계와 같은 속도로 흐른다 (반올림 1ms)
+    TEST_ASSERT_LESS_OR_EQUAL_INT32(1, leader.maxOffset - leader.minOffset);
+
+    for (int i = 1; i <= kFollowers; i++)
+    {
+        const Report &f = reports[i];
+        const int32_t skew = max(f.maxOffset - leader.minOffset, leader.maxOffset - f.minOffset);
+        char msg[128];
+        snprintf(msg, sizeof(msg), "follower %d: skew %ld ms (offset drift %ld ms, %lu beacons)", i, (long)skew,
+                 (long)(f.maxOffset - f.minOffset), (unsigned long)f.beaconsReceived);
+        TEST_MESSAGE(msg);
+
+        TEST_ASSERT_GREATER_THAN(0, f.samples);
+        TEST_ASSERT_TRUE(f.lockedWhileLeading);
+        TEST_ASSERT_LESS_THAN_INT32(FRAME_INTERVAL_MS, skew);
+        // 리더가 사라지면 kLockTimeoutMs 뒤 로컬 클럭으로 돌아간다
+        TEST_ASSERT_FALSE(f.lockedAfterLeaderGone);
+
+        // 프리셋/카운터는 리더를 따르고, 시계가 없던 팔로워는 리더 벽시계를 빌린다
+        TEST_ASSERT_EQUAL_INT(1, f.preset);
+        TEST_ASSERT_EQUAL_INT(kLeaderCounter, f.counter);
+        TEST_ASSERT_GREATER_OR_EQUAL(kLeaderEpoch, f.wallTime);
+        TEST_ASSERT_LESS_THAN(kLeaderEpoch + 60, f.wallTime);
+    }
+}
+} // namespace
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_followers_track_leader_within_a_frame);
+    return UNITY_END();
+}